@@ -0,0 +1,225 @@
+/*
+ * AsyncI2CBus.h - Non-blocking OLED transfers via the ESP-IDF I2C master driver
+ * 
+ * Queues each staged frame's transactions on the ESP-IDF i2c_master driver in
+ * asynchronous mode and returns immediately, so the display task can draw the
+ * next frame while the previous one is still on the wire.
+ */
+
+#ifndef ASYNC_I2C_BUS_H
+#define ASYNC_I2C_BUS_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include "OledBus.h"
+
+#if __has_include("driver/i2c_master.h")
+#include "driver/i2c_master.h"
+#define ASYNC_I2C_BUS_AVAILABLE 1
+#else
+#define ASYNC_I2C_BUS_AVAILABLE 0
+#endif
+
+#if ASYNC_I2C_BUS_AVAILABLE
+
+/**
+ * AsyncI2CBus - Asynchronous OledBus on the ESP-IDF i2c_master driver
+ * 
+ * Features:
+ * - Takes over the I2C port from Wire once the panel is initialized
+ * - Transaction queue deep enough for two full frames (double buffering)
+ * - Per-transaction done interrupt; frame completion published from the ISR
+ * 
+ * Note: the classic ESP32 I2C peripheral has no DMA; transfers are driven by
+ * the driver's FIFO interrupt, which still frees the CPU for the whole frame.
+ */
+class AsyncI2CBus : public OledBus {
+public:
+  /**
+   * Constructor
+   */
+  AsyncI2CBus() :
+    _bus(nullptr),
+    _device(nullptr),
+    _head(0),
+    _count(0),
+    _isInitialized(false) {
+  }
+
+  /**
+   * Release Wire and create an asynchronous I2C master on the same pins
+   * 
+   * @param twi Wire instance currently owning the port (ended here)
+   * @param sdaPin I2C data pin
+   * @param sclPin I2C clock pin
+   * @param address Panel I2C address
+   * @param clockHz Bus clock
+   * @return true if initialization successful, false otherwise
+   */
+  bool begin(TwoWire* twi, int sdaPin, int sclPin, uint8_t address, uint32_t clockHz) {
+    if (twi != nullptr) {
+      twi->end();
+    }
+    
+    i2c_master_bus_config_t busConfig = {};
+    busConfig.i2c_port = I2C_NUM_0;
+    busConfig.sda_io_num = (gpio_num_t)sdaPin;
+    busConfig.scl_io_num = (gpio_num_t)sclPin;
+    busConfig.clk_source = I2C_CLK_SRC_DEFAULT;
+    busConfig.glitch_ignore_cnt = 7;
+    busConfig.trans_queue_depth = QUEUE_DEPTH;  // Non-zero selects async mode
+    busConfig.flags.enable_internal_pullup = true;
+    
+    esp_err_t err = i2c_new_master_bus(&busConfig, &_bus);
+    if (err != ESP_OK) {
+      Serial.printf("AsyncI2C: Failed to create bus: %d\n", err);
+      return false;
+    }
+    
+    i2c_device_config_t deviceConfig = {};
+    deviceConfig.dev_addr_length = I2C_ADDR_BIT_LEN_7;
+    deviceConfig.device_address = address;
+    deviceConfig.scl_speed_hz = clockHz;
+    
+    err = i2c_master_bus_add_device(_bus, &deviceConfig, &_device);
+    if (err != ESP_OK) {
+      Serial.printf("AsyncI2C: Failed to add device: %d\n", err);
+      release();
+      return false;
+    }
+    
+    i2c_master_event_callbacks_t callbacks = {};
+    callbacks.on_trans_done = onTransactionDone;
+    err = i2c_master_register_event_callbacks(_device, &callbacks, this);
+    if (err != ESP_OK) {
+      Serial.printf("AsyncI2C: Failed to register callbacks: %d\n", err);
+      release();
+      return false;
+    }
+    
+    _isInitialized = true;
+    Serial.printf("AsyncI2C: OLED on async I2C master (%u Hz)\n", (unsigned)clockHz);
+    return true;
+  }
+
+  bool submit(OledFrame* frame) override {
+    if (!_isInitialized || frame->numSegments == 0 || _count >= MAX_IN_FLIGHT) {
+      completeFrame(frame, false);
+      return false;
+    }
+    
+    // Register the frame before queueing so the ISR can find it
+    portENTER_CRITICAL(&_lock);
+    _inFlight[(_head + _count) % MAX_IN_FLIGHT] = frame;
+    _count++;
+    portEXIT_CRITICAL(&_lock);
+    
+    for (int i = 0; i < frame->numSegments; i++) {
+      esp_err_t err = i2c_master_transmit(_device, &frame->bytes[frame->segmentOffset[i]],
+                                          frame->segmentLength[i], -1);
+      if (err != ESP_OK) {
+        // Segments that were not queued will never complete - retire them now
+        OledFrame* finished[MAX_IN_FLIGHT];
+        portENTER_CRITICAL(&_lock);
+        frame->pending -= (frame->numSegments - i);
+        int numFinished = retireCompleted(finished);
+        portEXIT_CRITICAL(&_lock);
+        for (int f = 0; f < numFinished; f++) {
+          completeFrame(finished[f], false);
+        }
+        return false;
+      }
+    }
+    
+    return true;
+  }
+
+  bool isAsync() const override {
+    return true;
+  }
+
+  /**
+   * Check if driver is initialized
+   */
+  bool isInitialized() const {
+    return _isInitialized;
+  }
+
+  /**
+   * Destructor - release the I2C device and bus
+   */
+  ~AsyncI2CBus() {
+    release();
+  }
+
+private:
+  static const int MAX_IN_FLIGHT = 2;  // Double buffering
+  static const int QUEUE_DEPTH = MAX_IN_FLIGHT * OledFrame::MAX_SEGMENTS;
+
+  i2c_master_bus_handle_t _bus;
+  i2c_master_dev_handle_t _device;
+
+  // Frames in submission order; transactions complete in FIFO order
+  OledFrame* _inFlight[MAX_IN_FLIGHT];
+  int _head;
+  int _count;
+  portMUX_TYPE _lock = portMUX_INITIALIZER_UNLOCKED;
+  bool _isInitialized;
+
+  /**
+   * Release the I2C device and bus so the port can be reused (e.g. by Wire)
+   */
+  void release() {
+    if (_device != nullptr) {
+      i2c_master_bus_rm_device(_device);
+      _device = nullptr;
+    }
+    if (_bus != nullptr) {
+      i2c_del_master_bus(_bus);
+      _bus = nullptr;
+    }
+    _isInitialized = false;
+  }
+
+  /**
+   * Pop frames with no pending segments off the head (call with _lock held)
+   * 
+   * @param finished Output array for the retired frames
+   * @return Number of frames retired
+   */
+  int IRAM_ATTR retireCompleted(OledFrame** finished) {
+    int numFinished = 0;
+    while (_count > 0 && _inFlight[_head]->pending <= 0) {
+      finished[numFinished++] = _inFlight[_head];
+      _head = (_head + 1) % MAX_IN_FLIGHT;
+      _count--;
+    }
+    return numFinished;
+  }
+
+  /**
+   * Transaction-done ISR callback: retire one segment of the oldest frame
+   */
+  static bool IRAM_ATTR onTransactionDone(i2c_master_dev_handle_t device,
+                                          const i2c_master_event_data_t* event, void* arg) {
+    AsyncI2CBus* self = static_cast<AsyncI2CBus*>(arg);
+    OledFrame* finished[MAX_IN_FLIGHT];
+    
+    portENTER_CRITICAL_ISR(&self->_lock);
+    if (self->_count > 0) {
+      self->_inFlight[self->_head]->pending--;
+    }
+    int numFinished = self->retireCompleted(finished);
+    portEXIT_CRITICAL_ISR(&self->_lock);
+    
+    bool woken = false;
+    for (int f = 0; f < numFinished; f++) {
+      woken = self->completeFrame(finished[f], true) || woken;
+    }
+    return woken;
+  }
+};
+
+#endif // ASYNC_I2C_BUS_AVAILABLE
+
+#endif // ASYNC_I2C_BUS_H
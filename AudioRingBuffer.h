@@ -0,0 +1,124 @@
+/**
+ * AudioRingBuffer.h
+ * 
+ * Lock-free single-producer/single-consumer ring buffer of 16-bit samples.
+ * The audio task (Core 1) writes a decimated copy of its output; display
+ * code on Core 0 reads it back without any mutex or blocking on either side.
+ */
+
+#ifndef AUDIORINGBUFFER_H
+#define AUDIORINGBUFFER_H
+
+#include <Arduino.h>
+#include <atomic>
+
+// ========== AudioRingBuffer Class ==========
+class AudioRingBuffer {
+public:
+  static const int CAPACITY = 4096;  // Samples (power of two)
+
+  /**
+   * Constructor - starts empty
+   */
+  AudioRingBuffer() : head(0), tail(0), droppedSamples(0) {}
+
+  // ----- Producer side (audio task only) -----
+
+  /**
+   * Append samples; never blocks
+   * If the consumer has fallen behind, samples that do not fit are dropped
+   * @param samples Source samples
+   * @param count Number of samples
+   * @return Number of samples actually written
+   */
+  int write(const int16_t* samples, int count) {
+    uint32_t h = head.load(std::memory_order_relaxed);
+    uint32_t t = tail.load(std::memory_order_acquire);
+    int space = CAPACITY - (int)(h - t);
+    
+    if (count > space) {
+      droppedSamples += count - space;
+      count = space;
+    }
+    
+    for (int i = 0; i < count; i++) {
+      buffer[(h + i) & MASK] = samples[i];
+    }
+    
+    head.store(h + count, std::memory_order_release);
+    return count;
+  }
+
+  // ----- Consumer side (display task only) -----
+
+  /**
+   * Get the number of samples waiting to be read
+   */
+  int available() const {
+    return (int)(head.load(std::memory_order_acquire) - tail.load(std::memory_order_relaxed));
+  }
+
+  /**
+   * Read the oldest unread samples
+   * @param dest Destination buffer
+   * @param maxCount Maximum number of samples to read
+   * @return Number of samples read
+   */
+  int read(int16_t* dest, int maxCount) {
+    uint32_t h = head.load(std::memory_order_acquire);
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    int count = min((int)(h - t), maxCount);
+    
+    for (int i = 0; i < count; i++) {
+      dest[i] = buffer[(t + i) & MASK];
+    }
+    
+    tail.store(t + count, std::memory_order_release);
+    return count;
+  }
+
+  /**
+   * Read the most recent samples, discarding anything older
+   * Useful for visualization where only the latest window matters
+   * @param dest Destination buffer
+   * @param count Number of samples wanted
+   * @return Number of samples read (less than count if not enough buffered)
+   */
+  int readLatest(int16_t* dest, int count) {
+    uint32_t h = head.load(std::memory_order_acquire);
+    uint32_t t = tail.load(std::memory_order_relaxed);
+    
+    // Skip older samples first, so the producer cannot reuse the window we copy
+    if ((int)(h - t) > count) {
+      t = h - count;
+      tail.store(t, std::memory_order_release);
+    }
+    
+    return read(dest, count);
+  }
+
+  /**
+   * Discard all buffered samples
+   * Call while not displaying, so the next read starts with fresh audio
+   */
+  void clear() {
+    tail.store(head.load(std::memory_order_acquire), std::memory_order_release);
+  }
+
+  /**
+   * Get the number of samples dropped because the consumer fell behind
+   */
+  uint32_t getDroppedSamples() const {
+    return droppedSamples;
+  }
+
+private:
+  static const uint32_t MASK = CAPACITY - 1;
+
+  int16_t buffer[CAPACITY];
+  std::atomic<uint32_t> head;  // Written by producer only
+  std::atomic<uint32_t> tail;  // Written by consumer only
+  volatile uint32_t droppedSamples;
+};
+
+#endif // AUDIORINGBUFFER_H
@@ -3,6 +3,8 @@
  * 
  * A multi-phase animated boot sequence that showcases the synth's features
  * with waveforms, burst effects, pulsing text, and feature highlights.
+ * Runs as a frame-stepped state machine driven by the display task, so audio
+ * starts playing while the animation is still on screen.
  */
 
 #ifndef BOOT_ANIMATION_H
@@ -11,6 +13,7 @@
 #include <Arduino.h>
 #include <Adafruit_GFX.h>
 #include <Adafruit_SSD1306.h>
+#include "FixedTrig.h"
 
 /**
  * BootAnimation - Animated boot sequence display
@@ -19,120 +22,258 @@
  * - Phase 1: Animated waveforms building up
  * - Phase 2: Burst effect with expanding circles
  * - Phase 3: Title reveal with pulsing effect
+ * - Phase 4: Wipe to the main screen
+ * - Never blocks: render() draws the step due at the given time and returns
+ * - Time-based steps, so a late frame skips ahead instead of stretching the show
+ * - Integer-only drawing (shared FixedTrig table, no libm per pixel)
  */
 class BootAnimation {
 public:
   /**
-   * Play the complete boot animation sequence
+   * Constructor
+   */
+  BootAnimation() :
+    _display(nullptr),
+    _screenWidth(128),
+    _screenHeight(64),
+    _phase(PHASE_DONE),
+    _step(0),
+    _stepStartTime(0) {
+  }
+
+  /**
+   * Start the boot animation (returns immediately)
    * 
    * @param display Pointer to Adafruit_SSD1306 display object
    * @param screenWidth Screen width in pixels (default: 128)
    * @param screenHeight Screen height in pixels (default: 64)
    */
-  static void play(Adafruit_SSD1306* display, int screenWidth = 128, int screenHeight = 64) {
-    if (display == nullptr) return;
+  void begin(Adafruit_SSD1306* display, int screenWidth = 128, int screenHeight = 64) {
+    _display = display;
+    _screenWidth = screenWidth;
+    _screenHeight = screenHeight;
+    _phase = (display != nullptr) ? PHASE_WAVES : PHASE_DONE;
+    _step = 0;
+    _stepStartTime = millis();
+  }
+
+  /**
+   * Check if the animation still has frames to show
+   */
+  bool isRunning() const {
+    return _phase != PHASE_DONE;
+  }
+
+  /**
+   * Stop the animation early (e.g. on a button press)
+   */
+  void skip() {
+    _phase = PHASE_DONE;
+  }
+
+  /**
+   * Draw the step due at the given time into the display buffer
+   * Does not push the frame - the caller sends it with its normal update
+   * 
+   * @param now Current time in milliseconds (millis())
+   * @return true if an animation frame was drawn, false once finished
+   *         (the buffer is then cleared for the first regular frame)
+   */
+  bool render(unsigned long now) {
+    if (_phase == PHASE_DONE) {
+      return false;
+    }
     
-    const int centerY = screenHeight / 2;
-    const int duration = 80;  // Duration for each frame
+    // Advance past every step whose time is up
+    while (_phase != PHASE_DONE && now - _stepStartTime >= stepDuration()) {
+      _stepStartTime += stepDuration();
+      advance();
+    }
     
-    // Phase 1: Animated waveforms building up (sawtooth, square, triangle, sine)
-    for (int frame = 0; frame < 40; frame++) {
-      display->clearDisplay();
-      
-      float progress = frame / 40.0f;
-      float amplitude = 20.0f * progress;
-      
-      // Draw multiple overlapping waveforms with different phases
-      for (int x = 0; x < screenWidth; x++) {
-        float xNorm = x / (float)screenWidth;
-        
-        // Sawtooth wave
-        float saw = (fmod(xNorm * 3 + progress * 0.5f, 1.0f) - 0.5f) * 2.0f;
-        int y1 = centerY - (int)(amplitude * 0.5f * saw);
-        
-        // Sine wave
-        float sine = sin((xNorm * 3 + progress * 0.3f) * TWO_PI);
-        int y2 = centerY - (int)(amplitude * 0.7f * sine);
-        
-        // Draw pixels for both waves
-        if (x > 0 && frame > 5) {
-          display->drawPixel(x, y1, SSD1306_WHITE);
-          display->drawPixel(x, y2, SSD1306_WHITE);
-        }
-      }
-      
-      display->display();
-      delay(duration / 2);
+    if (_phase == PHASE_DONE) {
+      _display->clearDisplay();
+      return false;
     }
     
-    // Phase 2: Burst effect with expanding circles
-    for (int i = 0; i < 3; i++) {
-      for (int r = 0; r < 50; r += 3) {
-        display->clearDisplay();
-        display->drawCircle(screenWidth / 2, centerY, r, SSD1306_WHITE);
-        display->drawCircle(screenWidth / 2, centerY, r + 5, SSD1306_WHITE);
-        display->display();
-        delay(20);
-      }
+    drawStep();
+    return true;
+  }
+
+private:
+  enum Phase {
+    PHASE_WAVES,
+    PHASE_BURST,
+    PHASE_TITLE,
+    PHASE_WIPE,
+    PHASE_DONE
+  };
+
+  // Step counts and timing (same pacing as the original blocking sequence)
+  static const int WAVE_FRAMES = 40;
+  static const unsigned long WAVE_FRAME_MS = 40;
+  static const int BURST_REPEATS = 3;
+  static const int BURST_RADIUS_STEP = 3;
+  static const int BURST_MAX_RADIUS = 50;
+  static const int BURST_FRAMES = (BURST_MAX_RADIUS + BURST_RADIUS_STEP - 1) / BURST_RADIUS_STEP;
+  static const unsigned long BURST_FRAME_MS = 20;
+  static const int TITLE_PULSES = 3;
+  static const int TITLE_STEPS_PER_PULSE = 3;  // Text, text with lines (+hold), blank
+  static const int TITLE_STEPS = TITLE_PULSES * TITLE_STEPS_PER_PULSE - 1;  // Last pulse stays lit
+  static const unsigned long TITLE_TEXT_MS = 200;
+  static const unsigned long TITLE_LIT_MS = 200 + 150;
+  static const unsigned long TITLE_BLANK_MS = 100;
+  static const unsigned long WIPE_ROW_MS = 5;
+
+  Adafruit_SSD1306* _display;
+  int _screenWidth;
+  int _screenHeight;
+
+  // State machine
+  Phase _phase;
+  int _step;
+  unsigned long _stepStartTime;
+
+  /**
+   * Number of steps in the current phase
+   */
+  int stepCount() const {
+    switch (_phase) {
+      case PHASE_WAVES: return WAVE_FRAMES;
+      case PHASE_BURST: return BURST_REPEATS * BURST_FRAMES;
+      case PHASE_TITLE: return TITLE_STEPS;
+      case PHASE_WIPE:  return _screenHeight / 2;
+      default:          return 0;
     }
+  }
+
+  /**
+   * How long the current step stays on screen
+   */
+  unsigned long stepDuration() const {
+    switch (_phase) {
+      case PHASE_WAVES: return WAVE_FRAME_MS;
+      case PHASE_BURST: return BURST_FRAME_MS;
+      case PHASE_TITLE:
+        switch (_step % TITLE_STEPS_PER_PULSE) {
+          case 0:  return TITLE_TEXT_MS;
+          case 1:  return TITLE_LIT_MS;
+          default: return TITLE_BLANK_MS;
+        }
+      case PHASE_WIPE:  return WIPE_ROW_MS;
+      default:          return 0;
+    }
+  }
+
+  /**
+   * Move to the next step, or the first step of the next phase
+   */
+  void advance() {
+    _step++;
+    if (_step >= stepCount()) {
+      _step = 0;
+      _phase = (Phase)(_phase + 1);
+    }
+  }
+
+  /**
+   * Draw the current step (full redraw; the display only sends what changed)
+   */
+  void drawStep() {
+    _display->clearDisplay();
     
-    // Phase 3: Title reveal with pulsing effect
-    for (int pulse = 0; pulse < 3; pulse++) {
-      // Fade in
-      for (int brightness = 0; brightness < 2; brightness++) {
-        display->clearDisplay();
-        
-        // Draw "CHORD" with large text
-        display->setTextSize(3);
-        display->setTextColor(SSD1306_WHITE);
-        display->setCursor(10, 5);
-        display->println("CHORD");
-        
-        // Draw "SYNTH" below
-        display->setCursor(10, 35);
-        display->println("SYNTH");
-        
-        // Draw decorative waveform lines
-        if (brightness == 1) {
-          // Top line
-          for (int x = 0; x < screenWidth; x++) {
-            int y = 2 + (int)(2 * sin(x * 0.3f));
-            display->drawPixel(x, y, SSD1306_WHITE);
-          }
-          
-          // Bottom line
-          for (int x = 0; x < screenWidth; x++) {
-            int y = screenHeight - 3 + (int)(2 * sin(x * 0.3f + PI));
-            display->drawPixel(x, y, SSD1306_WHITE);
-          }
+    switch (_phase) {
+      case PHASE_WAVES:
+        drawWaves(_step);
+        break;
+      case PHASE_BURST:
+        drawBurst((_step % BURST_FRAMES) * BURST_RADIUS_STEP);
+        break;
+      case PHASE_TITLE:
+        if (_step % TITLE_STEPS_PER_PULSE == 0) {
+          drawTitle(false);  // Fade in
+        } else if (_step % TITLE_STEPS_PER_PULSE == 1) {
+          drawTitle(true);   // Full brightness, then brief hold
         }
-        
-        display->display();
-        delay(200);
-      }
-      
-      // Brief hold
-      delay(150);
-      
-      // Fade out (only for first 2 pulses)
-      if (pulse < 2) {
-        display->clearDisplay();
-        display->display();
-        delay(100);
-      }
+        // Third step of a pulse is the blank fade out
+        break;
+      case PHASE_WIPE:
+        // Final flourish - wipe rows off the lit title
+        drawTitle(true);
+        for (int y = 0; y <= _step * 2; y += 2) {
+          _display->drawFastHLine(0, y, _screenWidth, SSD1306_BLACK);
+        }
+        break;
+      default:
+        break;
     }
+  }
+
+  /**
+   * Phase 1: Animated waveforms building up (sawtooth and sine)
+   */
+  void drawWaves(int frame) {
+    const int centerY = _screenHeight / 2;
     
-    // Final flourish - wipe effect
-    for (int y = 0; y < screenHeight; y += 2) {
-      display->drawFastHLine(0, y, screenWidth, SSD1306_BLACK);
-      display->display();
-      delay(5);
+    if (frame <= 5) {
+      return;  // Blank lead-in
     }
     
-    display->clearDisplay();
-    display->display();
+    // Amplitude grows to 20 px over the phase; three cycles across the screen
+    // (amplitudes in 1/256 px, phases in 1/256 binary-angle steps)
+    const int32_t maxAmplitudeQ8 = 20 * 256;
+    const int32_t turnQ8 = (int32_t)FixedTrig::ANGLE_STEPS << 8;
+    int32_t amplitudeQ8 = maxAmplitudeQ8 * frame / WAVE_FRAMES;
+    int32_t stepQ8 = 3 * turnQ8 / _screenWidth;
+    
+    // Sawtooth wave (half amplitude, drifts half a cycle over the phase)
+    int32_t sawPhaseQ8 = turnQ8 / (2 * WAVE_FRAMES) * frame + stepQ8;
+    FixedDraw::sawTrace(*_display, 1, _screenWidth, centerY, amplitudeQ8 / 2,
+                        sawPhaseQ8, stepQ8, SSD1306_WHITE);
+    
+    // Sine wave (70% amplitude, drifts 0.3 cycle over the phase)
+    int32_t sinePhaseQ8 = turnQ8 * 3 / (10 * WAVE_FRAMES) * frame + stepQ8;
+    FixedDraw::sineTrace(*_display, 1, _screenWidth, centerY, amplitudeQ8 * 7 / 10,
+                         sinePhaseQ8, stepQ8, SSD1306_WHITE);
+  }
+
+  /**
+   * Phase 2: Burst effect with expanding circles
+   */
+  void drawBurst(int radius) {
+    const int centerY = _screenHeight / 2;
+    _display->drawCircle(_screenWidth / 2, centerY, radius, SSD1306_WHITE);
+    _display->drawCircle(_screenWidth / 2, centerY, radius + 5, SSD1306_WHITE);
+  }
+
+  /**
+   * Phase 3: Title text, optionally with decorative waveform lines
+   */
+  void drawTitle(bool withLines) {
+    // Draw "CHORD" with large text
+    _display->setTextSize(3);
+    _display->setTextColor(SSD1306_WHITE);
+    _display->setCursor(10, 5);
+    _display->println("CHORD");
+    
+    // Draw "SYNTH" below
+    _display->setCursor(10, 35);
+    _display->println("SYNTH");
+    
+    if (withLines) {
+      // 0.3 rad per pixel (in 1/256 binary-angle steps), 2 px amplitude,
+      // the two lines half a cycle apart
+      const int32_t LINE_STEP_Q8 = 12516;
+      const int LINE_AMPLITUDE_Q8 = 2 * 256;
+      
+      // Top line
+      FixedDraw::sineTrace(*_display, 0, _screenWidth, 2, LINE_AMPLITUDE_Q8,
+                           (int32_t)FixedTrig::HALF_TURN << 8, LINE_STEP_Q8, SSD1306_WHITE);
+      
+      // Bottom line
+      FixedDraw::sineTrace(*_display, 0, _screenWidth, _screenHeight - 3, LINE_AMPLITUDE_Q8,
+                           0, LINE_STEP_Q8, SSD1306_WHITE);
+    }
   }
 };
 
 #endif // BOOT_ANIMATION_H
-
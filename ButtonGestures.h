@@ -0,0 +1,235 @@
+/**
+ * ButtonGestures.h
+ *
+ * Debouncer and gesture detector for one push button, driven by timestamped
+ * edges. Turns raw (possibly bouncing) edges into InputEvents: press, short,
+ * long, double click and hold-repeat. Pure logic on plain integers - no GPIO,
+ * no clock, no RTOS - so it runs unchanged on the host with synthetic edges.
+ */
+
+#ifndef BUTTONGESTURES_H
+#define BUTTONGESTURES_H
+
+#include <stdint.h>
+
+// ========== Input Events ==========
+enum InputGesture : uint8_t {
+  GESTURE_PRESS,        // Debounced press edge (fires immediately)
+  GESTURE_SHORT,        // Released before longPressMs (delayed by the double-click window if enabled)
+  GESTURE_LONG,         // Released after longPressMs, or after any hold-repeat
+  GESTURE_DOUBLE,       // Second short click within doubleClickMs of the first
+  GESTURE_HOLD_REPEAT   // Still held: fires after repeatDelayMs, then every repeatIntervalMs
+};
+
+struct InputEvent {
+  uint8_t button;       // Button id (index given to the detector)
+  InputGesture gesture;
+  uint16_t count;       // HOLD_REPEAT: repeat number (1, 2, ...); DOUBLE: 2; otherwise 1
+  uint32_t timeMs;      // Time of the edge or deadline that produced the event
+  uint32_t durationMs;  // SHORT / LONG / HOLD_REPEAT: how long the button was held
+};
+
+// Raw edge as captured by the interrupt handler
+struct ButtonEdge {
+  uint8_t button;
+  bool pressed;
+  uint32_t timeMs;
+};
+
+// ========== Gesture Timing ==========
+struct GestureConfig {
+  uint16_t debounceMs;        // Edges closer than this to the last accepted change are bounce
+  uint16_t longPressMs;       // Hold time that makes a release LONG instead of SHORT
+  uint16_t doubleClickMs;     // Max gap between release and next press (0 = no double click)
+  uint16_t repeatDelayMs;     // Hold time before the first repeat (0 = no hold-repeat)
+  uint16_t repeatIntervalMs;  // Time between repeats
+};
+
+// ========== GestureDetector Class ==========
+class GestureDetector {
+public:
+  // Most events a single onEdge() or poll() call can produce
+  static const int MAX_EVENTS = 2;
+  static const uint32_t NO_DEADLINE = 0xFFFFFFFFu;
+
+  /**
+   * Constructor - button released, default timing
+   */
+  GestureDetector() {
+    GestureConfig config = {30, 1000, 0, 0, 0};
+    init(0, config);
+  }
+
+  /**
+   * Reset the detector
+   * @param button Id copied into every event
+   * @param config Timing parameters
+   */
+  void init(uint8_t button, const GestureConfig& config) {
+    _button = button;
+    _config = config;
+    _pressed = false;
+    _rawPressed = false;
+    _lastChangeMs = 0u - config.debounceMs;  // First edge is never treated as bounce
+    _pressTimeMs = 0;
+    _releaseTimeMs = 0;
+    _clickPending = false;
+    _secondClick = false;
+    _firstClickHeldMs = 0;
+    _repeatCount = 0;
+    _nextRepeatMs = 0;
+  }
+
+  /**
+   * Feed one raw edge
+   * @param pressed true for the press edge (pin went active)
+   * @param timeMs Edge timestamp
+   * @param out Receives up to MAX_EVENTS events
+   * @return Number of events written
+   */
+  int onEdge(bool pressed, uint32_t timeMs, InputEvent* out) {
+    _rawPressed = pressed;
+
+    // Leading-edge debounce: act on the first edge, ignore bounce after it
+    if (pressed == _pressed || timeMs - _lastChangeMs < _config.debounceMs) {
+      return 0;
+    }
+    return acceptChange(pressed, timeMs, out);
+  }
+
+  /**
+   * Advance time without an edge: settles a level that changed during the
+   * debounce lockout and fires hold-repeat and double-click timeouts
+   * @param nowMs Current time
+   * @param out Receives up to MAX_EVENTS events
+   * @return Number of events written
+   */
+  int poll(uint32_t nowMs, InputEvent* out) {
+    // Level ended up different from the last accepted state (edge lost in the lockout)
+    if (_rawPressed != _pressed && nowMs - _lastChangeMs >= _config.debounceMs) {
+      return acceptChange(_rawPressed, _lastChangeMs + _config.debounceMs, out);
+    }
+
+    // Hold-repeat while the button stays down
+    if (_pressed && _config.repeatDelayMs > 0 && (int32_t)(nowMs - _nextRepeatMs) >= 0) {
+      _repeatCount++;
+      emit(out[0], GESTURE_HOLD_REPEAT, _nextRepeatMs, _nextRepeatMs - _pressTimeMs, _repeatCount);
+      _nextRepeatMs += _config.repeatIntervalMs > 0 ? _config.repeatIntervalMs : _config.repeatDelayMs;
+      return 1;
+    }
+
+    // No second click arrived - the pending click was a single one
+    if (_clickPending && !_pressed && nowMs - _releaseTimeMs > _config.doubleClickMs) {
+      _clickPending = false;
+      emit(out[0], GESTURE_SHORT, _releaseTimeMs, _releaseTimeMs - _pressTimeMs, 1);
+      return 1;
+    }
+
+    return 0;
+  }
+
+  /**
+   * Time until poll() has something to do
+   * @param nowMs Current time
+   * @return Milliseconds to wait (0 = poll now), or NO_DEADLINE
+   */
+  uint32_t msUntilDeadline(uint32_t nowMs) const {
+    uint32_t wait = NO_DEADLINE;
+
+    if (_rawPressed != _pressed) {
+      wait = remaining(_lastChangeMs + _config.debounceMs, nowMs, wait);
+    }
+    if (_pressed && _config.repeatDelayMs > 0) {
+      wait = remaining(_nextRepeatMs, nowMs, wait);
+    }
+    if (_clickPending && !_pressed) {
+      wait = remaining(_releaseTimeMs + _config.doubleClickMs + 1, nowMs, wait);
+    }
+    return wait;
+  }
+
+  /**
+   * Debounced button state
+   */
+  bool isPressed() const {
+    return _pressed;
+  }
+
+private:
+  uint8_t _button;
+  GestureConfig _config;
+
+  bool _pressed;            // Debounced state
+  bool _rawPressed;         // Level of the most recent raw edge
+  uint32_t _lastChangeMs;   // When the debounced state last changed
+  uint32_t _pressTimeMs;
+  uint32_t _releaseTimeMs;
+  bool _clickPending;       // Short click waiting for a possible second click
+  bool _secondClick;        // Current press started inside the double-click window
+  uint32_t _firstClickHeldMs;
+  uint16_t _repeatCount;
+  uint32_t _nextRepeatMs;
+
+  /**
+   * Apply a debounced state change and classify it
+   */
+  int acceptChange(bool pressed, uint32_t timeMs, InputEvent* out) {
+    _pressed = pressed;
+    _lastChangeMs = timeMs;
+    int count = 0;
+
+    if (pressed) {
+      _secondClick = _clickPending && (timeMs - _releaseTimeMs <= _config.doubleClickMs);
+      _firstClickHeldMs = _releaseTimeMs - _pressTimeMs;
+      if (_clickPending && !_secondClick) {
+        // Window already closed (poll() was late) - report the first click now
+        emit(out[count++], GESTURE_SHORT, _releaseTimeMs, _releaseTimeMs - _pressTimeMs, 1);
+      }
+      _clickPending = false;
+
+      _pressTimeMs = timeMs;
+      _repeatCount = 0;
+      _nextRepeatMs = timeMs + _config.repeatDelayMs;
+      emit(out[count++], GESTURE_PRESS, timeMs, 0, 1);
+      return count;
+    }
+
+    uint32_t held = timeMs - _pressTimeMs;
+
+    if (held >= _config.longPressMs || _repeatCount > 0) {
+      if (_secondClick) {
+        // First click of a pair was a real click on its own
+        emit(out[count++], GESTURE_SHORT, _releaseTimeMs, _firstClickHeldMs, 1);
+      }
+      emit(out[count++], GESTURE_LONG, timeMs, held, 1);
+    } else if (_secondClick) {
+      emit(out[count++], GESTURE_DOUBLE, timeMs, held, 2);
+    } else if (_config.doubleClickMs > 0) {
+      // Wait for a possible second click before calling this a SHORT
+      _clickPending = true;
+      _releaseTimeMs = timeMs;
+    } else {
+      emit(out[count++], GESTURE_SHORT, timeMs, held, 1);
+    }
+
+    _secondClick = false;
+    return count;
+  }
+
+  void emit(InputEvent& event, InputGesture gesture, uint32_t timeMs, uint32_t durationMs,
+            uint16_t count) const {
+    event.button = _button;
+    event.gesture = gesture;
+    event.count = count;
+    event.timeMs = timeMs;
+    event.durationMs = durationMs;
+  }
+
+  static uint32_t remaining(uint32_t deadlineMs, uint32_t nowMs, uint32_t current) {
+    int32_t left = (int32_t)(deadlineMs - nowMs);
+    uint32_t wait = (left > 0) ? (uint32_t)left : 0;
+    return (wait < current) ? wait : current;
+  }
+};
+
+#endif // BUTTONGESTURES_H
@@ -0,0 +1,156 @@
+/**
+ * ButtonInput.h
+ *
+ * Interrupt-driven push buttons. A GPIO interrupt on each edge timestamps the
+ * new level into a lock-free edge queue and wakes the consumer task; the
+ * consumer runs one GestureDetector per button and turns the edges into
+ * InputEvents. Between edges the consumer sleeps until the next gesture
+ * deadline (debounce settle, double-click window, hold-repeat) - no polling.
+ */
+
+#ifndef BUTTONINPUT_H
+#define BUTTONINPUT_H
+
+#include <Arduino.h>
+#include "LockFreeQueue.h"
+#include "ButtonGestures.h"
+
+// ========== ButtonInput Class ==========
+class ButtonInput {
+public:
+  static const int MAX_BUTTONS = 4;
+  static const uint32_t WAIT_FOREVER = GestureDetector::NO_DEADLINE;
+
+  /**
+   * Constructor
+   */
+  ButtonInput() :
+    _numButtons(0),
+    _consumer(nullptr) {
+  }
+
+  /**
+   * Register an active-low button (call before begin())
+   * @param pin GPIO with pull-up; pressed pulls it to GND
+   * @param config Debounce and gesture timing
+   * @return Button id used in InputEvent::button, or -1 if full
+   */
+  int addButton(uint8_t pin, const GestureConfig& config) {
+    if (_numButtons >= MAX_BUTTONS) {
+      return -1;
+    }
+
+    int id = _numButtons++;
+    Button& button = _buttons[id];
+    button.owner = this;
+    button.pin = pin;
+    button.id = (uint8_t)id;
+    button.detector.init((uint8_t)id, config);
+    pinMode(pin, INPUT_PULLUP);
+    return id;
+  }
+
+  /**
+   * Attach the edge interrupts
+   * Must be called from the task that consumes events (it is the one woken)
+   */
+  void begin() {
+    _consumer = xTaskGetCurrentTaskHandle();
+    for (int i = 0; i < _numButtons; i++) {
+      attachInterruptArg(digitalPinToInterrupt(_buttons[i].pin), onEdgeISR, &_buttons[i], CHANGE);
+    }
+  }
+
+  /**
+   * Sleep until a button edge arrives or the next gesture deadline is due
+   * @param maxWaitMs Upper bound on the sleep (WAIT_FOREVER = no bound)
+   */
+  void wait(uint32_t maxWaitMs = WAIT_FOREVER) {
+    if (!_edges.isEmpty()) {
+      return;
+    }
+
+    uint32_t now = millis();
+    uint32_t waitMs = maxWaitMs;
+    for (int i = 0; i < _numButtons; i++) {
+      uint32_t due = _buttons[i].detector.msUntilDeadline(now);
+      if (due < waitMs) waitMs = due;
+    }
+
+    if (waitMs > 0) {
+      ulTaskNotifyTake(pdTRUE, (waitMs == WAIT_FOREVER) ? portMAX_DELAY : pdMS_TO_TICKS(waitMs));
+    }
+  }
+
+  /**
+   * Drain queued edges and expired deadlines into events (consumer task only)
+   * @param out Event buffer
+   * @param maxEvents Capacity of out (events beyond it stay pending for the next call)
+   * @return Number of events written, in time order per button
+   */
+  int read(InputEvent* out, int maxEvents) {
+    int count = 0;
+    InputEvent pending[GestureDetector::MAX_EVENTS];
+
+    // Edges first, so a release is classified by its real timestamp
+    ButtonEdge edge;
+    while (count + GestureDetector::MAX_EVENTS <= maxEvents && _edges.pop(edge)) {
+      int n = _buttons[edge.button].detector.onEdge(edge.pressed, edge.timeMs, pending);
+      for (int i = 0; i < n; i++) out[count++] = pending[i];
+    }
+
+    // Then timeouts (a detector may have several repeats due after a long stall)
+    uint32_t now = millis();
+    for (int b = 0; b < _numButtons; b++) {
+      while (count + GestureDetector::MAX_EVENTS <= maxEvents) {
+        int n = _buttons[b].detector.poll(now, pending);
+        if (n == 0) break;
+        for (int i = 0; i < n; i++) out[count++] = pending[i];
+      }
+    }
+
+    return count;
+  }
+
+  /**
+   * Get the number of edges lost because the queue was full
+   */
+  uint32_t getDroppedEdges() const {
+    return _edges.getDroppedCount();
+  }
+
+private:
+  struct Button {
+    ButtonInput* owner;
+    uint8_t pin;
+    uint8_t id;
+    GestureDetector detector;
+  };
+
+  Button _buttons[MAX_BUTTONS];
+  int _numButtons;
+  TaskHandle_t _consumer;
+  LockFreeQueue<ButtonEdge, 32> _edges;  // ISR -> consumer
+
+  /**
+   * Edge interrupt: timestamp the level, queue it, wake the consumer
+   */
+  static void IRAM_ATTR onEdgeISR(void* arg) {
+    Button* button = (Button*)arg;
+    ButtonInput* self = button->owner;
+
+    ButtonEdge edge;
+    edge.button = button->id;
+    edge.pressed = (digitalRead(button->pin) == LOW);
+    edge.timeMs = millis();
+    self->_edges.push(edge);
+
+    if (self->_consumer != nullptr) {
+      BaseType_t higherPriorityWoken = pdFALSE;
+      vTaskNotifyGiveFromISR(self->_consumer, &higherPriorityWoken);
+      portYIELD_FROM_ISR(higherPriorityWoken);
+    }
+  }
+};
+
+#endif // BUTTONINPUT_H
@@ -64,6 +64,13 @@ struct Chord {
   const char* description; // Optional description of voicing
 };
 
+// ========== Progression Structure ==========
+struct Progression {
+  const char* name;            // Display name (e.g., "Jazz")
+  const Chord* const* chords;  // Chord sequence
+  int length;                  // Number of chords
+};
+
 // ========== Chord Library ==========
 namespace ChordLib {
   // Define all available chords
@@ -135,6 +142,26 @@ namespace ChordLib {
   };
   
   constexpr int MAJOR_251_LENGTH = 3;
+  
+  // Every chord, in menu order (indexed by the CHORD menu)
+  constexpr const Chord* ALL_CHORDS[] = {
+    &CM7,
+    &DM7,
+    &EBMAJ7,
+    &FMAJ7,
+    &GMAJ7,
+    &ABMAJ7
+  };
+  
+  constexpr int NUM_CHORDS = sizeof(ALL_CHORDS) / sizeof(ALL_CHORDS[0]);
+  
+  // Selectable progressions (indexed by the PROGRESSION menu)
+  constexpr Progression PROGRESSIONS[] = {
+    {"Jazz", JAZZ_PROGRESSION_1, JAZZ_PROGRESSION_1_LENGTH},
+    {"ii-V-I", MAJOR_251, MAJOR_251_LENGTH}
+  };
+  
+  constexpr int NUM_PROGRESSIONS = sizeof(PROGRESSIONS) / sizeof(PROGRESSIONS[0]);
 }
 
 #endif // CHORDLIBRARY_H
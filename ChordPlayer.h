@@ -5,6 +5,15 @@
  * Uses ChordLibrary for chord definitions - no hardcoded frequencies.
  * Uses shared Oscillator for waveform generation - no duplication.
  * Each note has independent phase tracking and amplitude scaling to prevent clipping.
+ * Voice count and table size come from the SynthConfig; the mix loop is
+ * instantiated once per unison count, so every trip count is a constant.
+ * A fixed-point build (Config::FIXED_POINT) renders with integers only.
+ * Optional 2x oversampling renders the voices at twice the output rate and
+ * decimates with a fixed-point half-band filter (less aliasing for bright,
+ * wide-unison saw and square chords, at roughly twice the mix cost).
+ * The chord notes can also be played by FmEngine operator stacks,
+ * OrganEngine drawbar partials, NoiseEngine generators or SamplerEngine PCM
+ * voices instead of table voices (unison does not apply to those).
  */
 
 #ifndef CHORDPLAYER_H
@@ -14,30 +23,74 @@
 #include "ChordLibrary.h"
 #include "Oscillator.h"
 #include "UnisonConfig.h"
+#include "HalfBandDecimator.h"
+#include "FmEngine.h"
+#include "OrganEngine.h"
+#include "NoiseSource.h"
+#include "SamplerEngine.h"
+
+// ========== Chord Voice Engines ==========
+enum ChordVoiceEngine {
+  VOICES_TABLE,  // Wavetable voices with unison
+  VOICES_FM,     // FmEngine operator stacks
+  VOICES_ORGAN,  // OrganEngine drawbar partials
+  VOICES_NOISE,  // NoiseEngine generators (one per note)
+  VOICES_SAMPLER // SamplerEngine PCM voices from the mapped SampleBank
+};
 
 // ========== ChordPlayer Class ==========
-class ChordPlayer {
+template <class Config>
+class BasicChordPlayer {
 private:
-  static const int TABLE_SIZE = 256;
-  static const int MAX_VOICES = 12;  // 3 chord notes × 4 max unison voices
+  typedef BasicOscillator<Config> Osc;
+  typedef BasicUnisonConfig<Config> Unison;
+  typedef typename Config::Sample Sample;
+  
+  static constexpr int TABLE_SIZE = Config::TABLE_SIZE;
+  static constexpr int CHORD_NOTES = Config::CHORD_NOTES;
+  static constexpr int MAX_VOICES = Config::MAX_VOICES;  // Chord notes × max unison voices
+  static_assert(CHORD_NOTES == 3, "Chord holds exactly three notes");
+  
+  // Oversampled path: 8 taps per side (31-tap half-band, ~60 dB stopband),
+  // rendered in chunks of 32 output frames
+  typedef HalfBandDecimator<8, 32> Decimator;
   
   // Reference to shared Oscillator (no duplicate tables)
-  const Oscillator* sharedOscillator;
+  const Osc* sharedOscillator;
   
   // Reference to UnisonConfig for detune management
-  const UnisonConfig* unisonConfig;
+  const Unison* unisonConfig;
   
   // Current chord being played
   const Chord* currentChord;
   
-  // Phase accumulators for all voices (3 notes × 4 unison = 12 max)
-  float phases[MAX_VOICES];
+  // Float engine: table steps; fixed-point engine: 32-bit accumulators that wrap on their own
+  typedef typename Config::Phase Phase;
+  typedef typename Unison::Ratio Ratio;
+  static constexpr int PHASE_SHIFT = Config::PHASE_SHIFT;
+  
+  // Phase accumulators for all voices (3 notes × unison)
+  Phase phases[MAX_VOICES];
   
   // Phase increments for all voices
-  float phaseIncrements[MAX_VOICES];
+  Phase phaseIncrements[MAX_VOICES];
   
   // Sample rate stored for chord switching
-  float storedSampleRate;
+  uint32_t storedSampleRate;
+  
+  // Transposition / pitch bend applied to every voice (1.0 = as written)
+  Ratio pitchRatio;
+  
+  // Voices run at oversampling x the output rate (1 or 2)
+  int oversampling;
+  Decimator decimator;
+  
+  // Alternative voices (replace the table voices while selected)
+  BasicFmEngine<Config> fm;
+  BasicOrganEngine<Config> organ;
+  BasicNoiseEngine<Config> noise;
+  BasicSamplerEngine<Config> sampler;
+  ChordVoiceEngine voiceEngine;
   
   /**
    * Calculate phase increments from chord frequencies with unison detuning
@@ -48,49 +101,133 @@ private:
     }
     
     int unisonCount = unisonConfig->getUnisonCount();
-    const float* detuneRatios = unisonConfig->getDetuneRatios();
+    const Ratio* detuneRatios = unisonConfig->getDetuneRatios();
+    uint32_t renderRate = storedSampleRate * oversampling;
     
     // Calculate base phase increments for the three chord notes
-    float baseFreqs[3] = {
+    float baseFreqs[CHORD_NOTES] = {
       currentChord->note1,
       currentChord->note2,
       currentChord->note3
     };
     
+    // FM and organ: undetuned note fundamentals as 32-bit phase steps
+    uint32_t noteIncrements[CHORD_NOTES];
+    for (int note = 0; note < CHORD_NOTES; note++) {
+      if constexpr (Config::FIXED_POINT) {
+        uint32_t noteQ8 = (uint32_t)(baseFreqs[note] * 256.0f + 0.5f);
+        noteIncrements[note] = FixedPitch::phaseIncrement(noteQ8, pitchRatio, renderRate);
+      } else {
+        noteIncrements[note] = (uint32_t)(baseFreqs[note] * pitchRatio * 4294967296.0 / renderRate);
+      }
+    }
+    fm.setNoteIncrements(noteIncrements);
+    organ.setNoteIncrements(noteIncrements);
+    sampler.setNoteIncrements(noteIncrements);
+    
     // Generate phase increments for all voices (3 notes × unison count)
     int voiceIndex = 0;
-    for (int note = 0; note < 3; note++) {
-      for (int unison = 0; unison < unisonCount; unison++) {
-        float detunedFreq = baseFreqs[note] * detuneRatios[unison];
-        phaseIncrements[voiceIndex] = (TABLE_SIZE * detunedFreq) / storedSampleRate;
-        voiceIndex++;
+    for (int note = 0; note < CHORD_NOTES; note++) {
+      if constexpr (Config::FIXED_POINT) {
+        // Chord table frequency to Hz Q8 (once per chord change), then integer only
+        uint32_t noteQ8 = (uint32_t)(baseFreqs[note] * 256.0f + 0.5f);
+        for (int unison = 0; unison < unisonCount; unison++) {
+          uint32_t ratio = FixedPitch::multiply(pitchRatio, detuneRatios[unison]);
+          phaseIncrements[voiceIndex++] = FixedPitch::phaseIncrement(noteQ8, ratio, renderRate);
+        }
+      } else {
+        for (int unison = 0; unison < unisonCount; unison++) {
+          float detunedFreq = baseFreqs[note] * detuneRatios[unison] * pitchRatio;
+          phaseIncrements[voiceIndex] = (TABLE_SIZE * detunedFreq) / renderRate;
+          voiceIndex++;
+        }
       }
     }
   }
   
   /**
-   * Get maximum amplitude per voice to prevent clipping
-   * Scales based on total number of active voices
+   * Mix a fixed number of voices (fully unrollable)
+   * Each voice gets 1/Voices of the waveform peak, so the sum cannot clip
    */
-  int16_t getMaxAmplitudePerVoice() const {
-    if (unisonConfig == nullptr) {
-      return 4666;  // Default: 14000 / 3
-    }
+  template <int Voices>
+  int32_t mixVoices() {
+    int32_t mixedSample = 0;  // Use 32-bit to prevent overflow during mixing
     
-    int totalVoices = 3 * unisonConfig->getUnisonCount();
-    return 14000 / totalVoices;
+    if constexpr (Config::FIXED_POINT) {
+      // Sum at full scale, divide once (a constant, so a multiply)
+      for (int i = 0; i < Voices; i++) {
+        mixedSample += sharedOscillator->getSample((int)(phases[i] >> PHASE_SHIFT));
+        phases[i] += phaseIncrements[i];
+      }
+      return mixedSample / Voices;
+    } else {
+      const Sample maxAmp = Config::MAX_AMPLITUDE / Voices;
+      for (int i = 0; i < Voices; i++) {
+        // Wrap phase accumulator
+        if (phases[i] >= TABLE_SIZE) {
+          phases[i] -= TABLE_SIZE;
+        }
+        
+        // Get scaled sample from shared oscillator
+        mixedSample += sharedOscillator->getSampleScaled((int)phases[i], maxAmp);
+        
+        // Advance phase accumulator
+        phases[i] += phaseIncrements[i];
+      }
+      return mixedSample;
+    }
+  }
+  
+  /**
+   * Render samples at the voice rate with the selected engine
+   * (one call is one FM control block)
+   */
+  void renderVoices(Sample* out, int count) {
+    if (voiceEngine == VOICES_FM) {
+      fm.render(out, count);
+      return;
+    }
+    if (voiceEngine == VOICES_ORGAN) {
+      organ.render(out, count);
+      return;
+    }
+    if (voiceEngine == VOICES_NOISE) {
+      noise.render(out, count);
+      return;
+    }
+    if (voiceEngine == VOICES_SAMPLER) {
+      sampler.render(out, count);
+      return;
+    }
+    for (int i = 0; i < count; i++) {
+      out[i] = getNextSample();
+    }
+  }
+  
+  /**
+   * Pick the mixVoices instantiation for the current unison count
+   */
+  template <int UnisonCount>
+  int32_t mixUnison(int unisonCount) {
+    if constexpr (UnisonCount > 1) {
+      if (unisonCount < UnisonCount) {
+        return mixUnison<UnisonCount - 1>(unisonCount);
+      }
+    }
+    return mixVoices<CHORD_NOTES * UnisonCount>();
   }
   
 public:
   /**
    * Constructor - initializes with default chord (Cm7)
    */
-  ChordPlayer() : currentChord(&ChordLib::CM7), storedSampleRate(44100.0f),
-                  sharedOscillator(nullptr), unisonConfig(nullptr) {
+  BasicChordPlayer() : sharedOscillator(nullptr), unisonConfig(nullptr), currentChord(&ChordLib::CM7),
+                  storedSampleRate(Config::SAMPLE_RATE), pitchRatio(unityRatio()), oversampling(1),
+                  voiceEngine(VOICES_TABLE) {
     // Initialize all phases to zero
     for (int i = 0; i < MAX_VOICES; i++) {
-      phases[i] = 0.0f;
-      phaseIncrements[i] = 0.0f;
+      phases[i] = 0;
+      phaseIncrements[i] = 0;
     }
   }
   
@@ -99,8 +236,10 @@ public:
    * Must be called before generating audio
    * @param osc Pointer to the global Oscillator instance
    */
-  void setOscillator(const Oscillator* osc) {
+  void setOscillator(const Osc* osc) {
     sharedOscillator = osc;
+    fm.setSineTable(osc->getSineTable());
+    organ.setSineTable(osc->getSineTable());
   }
   
   /**
@@ -108,7 +247,7 @@ public:
    * Must be called to enable unison support
    * @param config Pointer to the UnisonConfig instance
    */
-  void setUnisonConfig(const UnisonConfig* config) {
+  void setUnisonConfig(const Unison* config) {
     unisonConfig = config;
     calculatePhaseIncrements();  // Recalculate with new unison settings
   }
@@ -117,7 +256,7 @@ public:
    * Initialize with sample rate
    * @param sampleRate Audio sample rate (e.g., 44100)
    */
-  void init(float sampleRate) {
+  void init(uint32_t sampleRate) {
     storedSampleRate = sampleRate;
     calculatePhaseIncrements();
   }
@@ -128,11 +267,113 @@ public:
    */
   void setChord(const Chord* chord) {
     if (chord != nullptr) {
+      if (chord != currentChord) {
+        sampler.trigger();  // New notes: samples start again (tables just retune)
+      }
       currentChord = chord;
       calculatePhaseIncrements();
     }
   }
   
+  /**
+   * Transpose all voices (MIDI key / pitch bend)
+   * Phases are kept, so the change is click-free
+   * @param centsQ8 Offset in cents Q8 (0 = chord as defined)
+   */
+  void setPitchCents(int32_t centsQ8) {
+    Ratio ratio;
+    if constexpr (Config::FIXED_POINT) {
+      ratio = FixedPitch::ratioQ20(centsQ8);
+    } else {
+      ratio = powf(2.0f, centsQ8 / (float)FixedPitch::OCTAVE);
+    }
+    if (ratio != pitchRatio) {
+      pitchRatio = ratio;
+      calculatePhaseIncrements();
+    }
+  }
+  
+  /**
+   * Select plain or 2x oversampled rendering (render() only)
+   * Phases carry over, so switching does not restart the chord
+   * @param factor 1 or 2
+   */
+  void setOversampling(int factor) {
+    factor = (factor >= 2) ? 2 : 1;
+    if (factor != oversampling) {
+      oversampling = factor;
+      decimator.reset();
+      calculatePhaseIncrements();
+    }
+  }
+  
+  /**
+   * Select which engine plays the chord notes
+   * (the sketch picks it from the waveform: OSC_FM, OSC_ORGAN, OSC_NOISE,
+   * OSC_SAMPLER, else tables)
+   */
+  void setVoiceEngine(ChordVoiceEngine engine) {
+    voiceEngine = engine;
+  }
+  
+  ChordVoiceEngine getVoiceEngine() const {
+    return voiceEngine;
+  }
+  
+  /**
+   * Select the FM patch
+   * @param patch Patch from FmLib
+   */
+  void setFmPatch(const FmPatch* patch) {
+    fm.setPatch(patch);
+  }
+  
+  /**
+   * Scale the FM modulation indices (glides over a few blocks)
+   * @param percent 0-200 (100 = as the patch defines)
+   */
+  void setFmDepth(int percent) {
+    fm.setDepth(percent);
+  }
+  
+  /**
+   * Set the organ drawbars
+   * @param drawbars Nine levels 0-8, 16' first
+   */
+  void setOrganDrawbars(const uint8_t drawbars[OrganLib::NUM_DRAWBARS]) {
+    organ.setRegistration(drawbars);
+  }
+  
+  /**
+   * Set the noise color
+   * @param percent 0 (white) to 100 (darkest)
+   */
+  void setNoiseColor(int percent) {
+    noise.setColor(percent);
+  }
+  
+  /**
+   * Select the PCM sample the sampler voices play (restarts them)
+   * @param sample Sample from a SampleBank, nullptr = silence
+   */
+  void setSamplerSample(const PcmSample* sample) {
+    sampler.setSample(sample);
+  }
+  
+  /**
+   * Get the organ partials sounding for a chord note (after Nyquist culling)
+   */
+  int getOrganPartialCount(int note) const {
+    return organ.getPartialCount(note);
+  }
+  
+  /**
+   * Get the oversampling factor (1 or 2)
+   */
+  int getOversampling() const {
+    return oversampling;
+  }
+  
   /**
    * Recalculate phase increments (public for unison changes)
    * Useful when unison configuration changes
@@ -158,34 +399,57 @@ public:
    * Supports unison: mixes 3 chord notes × unison count voices
    * @return 16-bit audio sample (sum of all voices)
    */
-  int16_t getNextSample() {
+  Sample getNextSample() {
     if (sharedOscillator == nullptr || unisonConfig == nullptr) {
       return 0;  // Safety check
     }
     
-    int unisonCount = unisonConfig->getUnisonCount();
-    int totalVoices = 3 * unisonCount;
-    int16_t maxAmp = getMaxAmplitudePerVoice();
+    // Mix all active voices (3 chord notes × unison count)
+    int32_t mixedSample = mixUnison<Config::MAX_UNISON>(unisonConfig->getUnisonCount());
     
-    int32_t mixedSample = 0;  // Use 32-bit to prevent overflow during mixing
+    // Per-voice headroom keeps the sum within the sample range
+    return (Sample)mixedSample;
+  }
+  
+  /**
+   * Render a block of output-rate samples
+   * With oversampling, voices are mixed at twice the rate straight into the
+   * decimator's input, one chunk at a time
+   * @param out Receives frames mono samples
+   * @param frames Number of samples
+   */
+  void render(Sample* out, int frames) {
+    if (oversampling == 1) {
+      renderVoices(out, frames);
+      return;
+    }
     
-    // Mix all active voices
-    for (int i = 0; i < totalVoices; i++) {
-      // Wrap phase accumulator
-      if (phases[i] >= TABLE_SIZE) {
-        phases[i] -= TABLE_SIZE;
+    while (frames > 0) {
+      int count = (frames < Decimator::MAX_OUTPUT) ? frames : Decimator::MAX_OUTPUT;
+      renderVoices(decimator.input(), 2 * count);
+      decimator.decimate(out, count);
+      out += count;
+      frames -= count;
+    }
+  }
+  
+  /**
+   * Advance every voice as if frames samples had been rendered
+   * Silent stretches skip the mix but stay phase-coherent with it
+   */
+  void advance(uint32_t frames) {
+    frames *= oversampling;
+    decimator.reset();  // Its history is the silence that was skipped
+    fm.advance(frames);
+    organ.advance(frames);
+    sampler.advance(frames);
+    for (int i = 0; i < MAX_VOICES; i++) {
+      if constexpr (Config::FIXED_POINT) {
+        phases[i] += phaseIncrements[i] * frames;  // Wraps modulo one cycle
+      } else {
+        phases[i] = fmodf(phases[i] + phaseIncrements[i] * frames, (float)TABLE_SIZE);
       }
-      
-      // Get scaled sample from shared oscillator
-      int16_t sample = sharedOscillator->getSampleScaled((int)phases[i], maxAmp);
-      mixedSample += sample;
-      
-      // Advance phase accumulator
-      phases[i] += phaseIncrements[i];
     }
-    
-    // Return mixed sample (clamped to 16-bit range)
-    return (int16_t)mixedSample;
   }
   
   /**
@@ -194,8 +458,12 @@ public:
    */
   void reset() {
     for (int i = 0; i < MAX_VOICES; i++) {
-      phases[i] = 0.0f;
+      phases[i] = 0;
     }
+    fm.reset();
+    organ.reset();
+    noise.reset();
+    sampler.reset();
   }
   
   /**
@@ -216,34 +484,25 @@ public:
    * Get the number of notes in the chord
    */
   int getNoteCount() const {
-    return 3;
+    return CHORD_NOTES;
   }
   
   /**
-   * Get display value for visualization (mixed waveform)
-   * Uses shared Oscillator's display method for current waveform
-   * @param time Time value for animation
-   * @return Normalized value for display
+   * Get current chord pointer (useful for comparisons)
    */
-  float getDisplayValue(float time) const {
-    if (currentChord == nullptr || sharedOscillator == nullptr) {
-      return 0.0f;
-    }
-    
-    // Calculate combined waveform using Oscillator's display method
-    float val1 = sharedOscillator->getDisplayValue(TWO_PI * currentChord->note1 * time);
-    float val2 = sharedOscillator->getDisplayValue(TWO_PI * currentChord->note2 * time);
-    float val3 = sharedOscillator->getDisplayValue(TWO_PI * currentChord->note3 * time);
-    
-    return (val1 + val2 + val3) / 3.0f;  // Average for display
+  const Chord* getCurrentChord() const {
+    return currentChord;
   }
   
   /**
-   * Get current chord pointer (useful for comparisons)
+   * 1.0 as a pitch ratio of this engine's number format
    */
-  const Chord* getCurrentChord() const {
-    return currentChord;
+  static constexpr Ratio unityRatio() {
+    return Config::FIXED_POINT ? (Ratio)FixedPitch::ONE : (Ratio)1;
   }
 };
 
+// Engine chord player (see SynthConfig.h)
+typedef BasicChordPlayer<SynthEngineConfig> ChordPlayer;
+
 #endif // CHORDPLAYER_H
@@ -0,0 +1,180 @@
+/**
+ * FixedFFT.h
+ * 
+ * Radix-2 fixed-point real FFT for display-rate spectrum analysis.
+ * N real samples are packed into an N/2-point complex FFT and split
+ * afterwards, so a real transform costs about half a complex one.
+ * Hann window, twiddle factors and bit-reversal indices are computed at
+ * compile time (constexpr) - nothing is built at runtime.
+ */
+
+#ifndef FIXEDFFT_H
+#define FIXEDFFT_H
+
+#include <Arduino.h>
+
+// ========== Compile-time Math ==========
+namespace FFTMath {
+  constexpr double PI_D = 3.14159265358979323846;
+
+  /**
+   * Sine by Taylor series after range reduction to [-PI/2, PI/2]
+   * Accurate to well below one Q15 LSB, usable in constant expressions
+   */
+  constexpr double sinApprox(double x) {
+    while (x > PI_D) x -= 2.0 * PI_D;
+    while (x < -PI_D) x += 2.0 * PI_D;
+    if (x > PI_D / 2.0) x = PI_D - x;
+    if (x < -PI_D / 2.0) x = -PI_D - x;
+    
+    double term = x;
+    double sum = x;
+    for (int n = 1; n < 12; n++) {
+      term *= -x * x / ((2 * n) * (2 * n + 1));
+      sum += term;
+    }
+    return sum;
+  }
+
+  constexpr double cosApprox(double x) {
+    return sinApprox(x + PI_D / 2.0);
+  }
+
+  /**
+   * Convert to Q15 with rounding, saturating at +/-32767
+   */
+  constexpr int16_t toQ15(double v) {
+    double scaled = v * 32768.0;
+    scaled += (scaled >= 0.0) ? 0.5 : -0.5;
+    if (scaled > 32767.0) return 32767;
+    if (scaled < -32767.0) return -32767;
+    return (int16_t)scaled;
+  }
+
+  constexpr int log2Int(int n) {
+    return (n <= 1) ? 0 : 1 + log2Int(n / 2);
+  }
+}
+
+// ========== FixedFFT Class ==========
+template <int N>
+class FixedFFT {
+  static_assert(N >= 16 && (N & (N - 1)) == 0, "FFT size must be a power of two >= 16");
+
+public:
+  static const int SIZE = N;
+  static const int BINS = N / 2;  // Bins 0 .. N/2-1 (DC to just below Nyquist)
+
+  /**
+   * Compute the power spectrum of N real samples
+   * Input is Hann-windowed; output is |X[k]|^2 with the FFT scaled by 1/N
+   * (a full-scale sine of amplitude A peaks near (A/4)^2)
+   * @param input N samples (Q15 / int16 PCM)
+   * @param power Output array of BINS power values
+   */
+  void powerSpectrum(const int16_t* input, uint32_t* power) {
+    // Pack even/odd samples into real/imag parts, windowed, in bit-reversed order
+    for (int n = 0; n < HALF; n++) {
+      int r = TABLES.bitReverse[n];
+      re[r] = (int16_t)(((int32_t)input[2 * n] * TABLES.window[2 * n]) >> 15);
+      im[r] = (int16_t)(((int32_t)input[2 * n + 1] * TABLES.window[2 * n + 1]) >> 15);
+    }
+    
+    complexFFT();
+    
+    // Split the N/2-point complex result into the N-point real spectrum
+    for (int k = 0; k < HALF; k++) {
+      int mk = (HALF - k) & (HALF - 1);
+      
+      // Even part: (Z[k] + conj(Z[M-k])) / 2
+      int32_t evenRe = ((int32_t)re[k] + re[mk]) >> 1;
+      int32_t evenIm = ((int32_t)im[k] - im[mk]) >> 1;
+      
+      // Odd part: -j * (Z[k] - conj(Z[M-k])) / 2
+      int32_t oddRe = ((int32_t)im[k] + im[mk]) >> 1;
+      int32_t oddIm = ((int32_t)re[mk] - re[k]) >> 1;
+      
+      // X[k] = even + W_N^k * odd, with W_N^k = cos - j*sin
+      int32_t wr = TABLES.cosTable[k];
+      int32_t wi = -TABLES.sinTable[k];
+      int32_t xr = evenRe + ((oddRe * wr - oddIm * wi) >> 15);
+      int32_t xi = evenIm + ((oddRe * wi + oddIm * wr) >> 15);
+      
+      // Halve once more so the squared sum always fits in 32 bits
+      xr >>= 1;
+      xi >>= 1;
+      power[k] = (uint32_t)(xr * xr) + (uint32_t)(xi * xi);
+    }
+  }
+
+private:
+  static const int HALF = N / 2;
+  static const int STAGES = FFTMath::log2Int(N / 2);
+
+  /**
+   * Compile-time tables: Hann window (N), twiddles for angles 2*PI*k/N (N/2),
+   * and bit-reversal permutation for the N/2-point complex FFT
+   */
+  struct Tables {
+    int16_t window[N];
+    int16_t cosTable[N / 2];
+    int16_t sinTable[N / 2];
+    uint16_t bitReverse[N / 2];
+    
+    constexpr Tables() : window(), cosTable(), sinTable(), bitReverse() {
+      for (int n = 0; n < N; n++) {
+        window[n] = FFTMath::toQ15(0.5 - 0.5 * FFTMath::cosApprox(2.0 * FFTMath::PI_D * n / N));
+      }
+      for (int k = 0; k < N / 2; k++) {
+        cosTable[k] = FFTMath::toQ15(FFTMath::cosApprox(2.0 * FFTMath::PI_D * k / N));
+        sinTable[k] = FFTMath::toQ15(FFTMath::sinApprox(2.0 * FFTMath::PI_D * k / N));
+      }
+      for (int i = 0; i < N / 2; i++) {
+        int r = 0;
+        for (int b = 0; b < STAGES; b++) {
+          r |= ((i >> b) & 1) << (STAGES - 1 - b);
+        }
+        bitReverse[i] = (uint16_t)r;
+      }
+    }
+  };
+
+  static constexpr Tables TABLES{};
+
+  // Working buffers for the N/2-point complex transform
+  int16_t re[N / 2];
+  int16_t im[N / 2];
+
+  /**
+   * In-place radix-2 DIT complex FFT on bit-reversed input
+   * Scales by 1/2 per stage so values stay within 16 bits
+   */
+  void complexFFT() {
+    for (int size = 2; size <= HALF; size <<= 1) {
+      int half = size >> 1;
+      int twiddleStride = N / size;  // W_size^k == W_N^(k * N/size)
+      
+      for (int start = 0; start < HALF; start += size) {
+        for (int k = 0; k < half; k++) {
+          int32_t wr = TABLES.cosTable[k * twiddleStride];
+          int32_t wi = -TABLES.sinTable[k * twiddleStride];
+          int a = start + k;
+          int b = a + half;
+          
+          int32_t tr = ((int32_t)re[b] * wr - (int32_t)im[b] * wi) >> 15;
+          int32_t ti = ((int32_t)re[b] * wi + (int32_t)im[b] * wr) >> 15;
+          
+          re[b] = (int16_t)((re[a] - tr) >> 1);
+          im[b] = (int16_t)((im[a] - ti) >> 1);
+          re[a] = (int16_t)((re[a] + tr) >> 1);
+          im[a] = (int16_t)((im[a] + ti) >> 1);
+        }
+      }
+    }
+  }
+};
+
+template <int N>
+constexpr typename FixedFFT<N>::Tables FixedFFT<N>::TABLES;
+
+#endif // FIXEDFFT_H
@@ -0,0 +1,113 @@
+/**
+ * FixedPitch.h
+ *
+ * Integer pitch ratios for the fixed-point engine. A pitch offset in cents
+ * (Q8, so pitch bend keeps its resolution) becomes a frequency ratio in Q20
+ * from two small tables - 12 semitones and 101 cents, computed at compile
+ * time - with linear interpolation between cents and a shift per octave.
+ * No libm and no float at run time, so detune, transposition and bend can be
+ * recomputed on FPU-less parts (ESP32-C3/C6) without soft-float calls.
+ */
+
+#ifndef FIXEDPITCH_H
+#define FIXEDPITCH_H
+
+#include <stdint.h>
+
+// ========== Fixed-point Pitch ==========
+namespace FixedPitch {
+  static const int RATIO_SHIFT = 20;               // Ratios in Q20 (ONE == 1.0)
+  static const uint32_t ONE = 1u << RATIO_SHIFT;
+  static const int32_t CENT = 256;                 // Offsets in cents Q8
+  static const int32_t SEMITONE = 100 * CENT;
+  static const int32_t OCTAVE = 1200 * CENT;
+  static const int MAX_OCTAVES = 6;                // Offsets clamp to +-6 octaves
+
+  /**
+   * 2^x for 0 <= x <= 1 by Taylor series, usable in constant expressions
+   */
+  constexpr double exp2Unit(double x) {
+    double y = x * 0.69314718055994530942;  // ln 2
+    double term = 1.0;
+    double sum = 1.0;
+    for (int n = 1; n < 20; n++) {
+      term *= y / n;
+      sum += term;
+    }
+    return sum;
+  }
+
+  /**
+   * Semitone and cent ratio tables in Q30
+   */
+  struct Table {
+    uint32_t semitones[12];   // 2^(s/12)
+    uint32_t cents[101];      // 2^(c/1200), c = 0..100 inclusive for interpolation
+
+    constexpr Table() : semitones(), cents() {
+      for (int s = 0; s < 12; s++) {
+        semitones[s] = (uint32_t)(exp2Unit(s / 12.0) * (1 << 30) + 0.5);
+      }
+      for (int c = 0; c <= 100; c++) {
+        cents[c] = (uint32_t)(exp2Unit(c / 1200.0) * (1 << 30) + 0.5);
+      }
+    }
+  };
+
+  static constexpr Table TABLE{};
+
+  /**
+   * Frequency ratio of a pitch offset
+   * @param centsQ8 Offset in cents Q8 (negative = down)
+   * @return 2^(cents / 1200) in Q20
+   */
+  inline uint32_t ratioQ20(int32_t centsQ8) {
+    const int32_t limit = MAX_OCTAVES * OCTAVE;
+    if (centsQ8 > limit) centsQ8 = limit;
+    if (centsQ8 < -limit) centsQ8 = -limit;
+
+    // Split into octaves (floor) and a positive remainder within the octave
+    int32_t octave = centsQ8 / OCTAVE;
+    int32_t rest = centsQ8 - octave * OCTAVE;
+    if (rest < 0) {
+      rest += OCTAVE;
+      octave--;
+    }
+
+    int semitone = rest / SEMITONE;
+    int32_t centsInSemitone = rest - semitone * SEMITONE;
+    int cent = centsInSemitone >> 8;
+    uint32_t fraction = centsInSemitone & 0xFF;
+
+    // Interpolate within the cent, then apply the semitone (all Q30)
+    uint32_t low = TABLE.cents[cent];
+    uint32_t centRatio = low + (uint32_t)(((uint64_t)(TABLE.cents[cent + 1] - low) * fraction) >> 8);
+    uint64_t ratioQ30 = ((uint64_t)TABLE.semitones[semitone] * centRatio) >> 30;
+
+    // Q30 in [1, 2) to Q20, one bit per octave
+    int shift = 30 - RATIO_SHIFT - octave;
+    return (uint32_t)((ratioQ30 + ((uint64_t)1 << (shift - 1))) >> shift);
+  }
+
+  /**
+   * Phase increment of a 32-bit accumulator (2^32 = one cycle)
+   * @param frequencyQ8 Frequency in Hz Q8
+   * @param ratioQ20 Pitch ratio from ratioQ20()
+   * @param sampleRate Samples per second
+   */
+  inline uint32_t phaseIncrement(uint32_t frequencyQ8, uint32_t ratioQ20, uint32_t sampleRate) {
+    // Hz Q28 times 2^4 is Hz times 2^32; kept whole until the divide so low
+    // notes bent down do not lose their fraction (fits 64 bits up to 6 octaves up)
+    uint64_t scaledQ28 = (uint64_t)frequencyQ8 * ratioQ20;
+    return (uint32_t)((scaledQ28 << (32 - 8 - RATIO_SHIFT)) / sampleRate);
+  }
+
+  /**
+   * Product of two ratios (transposition times detune), rounded
+   */
+  inline uint32_t multiply(uint32_t aQ20, uint32_t bQ20) {
+    return (uint32_t)(((uint64_t)aQ20 * bQ20 + (ONE >> 1)) >> RATIO_SHIFT);
+  }
+}
+
+#endif // FIXEDPITCH_H
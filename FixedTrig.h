@@ -0,0 +1,172 @@
+/**
+ * FixedTrig.h
+ * 
+ * Fixed-point sine/cosine lookup and integer drawing helpers for UI graphics.
+ * Angles are binary angles (ANGLE_STEPS per full turn), so wrapping is a mask
+ * and the quarter-wave table is indexed directly. The table is computed at
+ * compile time (constexpr) and lives in flash - no libm calls and no floats
+ * in the drawing paths on core 0.
+ */
+
+#ifndef FIXEDTRIG_H
+#define FIXEDTRIG_H
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+
+// ========== Fixed-point Trig ==========
+namespace FixedTrig {
+  // Output scale: sin/cos return values in Q14 (ONE == 1.0)
+  static const int SHIFT = 14;
+  static const int ONE = 1 << SHIFT;
+
+  // Binary angle: 1024 steps per turn (~0.35 degrees per step)
+  static const int ANGLE_BITS = 10;
+  static const int ANGLE_STEPS = 1 << ANGLE_BITS;
+  static const int ANGLE_MASK = ANGLE_STEPS - 1;
+  static const int QUARTER = ANGLE_STEPS / 4;
+  static const int HALF_TURN = ANGLE_STEPS / 2;
+
+  constexpr double PI_D = 3.14159265358979323846;
+
+  /**
+   * Sine by Taylor series on [0, PI/2], usable in constant expressions
+   */
+  constexpr double sinQuarter(double x) {
+    double term = x;
+    double sum = x;
+    for (int n = 1; n < 12; n++) {
+      term *= -x * x / ((2 * n) * (2 * n + 1));
+      sum += term;
+    }
+    return sum;
+  }
+
+  /**
+   * Quarter-wave sine table (QUARTER + 1 entries, 0 to 90 degrees inclusive)
+   */
+  struct Table {
+    int16_t quarterSin[QUARTER + 1];
+    
+    constexpr Table() : quarterSin() {
+      for (int i = 0; i <= QUARTER; i++) {
+        quarterSin[i] = (int16_t)(sinQuarter(PI_D / 2.0 * i / QUARTER) * ONE + 0.5);
+      }
+    }
+  };
+
+  static constexpr Table TABLE{};
+
+  /**
+   * Sine of a binary angle (any integer; wraps every ANGLE_STEPS)
+   * @return sin(angle) scaled by ONE
+   */
+  inline int sin(int angle) {
+    angle &= ANGLE_MASK;
+    const int16_t* q = TABLE.quarterSin;
+    if (angle <= QUARTER)     return q[angle];
+    if (angle <= HALF_TURN)   return q[HALF_TURN - angle];
+    if (angle <= 3 * QUARTER) return -q[angle - HALF_TURN];
+    return -q[ANGLE_STEPS - angle];
+  }
+
+  /**
+   * Cosine of a binary angle
+   * @return cos(angle) scaled by ONE
+   */
+  inline int cos(int angle) {
+    return sin(angle + QUARTER);
+  }
+
+  /**
+   * Convert whole degrees to a binary angle (rounded)
+   */
+  constexpr int fromDegrees(int degrees) {
+    return (degrees * ANGLE_STEPS + (degrees >= 0 ? 180 : -180)) / 360;
+  }
+
+  /**
+   * Convert degrees to a binary angle (for configuration values, not per pixel)
+   */
+  inline int fromDegrees(float degrees) {
+    return (int)lroundf(degrees * ANGLE_STEPS / 360.0f);
+  }
+
+  /**
+   * Scale a length by a ONE-based factor with rounding
+   */
+  inline int scale(int length, int trig) {
+    return (length * trig + (ONE / 2)) >> SHIFT;
+  }
+}
+
+// ========== Integer Drawing Helpers ==========
+namespace FixedDraw {
+  /**
+   * Point on an ellipse around (cx, cy); y grows downwards on screen,
+   * so angle 0 is right, QUARTER is up and HALF_TURN is left
+   */
+  inline int polarX(int cx, int radiusX, int angle) {
+    return cx + FixedTrig::scale(radiusX, FixedTrig::cos(angle));
+  }
+
+  inline int polarY(int cy, int radiusY, int angle) {
+    return cy - FixedTrig::scale(radiusY, FixedTrig::sin(angle));
+  }
+
+  /**
+   * Plot an elliptic arc as dots, walking from one angle to another
+   * @param fromAngle Start binary angle
+   * @param toAngle End binary angle (inclusive)
+   * @param step Angle step between dots (positive)
+   */
+  inline void arc(Adafruit_GFX& gfx, int cx, int cy, int radiusX, int radiusY,
+                  int fromAngle, int toAngle, int step, uint16_t color) {
+    int dir = (toAngle >= fromAngle) ? step : -step;
+    for (int a = fromAngle; (dir > 0) ? (a <= toAngle) : (a >= toAngle); a += dir) {
+      gfx.drawPixel(polarX(cx, radiusX, a), polarY(cy, radiusY, a), color);
+    }
+  }
+
+  /**
+   * Line along a ray from the center, between two elliptic radii
+   * (ticks, needles)
+   */
+  inline void radial(Adafruit_GFX& gfx, int cx, int cy, int angle,
+                     int innerX, int innerY, int outerX, int outerY, uint16_t color) {
+    gfx.drawLine(polarX(cx, innerX, angle), polarY(cy, innerY, angle),
+                 polarX(cx, outerX, angle), polarY(cy, outerY, angle), color);
+  }
+
+  /**
+   * Sine trace, one dot per column:
+   * y = centerY - amplitude * sin(phase + x * phaseStep)
+   * @param amplitudeQ8 Amplitude in 1/256 pixel
+   * @param phaseQ8 Binary angle at x0 (Q8, for sub-step precision)
+   * @param phaseStepQ8 Binary angle advance per pixel (Q8)
+   */
+  inline void sineTrace(Adafruit_GFX& gfx, int x0, int x1, int centerY, int amplitudeQ8,
+                        int32_t phaseQ8, int32_t phaseStepQ8, uint16_t color) {
+    for (int x = x0; x < x1; x++) {
+      int s = FixedTrig::sin((int)(phaseQ8 >> 8));
+      gfx.drawPixel(x, centerY - ((amplitudeQ8 * s) >> (FixedTrig::SHIFT + 8)), color);
+      phaseQ8 += phaseStepQ8;
+    }
+  }
+
+  /**
+   * Rising sawtooth trace, one dot per column (same parameters as sineTrace)
+   */
+  inline void sawTrace(Adafruit_GFX& gfx, int x0, int x1, int centerY, int amplitudeQ8,
+                       int32_t phaseQ8, int32_t phaseStepQ8, uint16_t color) {
+    for (int x = x0; x < x1; x++) {
+      // Phase 0..ANGLE_STEPS maps to -ONE..+ONE
+      int p = (int)(phaseQ8 >> 8) & FixedTrig::ANGLE_MASK;
+      int s = (p - FixedTrig::HALF_TURN) * (1 << (FixedTrig::SHIFT + 1 - FixedTrig::ANGLE_BITS));
+      gfx.drawPixel(x, centerY - ((amplitudeQ8 * s) >> (FixedTrig::SHIFT + 8)), color);
+      phaseQ8 += phaseStepQ8;
+    }
+  }
+}
+
+#endif // FIXEDTRIG_H
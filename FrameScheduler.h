@@ -0,0 +1,206 @@
+/*
+ * FrameScheduler.h - Adaptive frame pacing for the display task
+ * 
+ * Paces the display task at a per-frame requested rate while something on
+ * screen is moving (gauge animations, live scope/spectrum), and parks it on
+ * a task notification when the screen is static, so no frames are drawn
+ * until control code reports a state change.
+ */
+
+#ifndef FRAME_SCHEDULER_H
+#define FRAME_SCHEDULER_H
+
+#include <Arduino.h>
+
+/**
+ * FrameScheduler - Frame pacing and frame metrics for one rendering task
+ * 
+ * Features:
+ * - Continuous mode: fixed frame period on the FreeRTOS tick, drift-free
+ * - Event-driven mode (fps = 0): blocks until requestRedraw() is called
+ * - Redraw requests coalesce; never more than MAX_FPS frames per second
+ * - Metrics: measured FPS, last and peak frame time, frames rendered
+ * 
+ * Usage (in the rendering task):
+ *   scheduler.begin();
+ *   int fps = 0;
+ *   while (true) {
+ *     scheduler.waitForNextFrame(fps);
+ *     scheduler.beginFrame();
+ *     fps = render();  // Returns the rate wanted for the next frame
+ *     scheduler.endFrame();
+ *   }
+ */
+class FrameScheduler {
+public:
+  static const int MAX_FPS = 60;                  // Upper bound for any mode
+  static const uint32_t FPS_WINDOW_MS = 1000;     // FPS measurement window
+
+  /**
+   * Constructor
+   */
+  FrameScheduler() :
+    _task(nullptr),
+    _lastFrameTick(0),
+    _frameStartMicros(0),
+    _windowStartMillis(0),
+    _windowFrames(0),
+    _lastFrameMillis(0),
+    _fpsX10(0),
+    _lastFrameMicros(0),
+    _maxFrameMicros(0),
+    _framesRendered(0) {
+  }
+
+  /**
+   * Bind the scheduler to the calling task (call from the rendering task)
+   */
+  void begin() {
+    _lastFrameTick = xTaskGetTickCount();
+    _windowStartMillis = millis();
+    _task = xTaskGetCurrentTaskHandle();
+  }
+
+  /**
+   * Ask for a frame because displayed state changed (any task, not ISRs)
+   * Cheap enough to call on every change; requests coalesce into one frame
+   */
+  void requestRedraw() {
+    TaskHandle_t task = _task;
+    if (task != nullptr) {
+      xTaskNotifyGive(task);
+    }
+  }
+
+  /**
+   * Ask for a frame from an interrupt handler
+   * 
+   * @param woken Set to pdTRUE if a context switch should be requested
+   */
+  void IRAM_ATTR requestRedrawFromISR(BaseType_t* woken) {
+    TaskHandle_t task = _task;
+    if (task != nullptr) {
+      vTaskNotifyGiveFromISR(task, woken);
+    }
+  }
+
+  /**
+   * Block until the next frame is due
+   * 
+   * @param fps Frame rate wanted (0 = static, wait for requestRedraw())
+   */
+  void waitForNextFrame(int fps) {
+    if (fps <= 0) {
+      // Nothing is moving - sleep until control code changes something
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+    
+    // Keep the requested period (or the MAX_FPS floor after an event)
+    TickType_t period = periodTicks(fps > 0 ? fps : MAX_FPS);
+    TickType_t now = xTaskGetTickCount();
+    if ((TickType_t)(now - _lastFrameTick) < period) {
+      vTaskDelay(_lastFrameTick + period - now);
+      _lastFrameTick += period;
+    } else {
+      _lastFrameTick = now;  // Late or coming out of idle - restart the cadence
+    }
+    
+    if (fps > 0) {
+      // This frame shows any change requested so far
+      ulTaskNotifyTake(pdTRUE, 0);
+    }
+  }
+
+  /**
+   * Mark the start of rendering (for frame time)
+   */
+  void beginFrame() {
+    _frameStartMicros = micros();
+  }
+
+  /**
+   * Mark the end of rendering and update metrics
+   */
+  void endFrame() {
+    _lastFrameMicros = micros() - _frameStartMicros;
+    if (_lastFrameMicros > _maxFrameMicros) {
+      _maxFrameMicros = _lastFrameMicros;
+    }
+    _framesRendered++;
+    
+    uint32_t now = millis();
+    _lastFrameMillis = now;
+    _windowFrames++;
+    uint32_t elapsed = now - _windowStartMillis;
+    if (elapsed >= FPS_WINDOW_MS) {
+      _fpsX10 = (_windowFrames * 10000UL) / elapsed;
+      _windowFrames = 0;
+      _windowStartMillis = now;
+    }
+  }
+
+  /**
+   * Get the measured frame rate (0 while idle)
+   */
+  float getFps() const {
+    if (millis() - _lastFrameMillis > FPS_WINDOW_MS) {
+      return 0.0f;  // No frames for a whole window
+    }
+    return _fpsX10 / 10.0f;
+  }
+
+  /**
+   * Get the render time of the last frame in microseconds
+   */
+  uint32_t getLastFrameMicros() const {
+    return _lastFrameMicros;
+  }
+
+  /**
+   * Get the longest render time seen in microseconds
+   */
+  uint32_t getMaxFrameMicros() const {
+    return _maxFrameMicros;
+  }
+
+  /**
+   * Get the number of frames rendered since start
+   */
+  uint32_t getFramesRendered() const {
+    return _framesRendered;
+  }
+
+  /**
+   * Reset the peak frame time
+   */
+  void resetMaxFrameMicros() {
+    _maxFrameMicros = 0;
+  }
+
+private:
+  volatile TaskHandle_t _task;
+
+  // Pacing
+  TickType_t _lastFrameTick;
+
+  // Metrics (written by the rendering task only)
+  uint32_t _frameStartMicros;
+  uint32_t _windowStartMillis;
+  uint32_t _windowFrames;
+  volatile uint32_t _lastFrameMillis;
+  volatile uint32_t _fpsX10;
+  volatile uint32_t _lastFrameMicros;
+  volatile uint32_t _maxFrameMicros;
+  volatile uint32_t _framesRendered;
+
+  /**
+   * Convert a frame rate to a tick period (at least one tick)
+   */
+  static TickType_t periodTicks(int fps) {
+    if (fps > MAX_FPS) fps = MAX_FPS;
+    TickType_t ticks = configTICK_RATE_HZ / fps;
+    return (ticks > 0) ? ticks : 1;
+  }
+};
+
+#endif // FRAME_SCHEDULER_H
@@ -6,6 +6,8 @@
  * - Customizable stop positions and labels
  * - Animated needle with arrow tip
  * - Support for evenly-spaced or custom angle stops
+ * - Static layer (arc, ticks, labels, pivot) rasterized once and blitted per frame
+ * - Integer-only geometry (shared FixedTrig table, binary angles)
  */
 
 #ifndef GAUGE_H
@@ -14,6 +16,7 @@
 #include <Arduino.h>
 #include <Adafruit_GFX.h>
 #include <Adafruit_SSD1306.h>
+#include "FixedTrig.h"
 
 /**
  * Gauge - A reusable arc gauge component for OLED displays
@@ -21,12 +24,25 @@
  * Features:
  * - Configurable number of stops via label count
  * - Optional custom angles or automatic even spacing
+ * - Multiple precomputed layouts held inline, switched without allocation
  * - Elliptic arc for space-efficient display
  * - Double-line arc for detailed appearance
  * - Arrow-tipped needle
+ * - Cached static layer: only the needle is rasterized each frame,
+ *   using the shared FixedTrig lookup table instead of libm trig
+ * - Angles are given in degrees at the API and kept as binary angles inside
  */
 class Gauge {
 public:
+  // Static layer cache covers a full SSD1306 128x64 frame in page layout
+  static const int CACHE_WIDTH = 128;
+  static const int CACHE_HEIGHT = 64;
+  static const int CACHE_PAGES = CACHE_HEIGHT / 8;
+  
+  // Fixed inline storage limits (no heap allocation anywhere in Gauge)
+  static const int MAX_STOPS = 8;
+  static const int MAX_LAYOUTS = 2;
+
   /**
    * Constructor
    */
@@ -36,69 +52,101 @@ public:
     _centerY(0),
     _radiusX(0),
     _radiusY(0),
-    _numStops(0),
-    _labels(nullptr),
-    _angles(nullptr),
-    _customAngles(nullptr),
-    _currentAngle(0.0f),
+    _numLayouts(0),
+    _activeLayout(-1),
+    _currentAngle(0),
     _isAnimating(false),
     _animationStartTime(0),
     _animationDuration(0),
     _animationHoldDuration(0),
-    _previousAngle(0.0f),
-    _targetAngle(0.0f) {
+    _previousAngle(0),
+    _targetAngle(0) {
   }
 
   /**
-   * Initialize the gauge with configuration
+   * Initialize the gauge geometry
+   * Clears any previously added layouts - call once during setup,
+   * then register layouts with addLayout()
    * 
    * @param display Pointer to Adafruit_SSD1306 display object
    * @param centerX Center X coordinate
    * @param centerY Center Y coordinate
    * @param radiusX Horizontal radius (ellipse width)
    * @param radiusY Vertical radius (ellipse height)
-   * @param labels Array of label strings for each stop
-   * @param numLabels Number of labels (determines number of stops)
-   * @param angles Optional array of custom angles (NULL for even spacing from 180° to 0°)
    */
   void init(Adafruit_SSD1306* display, int centerX, int centerY, 
-            int radiusX, int radiusY, const char** labels, int numLabels,
-            const float* angles = nullptr) {
+            int radiusX, int radiusY) {
     _display = display;
     _centerX = centerX;
     _centerY = centerY;
     _radiusX = radiusX;
     _radiusY = radiusY;
-    _numStops = numLabels;
-    _labels = labels;
-    _customAngles = angles;
-    
-    // If custom angles provided, use them; otherwise generate evenly spaced angles
-    if (_customAngles == nullptr && _numStops > 0) {
-      // Allocate memory for evenly spaced angles (180° to 0°)
-      _angles = new float[_numStops];
-      float angleStep = 180.0f / (_numStops - 1);
-      for (int i = 0; i < _numStops; i++) {
-        _angles[i] = 180.0f - (angleStep * i);
+    _numLayouts = 0;
+    _activeLayout = -1;
+  }
+
+  /**
+   * Register a layout (set of stops and labels) and precompute its static layer
+   * The first layout added becomes the active one.
+   * 
+   * @param labels Array of label strings for each stop (must outlive the gauge)
+   * @param numLabels Number of labels (determines number of stops, max MAX_STOPS)
+   * @param angles Optional array of custom angles (NULL for even spacing from 180° to 0°)
+   * @return Layout id for selectLayout(), or -1 if MAX_LAYOUTS is exceeded
+   */
+  int addLayout(const char** labels, int numLabels, const float* angles = nullptr) {
+    if (_numLayouts >= MAX_LAYOUTS || labels == nullptr || numLabels <= 0) {
+      return -1;
+    }
+    
+    Layout& layout = _layouts[_numLayouts];
+    layout.labels = labels;
+    layout.numStops = min(numLabels, (int)MAX_STOPS);
+    
+    // Copy custom angles, or generate evenly spaced angles (180° to 0°)
+    for (int i = 0; i < layout.numStops; i++) {
+      if (angles != nullptr) {
+        layout.angles[i] = FixedTrig::fromDegrees(angles[i]);
+      } else if (layout.numStops > 1) {
+        layout.angles[i] = HALF_TURN - (HALF_TURN * i + (layout.numStops - 1) / 2) / (layout.numStops - 1);
+      } else {
+        layout.angles[i] = HALF_TURN;
       }
-    } else {
-      // Cast away const for internal storage pointer
-      _angles = const_cast<float*>(_customAngles);
     }
     
-    // Initialize needle to first stop position
-    if (_angles != nullptr && _numStops > 0) {
-      _currentAngle = _angles[0];
+    // Rasterize the static layer once; draw() only blits it from now on
+    buildCache(layout);
+    
+    int id = _numLayouts++;
+    if (_activeLayout < 0) {
+      selectLayout(id);
     }
+    return id;
   }
 
   /**
-   * Destructor - clean up dynamically allocated angles if created
+   * Switch to a precomputed layout
+   * Only swaps the active index and resets the needle to the layout's first
+   * stop - no allocation or rasterization, safe to call from the audio task.
+   * 
+   * @param id Layout id returned by addLayout()
    */
-  ~Gauge() {
-    if (_customAngles == nullptr && _angles != nullptr) {
-      delete[] _angles;
+  void selectLayout(int id) {
+    if (id < 0 || id >= _numLayouts) {
+      return;
     }
+    
+    _activeLayout = id;
+    _currentAngle = _layouts[id].angles[0];
+  }
+
+  /**
+   * Get the active layout id
+   * 
+   * @return Layout id, or -1 if no layout has been added
+   */
+  int getLayout() const {
+    return _activeLayout;
   }
 
   /**
@@ -107,7 +155,7 @@ public:
    * @param angle Angle in degrees (0-360, where 180° is left, 0° is right)
    */
   void setAngle(float angle) {
-    _currentAngle = angle;
+    _currentAngle = FixedTrig::fromDegrees(angle);
   }
 
   /**
@@ -120,7 +168,7 @@ public:
   void startAnimation(float targetAngle, unsigned long animationDurationMs = 450, 
                       unsigned long holdDurationMs = 500) {
     _previousAngle = _currentAngle;
-    _targetAngle = targetAngle;
+    _targetAngle = FixedTrig::fromDegrees(targetAngle);
     _animationStartTime = millis();
     _animationDuration = animationDurationMs;
     _animationHoldDuration = holdDurationMs;
@@ -158,9 +206,8 @@ public:
     // Calculate current angle based on animation progress
     if (elapsed < _animationDuration) {
       // Animating - interpolate between previous and target angles
-      float progress = (float)elapsed / (float)_animationDuration;
-      float angleDelta = getShortestAnglePath(_previousAngle, _targetAngle);
-      _currentAngle = _previousAngle + (angleDelta * progress);
+      int angleDelta = getShortestAnglePath(_previousAngle, _targetAngle);
+      _currentAngle = _previousAngle + (int)((int32_t)angleDelta * (int32_t)elapsed / (int32_t)_animationDuration);
     } else {
       // Animation complete - use target angle (static hold period)
       _currentAngle = _targetAngle;
@@ -172,21 +219,23 @@ public:
   /**
    * Draw the complete gauge (arc, ticks, labels, needle)
    * Call this after setAngle() to render the gauge
+   * 
+   * The arc, ticks, labels and pivot come from the cache built in init();
+   * only the needle is drawn live.
    */
   void draw() {
-    if (_display == nullptr || _angles == nullptr || _numStops == 0) {
+    int active = _activeLayout;
+    if (_display == nullptr || active < 0) {
       return;
     }
     
-    drawArc();
-    drawTicks();
-    drawLabels();
+    blitCache(_layouts[active]);
     drawNeedle();
-    drawPivot();
   }
 
   /**
    * Draw the gauge with animation and bottom label
+   * Renders into the framebuffer only - the caller pushes it to the panel
    * 
    * @param bottomLabel Text to display at bottom center (or nullptr for no label)
    * @param labelSize Text size for bottom label (default: 2)
@@ -212,8 +261,6 @@ public:
       _display->setCursor((screenWidth - textWidth) / 2, screenHeight - 16);
       _display->print(bottomLabel);
     }
-    
-    _display->display();
   }
 
 private:
@@ -224,22 +271,37 @@ private:
   int _radiusX;
   int _radiusY;
   
+  /**
+   * Layout - one precomputed stop configuration with its static layer
+   */
+  struct Layout {
+    const char** labels;
+    int numStops;
+    int angles[MAX_STOPS];     // Binary angles (FixedTrig::ANGLE_STEPS per turn)
+    
+    // Static layer cache (SSD1306 page layout: one byte = 8 vertical pixels)
+    alignas(4) uint8_t cache[CACHE_WIDTH * CACHE_PAGES];
+    int cacheFirstPage;        // First page touched by the static layer
+    int cacheLastPage;         // Last page touched (-1 if cache is empty)
+  };
+  
   // Stop configuration
-  int _numStops;
-  const char** _labels;
-  float* _angles;              // Either points to _customAngles or dynamically allocated
-  const float* _customAngles;  // User-provided custom angles (or nullptr)
+  Layout _layouts[MAX_LAYOUTS];
+  int _numLayouts;
+  volatile int _activeLayout;  // Index into _layouts (-1 if none)
   
-  // Current state
-  float _currentAngle;
+  // Current state (binary angles)
+  int _currentAngle;
   
   // Animation state
   bool _isAnimating;
   unsigned long _animationStartTime;
   unsigned long _animationDuration;
   unsigned long _animationHoldDuration;
-  float _previousAngle;
-  float _targetAngle;
+  int _previousAngle;
+  int _targetAngle;
+
+  static const int HALF_TURN = FixedTrig::HALF_TURN;
 
   /**
    * Calculate shortest angle path between two angles
@@ -249,120 +311,230 @@ private:
    * @param to Target angle
    * @return Angle delta (can be negative for counterclockwise)
    */
-  float getShortestAnglePath(float from, float to) {
-    // Special case: SINE (0°) back to SAWTOOTH (180°) - go all the way back counterclockwise
-    if (from == 0.0f && to == 180.0f) {
-      return -180.0f;  // Go counterclockwise through the full sweep
+  int getShortestAnglePath(int from, int to) {
+    // Special case: last stop (0°) back to the first (180°) - go all the way back counterclockwise
+    if (from == 0 && to == HALF_TURN) {
+      return -HALF_TURN;  // Go counterclockwise through the full sweep
     }
     
-    float delta = to - from;
+    int delta = to - from;
     
-    // Normalize to [-180, 180] range to find shortest path
-    while (delta > 180.0f) delta -= 360.0f;
-    while (delta < -180.0f) delta += 360.0f;
+    // Normalize to [-180°, 180°] range to find shortest path
+    while (delta > HALF_TURN) delta -= FixedTrig::ANGLE_STEPS;
+    while (delta < -HALF_TURN) delta += FixedTrig::ANGLE_STEPS;
     
     return delta;
   }
 
   /**
-   * Draw the elliptic arc with double lines
+   * CacheCanvas - Minimal GFX target that rasterizes into the cache
+   * 
+   * Uses the same page layout as the SSD1306 framebuffer so the cache can be
+   * OR-ed into the display buffer byte by byte. Tracks the page band touched.
    */
-  void drawArc() {
-    const float arcStartAngle = 180.0f;
-    const float arcEndAngle = 0.0f;
+  class CacheCanvas : public Adafruit_GFX {
+  public:
+    CacheCanvas(uint8_t* buffer, int16_t width, int16_t height) :
+      Adafruit_GFX(width, height),
+      _buffer(buffer),
+      _firstPage(height / 8),
+      _lastPage(-1) {
+    }
     
-    for (float angle = arcStartAngle; angle >= arcEndAngle; angle -= 1.5f) {
-      float radians = angle * PI / 180.0f;
-      
-      // Outer arc line
-      int x = _centerX + _radiusX * cos(radians);
-      int y = _centerY - _radiusY * sin(radians);
-      _display->drawPixel(x, y, SSD1306_WHITE);
-      
-      // Inner arc line (double-line effect)
-      int x2 = _centerX + (_radiusX - 2) * cos(radians);
-      int y2 = _centerY - (_radiusY - 2) * sin(radians);
-      _display->drawPixel(x2, y2, SSD1306_WHITE);
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+      if (x < 0 || y < 0 || x >= width() || y >= height() || color != SSD1306_WHITE) {
+        return;
+      }
+      int page = y / 8;
+      _buffer[page * CACHE_WIDTH + x] |= (uint8_t)(1 << (y & 7));
+      if (page < _firstPage) _firstPage = page;
+      if (page > _lastPage) _lastPage = page;
+    }
+    
+    int firstPage() const { return _firstPage; }
+    int lastPage() const { return _lastPage; }
+    
+  private:
+    uint8_t* _buffer;
+    int _firstPage;
+    int _lastPage;
+  };
+  
+  /**
+   * Rasterize arc, ticks, labels and pivot into the cache
+   * All static elements are drawn in white, so drawing order does not
+   * matter and the needle can simply be drawn over the blitted cache.
+   */
+  void buildCache(Layout& layout) {
+    memset(layout.cache, 0, sizeof(layout.cache));
+    layout.cacheFirstPage = 0;
+    layout.cacheLastPage = -1;
+    
+    if (_display == nullptr) {
+      return;
+    }
+    
+    int width = min((int)_display->width(), (int)CACHE_WIDTH);
+    int height = min((int)_display->height(), (int)CACHE_HEIGHT);
+    CacheCanvas canvas(layout.cache, width, height);
+    
+    drawArc(canvas);
+    drawTicks(canvas, layout);
+    drawLabels(canvas, layout);
+    drawPivot(canvas);
+    
+    layout.cacheFirstPage = canvas.firstPage();
+    layout.cacheLastPage = canvas.lastPage();
+  }
+  
+  /**
+   * OR the cached static layer into the display framebuffer
+   */
+  void blitCache(const Layout& layout) {
+    uint8_t* dst = _display->getBuffer();
+    if (dst == nullptr) return;
+    
+    // Locals, so the loop does not reload them through the byte pointers
+    const int stride = _display->width();
+    const int width = min(stride, (int)CACHE_WIDTH);
+    const int firstPage = layout.cacheFirstPage;
+    const int lastPage = layout.cacheLastPage;
+    
+    // 32 bits at a time (rows are 128 bytes, the cache is word aligned)
+    for (int page = firstPage; page <= lastPage; page++) {
+      const uint8_t* src = &layout.cache[page * CACHE_WIDTH];
+      uint8_t* row = &dst[page * stride];
+      int x = 0;
+      for (; x + 4 <= width; x += 4) {
+        uint32_t a, b;
+        memcpy(&a, &row[x], 4);
+        memcpy(&b, &src[x], 4);
+        a |= b;
+        memcpy(&row[x], &a, 4);
+      }
+      for (; x < width; x++) {
+        row[x] |= src[x];
+      }
     }
   }
 
+  /**
+   * Draw the elliptic arc with double lines
+   */
+  void drawArc(Adafruit_GFX& gfx) {
+    // ~1.4° between dots, from 180° (left) to 0° (right)
+    const int ARC_STEP = 4;
+    
+    // Outer arc line, then inner arc line (double-line effect)
+    FixedDraw::arc(gfx, _centerX, _centerY, _radiusX, _radiusY,
+                   HALF_TURN, 0, ARC_STEP, SSD1306_WHITE);
+    FixedDraw::arc(gfx, _centerX, _centerY, _radiusX - 2, _radiusY - 2,
+                   HALF_TURN, 0, ARC_STEP, SSD1306_WHITE);
+  }
+
   /**
    * Draw tick marks at each stop position
    */
-  void drawTicks() {
-    for (int i = 0; i < _numStops; i++) {
-      float tickRadians = _angles[i] * PI / 180.0f;
-      
-      // Calculate tick endpoints (radial line from arc inward and outward)
-      int tickX1 = _centerX + (_radiusX - 3) * cos(tickRadians);
-      int tickY1 = _centerY - (_radiusY - 3) * sin(tickRadians);
-      int tickX2 = _centerX + (_radiusX + 3) * cos(tickRadians);
-      int tickY2 = _centerY - (_radiusY + 3) * sin(tickRadians);
-      
-      _display->drawLine(tickX1, tickY1, tickX2, tickY2, SSD1306_WHITE);
+  void drawTicks(Adafruit_GFX& gfx, const Layout& layout) {
+    for (int i = 0; i < layout.numStops; i++) {
+      // Radial line from just inside the arc to just outside it
+      FixedDraw::radial(gfx, _centerX, _centerY, layout.angles[i],
+                        _radiusX - 3, _radiusY - 3, _radiusX + 3, _radiusY + 3, SSD1306_WHITE);
     }
   }
 
   /**
    * Draw text labels at each stop position
    */
-  void drawLabels() {
-    _display->setTextSize(1);
-    _display->setTextColor(SSD1306_WHITE);
+  void drawLabels(Adafruit_GFX& gfx, const Layout& layout) {
+    gfx.setTextSize(1);
+    gfx.setTextColor(SSD1306_WHITE);
     
-    for (int i = 0; i < _numStops; i++) {
-      float labelRadians = _angles[i] * PI / 180.0f;
-      
+    for (int i = 0; i < layout.numStops; i++) {
       // Position label outside the arc
-      int labelX = _centerX + (_radiusX + 9) * cos(labelRadians);
-      int labelY = _centerY - (_radiusY + 9) * sin(labelRadians);
+      int labelX = FixedDraw::polarX(_centerX, _radiusX + 9, layout.angles[i]);
+      int labelY = FixedDraw::polarY(_centerY, _radiusY + 9, layout.angles[i]);
       
       // Center the text on the tick position
       // Approximate width: each character is ~6 pixels wide in size 1
-      int textWidth = strlen(_labels[i]) * 6;
+      int textWidth = strlen(layout.labels[i]) * 6;
       labelX -= textWidth / 2;
       labelY -= 4;  // Adjust vertically for better centering
       
-      _display->setCursor(labelX, labelY);
-      _display->print(_labels[i]);
+      gfx.setCursor(labelX, labelY);
+      gfx.print(layout.labels[i]);
     }
   }
 
   /**
    * Draw the needle pointer with arrow tip
+   * Uses the shared integer trig table - no libm calls per frame
    */
   void drawNeedle() {
-    float needleRadians = _currentAngle * PI / 180.0f;
+    int needleAngle = _currentAngle;
     
     // Calculate needle tip position
-    int needleX = _centerX + (_radiusX - 8) * cos(needleRadians);
-    int needleY = _centerY - (_radiusY - 8) * sin(needleRadians);
+    int needleX = FixedDraw::polarX(_centerX, _radiusX - 8, needleAngle);
+    int needleY = FixedDraw::polarY(_centerY, _radiusY - 8, needleAngle);
     
-    // Draw thick needle line from center to tip
-    _display->drawLine(_centerX, _centerY, needleX, needleY, SSD1306_WHITE);
-    _display->drawLine(_centerX + 1, _centerY, needleX + 1, needleY, SSD1306_WHITE);
-    _display->drawLine(_centerX, _centerY + 1, needleX, needleY + 1, SSD1306_WHITE);
+    // Thick needle from center to tip, straight into the framebuffer
+    drawThickLine(_centerX, _centerY, needleX, needleY);
     
     // Draw arrow tip at needle end
-    // Calculate arrow wing positions
-    float perpAngle1 = needleRadians + 2.5f;
-    float perpAngle2 = needleRadians - 2.5f;
+    // Arrow wings sit 2.5 rad (~143°) either side of the needle direction
+    const int WING_OFFSET = FixedTrig::fromDegrees(143);
+    int perpAngle1 = needleAngle + WING_OFFSET;
+    int perpAngle2 = needleAngle - WING_OFFSET;
     
-    int arrowWing1X = needleX - 4 * cos(perpAngle1);
-    int arrowWing1Y = needleY + 4 * sin(perpAngle1);
-    int arrowWing2X = needleX - 4 * cos(perpAngle2);
-    int arrowWing2Y = needleY + 4 * sin(perpAngle2);
+    int arrowWing1X = needleX - FixedTrig::scale(4, FixedTrig::cos(perpAngle1));
+    int arrowWing1Y = needleY + FixedTrig::scale(4, FixedTrig::sin(perpAngle1));
+    int arrowWing2X = needleX - FixedTrig::scale(4, FixedTrig::cos(perpAngle2));
+    int arrowWing2Y = needleY + FixedTrig::scale(4, FixedTrig::sin(perpAngle2));
     
     // Draw arrow as a filled triangle
     _display->fillTriangle(needleX, needleY, arrowWing1X, arrowWing1Y, 
                           arrowWing2X, arrowWing2Y, SSD1306_WHITE);
   }
 
+  /**
+   * One Bresenham walk that sets each point plus its right and lower
+   * neighbours: the thick line three drawLine() calls offset by one give,
+   * without a virtual drawPixel() per pixel
+   */
+  void drawThickLine(int x0, int y0, int x1, int y1) {
+    uint8_t* buffer = _display->getBuffer();
+    if (buffer == nullptr) return;
+    const int width = _display->width();
+    const int height = _display->height();
+    
+    // The needle normally stays on screen: then no per-pixel clipping
+    bool inside = min(x0, x1) >= 0 && max(x0, x1) + 1 < width &&
+                  min(y0, y1) >= 0 && max(y0, y1) + 1 < height;
+    auto plot = [&](int x, int y) {
+      if (inside || (x >= 0 && x < width && y >= 0 && y < height)) {
+        buffer[(y >> 3) * width + x] |= (uint8_t)(1 << (y & 7));
+      }
+    };
+    
+    int dx = abs(x1 - x0), sx = (x0 < x1) ? 1 : -1;
+    int dy = -abs(y1 - y0), sy = (y0 < y1) ? 1 : -1;
+    int error = dx + dy;
+    while (true) {
+      plot(x0, y0);
+      plot(x0 + 1, y0);
+      plot(x0, y0 + 1);
+      if (x0 == x1 && y0 == y1) break;
+      int twice = 2 * error;
+      if (twice >= dy) { error += dy; x0 += sx; }
+      if (twice <= dx) { error += dx; y0 += sy; }
+    }
+  }
+
   /**
    * Draw the center pivot point
    */
-  void drawPivot() {
-    _display->fillCircle(_centerX, _centerY, 3, SSD1306_WHITE);
+  void drawPivot(Adafruit_GFX& gfx) {
+    gfx.fillCircle(_centerX, _centerY, 3, SSD1306_WHITE);
   }
 };
 
@@ -0,0 +1,150 @@
+/**
+ * HalfBandDecimator.h
+ *
+ * 2:1 decimator for the oversampled render path. A half-band low-pass has
+ * every other coefficient zero except the centre tap (exactly 1/2), so its
+ * two polyphase branches are a single shift and a short symmetric FIR; the
+ * symmetric branch is folded (x[c-n] + x[c+n]) * h[n], leaving one multiply
+ * per coefficient pair and output sample. Coefficients are Kaiser-windowed
+ * sinc, designed at compile time and rounded to Q15 with the DC gain kept
+ * exactly at 1. Integer only, in both engine builds.
+ *
+ * The caller renders 2 * n input samples straight into input() and then
+ * calls decimate() for n outputs; the filter history sits in front of that
+ * space, so nothing is copied per sample.
+ */
+
+#ifndef HALFBANDDECIMATOR_H
+#define HALFBANDDECIMATOR_H
+
+#include <stdint.h>
+#include <string.h>
+
+// ========== Half-band Filter Design ==========
+namespace HalfBandDesign {
+  constexpr double PI_D = 3.14159265358979323846;
+
+  constexpr double sqrtNewton(double x) {
+    double y = (x > 1.0) ? x : 1.0;
+    for (int i = 0; i < 40; i++) {
+      y = 0.5 * (y + x / y);
+    }
+    return y;
+  }
+
+  // Zeroth-order modified Bessel function (Kaiser window)
+  constexpr double besselI0(double x) {
+    double term = 1.0;
+    double sum = 1.0;
+    for (int k = 1; k < 30; k++) {
+      term *= (x / (2.0 * k)) * (x / (2.0 * k));
+      sum += term;
+    }
+    return sum;
+  }
+
+  /**
+   * Side coefficients of a half-band filter in Q15
+   * coeffs[k] is the tap at offsets +-(2k + 1) from the centre
+   */
+  template <int TapsPerSide>
+  struct Coefficients {
+    int16_t coeffs[TapsPerSide];
+
+    constexpr Coefficients(double beta) : coeffs() {
+      const double halfLength = 2.0 * TapsPerSide;  // First zero of the window
+      double ideal[TapsPerSide] = {};
+      double sum = 0.0;
+      for (int k = 0; k < TapsPerSide; k++) {
+        int n = 2 * k + 1;
+        double ratio = n / halfLength;
+        double window = besselI0(beta * sqrtNewton(1.0 - ratio * ratio)) / besselI0(beta);
+        double sinc = ((k & 1) ? -1.0 : 1.0) / (PI_D * n);  // sin(pi n / 2) / (pi n)
+        ideal[k] = sinc * window;
+        sum += ideal[k];
+      }
+
+      // Each side sums to 1/4 so centre + both sides pass DC at unity; the
+      // rounding remainder goes to the largest tap
+      int total = 0;
+      for (int k = 0; k < TapsPerSide; k++) {
+        double scaled = ideal[k] * (0.25 / sum) * 32768.0;
+        coeffs[k] = (int16_t)(scaled < 0 ? scaled - 0.5 : scaled + 0.5);
+        total += coeffs[k];
+      }
+      coeffs[0] = (int16_t)(coeffs[0] + (8192 - total));
+    }
+  };
+}
+
+// ========== HalfBandDecimator Class ==========
+template <int TapsPerSide, int MaxOutput>
+class HalfBandDecimator {
+public:
+  static constexpr int TAPS = 4 * TapsPerSide - 1;  // Including the zero taps
+  static constexpr int HISTORY = TAPS - 1;
+  static constexpr int MAX_OUTPUT = MaxOutput;      // Outputs per decimate() call
+  static constexpr int LATENCY = (TAPS - 1) / 4;    // Group delay in output samples (rounded down)
+  static_assert(TapsPerSide >= 2 && TapsPerSide <= 16, "Half-band needs 2 to 16 taps per side");
+
+  /**
+   * Constructor - silent history
+   */
+  HalfBandDecimator() {
+    reset();
+  }
+
+  /**
+   * Clear the filter history (after a discontinuity)
+   */
+  void reset() {
+    memset(_line, 0, sizeof(_line));
+  }
+
+  /**
+   * Space for the next 2 * MAX_OUTPUT input samples
+   */
+  int16_t* input() {
+    return &_line[HISTORY];
+  }
+
+  /**
+   * Filter and decimate the samples written to input()
+   * @param out Receives count samples at half the input rate
+   * @param count Outputs to produce (2 * count inputs are consumed), at most MAX_OUTPUT
+   */
+  void decimate(int16_t* out, int count) {
+    for (int m = 0; m < count; m++) {
+      const int16_t* center = &_line[2 * m + 1 + TAPS / 2];
+      int32_t acc = (int32_t)center[0] << 14;  // Centre tap = 1/2
+      for (int k = 0; k < TapsPerSide; k++) {
+        int n = 2 * k + 1;
+        acc += (int32_t)COEFFS.coeffs[k] * ((int32_t)center[-n] + center[n]);
+      }
+      acc = (acc + (1 << 14)) >> 15;
+      if (acc > 32767) acc = 32767;
+      if (acc < -32768) acc = -32768;
+      out[m] = (int16_t)acc;
+    }
+
+    // Keep the newest HISTORY inputs in front of the next block
+    memmove(_line, &_line[2 * count], HISTORY * sizeof(int16_t));
+  }
+
+  /**
+   * Get a side coefficient in Q15 (offset +-(2k + 1) from the centre)
+   */
+  static int16_t getCoefficient(int k) {
+    return COEFFS.coeffs[k];
+  }
+
+private:
+  static constexpr HalfBandDesign::Coefficients<TapsPerSide> COEFFS{5.65};  // Kaiser beta: ~60 dB stopband
+
+  int16_t _line[HISTORY + 2 * MaxOutput];
+};
+
+template <int TapsPerSide, int MaxOutput>
+constexpr HalfBandDesign::Coefficients<TapsPerSide> HalfBandDecimator<TapsPerSide, MaxOutput>::COEFFS;
+
+#endif // HALFBANDDECIMATOR_H
@@ -126,6 +126,36 @@ public:
     return (err == ESP_OK);
   }
 
+  /**
+   * Change the sample rate of the running channel
+   * The channel is stopped for the clock change, so call this between writes
+   * 
+   * @param sampleRate New sample rate in Hz
+   * @return true if the channel runs at the new rate
+   */
+  bool setSampleRate(uint32_t sampleRate) {
+    if (!_isInitialized || _txHandle == nullptr) {
+      return false;
+    }
+    if (sampleRate == _sampleRate) {
+      return true;
+    }
+    
+    i2s_std_clk_config_t clk_cfg = I2S_STD_CLK_DEFAULT_CONFIG(sampleRate);
+    esp_err_t err = i2s_channel_disable(_txHandle);
+    if (err == ESP_OK) {
+      err = i2s_channel_reconfig_std_clock(_txHandle, &clk_cfg);
+    }
+    esp_err_t enableErr = i2s_channel_enable(_txHandle);  // Restart even if the change failed
+    if (err != ESP_OK || enableErr != ESP_OK) {
+      Serial.printf("I2S: Failed to change sample rate: %d / %d\n", err, enableErr);
+      return false;
+    }
+    
+    _sampleRate = sampleRate;
+    return true;
+  }
+
   /**
    * Check if driver is initialized
    * 
@@ -0,0 +1,123 @@
+/**
+ * LatencyHistogram.h
+ *
+ * Power-of-two bucketed histogram of durations in microseconds. Bucket 0
+ * holds 0 us, bucket k holds [2^(k-1), 2^k) us, the last bucket everything
+ * above. One task records, any task may read; a reset requested from another
+ * task is carried out by the recording task on its next sample, so the
+ * counters never need a lock. Pure integer logic, usable on the host.
+ */
+
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <stdint.h>
+
+// ========== LatencyHistogram Class ==========
+class LatencyHistogram {
+public:
+  static const int NUM_BUCKETS = 18;  // Up to 2^16 us (65 ms), then overflow
+
+  /**
+   * Constructor - empty
+   */
+  LatencyHistogram() {
+    clear();
+    _resetRequested = false;
+  }
+
+  /**
+   * Record one duration (recording task only)
+   */
+  void record(uint32_t micros) {
+    if (_resetRequested) {
+      clear();
+      _resetRequested = false;
+    }
+
+    _counts[bucketOf(micros)]++;
+    _count++;
+    _total += micros;
+    if (micros > _max) _max = micros;
+  }
+
+  /**
+   * Empty the histogram before the next record() (any task)
+   */
+  void requestReset() {
+    _resetRequested = true;
+  }
+
+  /**
+   * Get the number of samples in a bucket
+   */
+  uint32_t getBucketCount(int bucket) const {
+    return _counts[bucket];
+  }
+
+  /**
+   * Get the lower edge of a bucket in microseconds
+   */
+  static uint32_t getBucketFloor(int bucket) {
+    return (bucket == 0) ? 0 : (1u << (bucket - 1));
+  }
+
+  uint32_t getCount() const {
+    return _count;
+  }
+
+  uint32_t getMax() const {
+    return _max;
+  }
+
+  uint32_t getMean() const {
+    uint32_t count = _count;
+    return (count == 0) ? 0 : (uint32_t)(_total / count);
+  }
+
+  /**
+   * Approximate percentile
+   * @param percent 0-100
+   * @return Upper edge of the bucket holding that percentile (us)
+   */
+  uint32_t getPercentile(int percent) const {
+    uint32_t count = _count;
+    if (count == 0) {
+      return 0;
+    }
+    uint64_t target = ((uint64_t)count * percent + 99) / 100;
+    uint64_t seen = 0;
+    for (int i = 0; i < NUM_BUCKETS; i++) {
+      seen += _counts[i];
+      if (seen >= target) {
+        return (i == NUM_BUCKETS - 1) ? _max : getBucketFloor(i + 1);
+      }
+    }
+    return _max;
+  }
+
+private:
+  volatile uint32_t _counts[NUM_BUCKETS];
+  volatile uint32_t _count;
+  volatile uint64_t _total;
+  volatile uint32_t _max;
+  volatile bool _resetRequested;
+
+  void clear() {
+    for (int i = 0; i < NUM_BUCKETS; i++) _counts[i] = 0;
+    _count = 0;
+    _total = 0;
+    _max = 0;
+  }
+
+  static int bucketOf(uint32_t micros) {
+    int bucket = 0;
+    while (micros != 0 && bucket < NUM_BUCKETS - 1) {
+      micros >>= 1;
+      bucket++;
+    }
+    return bucket;
+  }
+};
+
+#endif // LATENCYHISTOGRAM_H
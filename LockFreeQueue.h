@@ -0,0 +1,117 @@
+/**
+ * LockFreeQueue.h
+ * 
+ * Bounded lock-free queue of small messages. Any number of producers
+ * (tasks on either core, or interrupt handlers) may push; one consumer pops.
+ * Each slot carries a sequence number, so producers claim slots with a single
+ * compare-and-swap and the consumer never waits on a lock or a semaphore.
+ */
+
+#ifndef LOCKFREEQUEUE_H
+#define LOCKFREEQUEUE_H
+
+#include <Arduino.h>
+#include <atomic>
+
+// ========== LockFreeQueue Class ==========
+template <typename T, int CAPACITY>
+class LockFreeQueue {
+  static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0,
+                "Queue capacity must be a power of two");
+
+public:
+  /**
+   * Constructor - starts empty
+   */
+  LockFreeQueue() : enqueuePos(0), dequeuePos(0), droppedCount(0) {
+    for (int i = 0; i < CAPACITY; i++) {
+      cells[i].sequence.store((uint32_t)i, std::memory_order_relaxed);
+    }
+  }
+
+  // ----- Producer side (any task or ISR) -----
+
+  /**
+   * Append a message; never blocks
+   * @param item Message to copy into the queue
+   * @return true if queued, false if the queue was full (message dropped)
+   */
+  bool IRAM_ATTR push(const T& item) {
+    uint32_t pos = enqueuePos.load(std::memory_order_relaxed);
+    
+    while (true) {
+      Cell& cell = cells[pos & MASK];
+      uint32_t seq = cell.sequence.load(std::memory_order_acquire);
+      int32_t diff = (int32_t)(seq - pos);
+      
+      if (diff == 0) {
+        // Slot is free for this position - try to claim it
+        if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          cell.data = item;
+          cell.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        // Consumer has not freed this slot yet - queue is full
+        droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      } else {
+        // Another producer claimed this position first
+        pos = enqueuePos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // ----- Consumer side (one task only) -----
+
+  /**
+   * Remove the oldest message
+   * @param item Receives the message
+   * @return true if a message was read, false if the queue was empty
+   */
+  bool pop(T& item) {
+    uint32_t pos = dequeuePos.load(std::memory_order_relaxed);
+    Cell& cell = cells[pos & MASK];
+    uint32_t seq = cell.sequence.load(std::memory_order_acquire);
+    
+    if ((int32_t)(seq - (pos + 1)) < 0) {
+      return false;  // Empty, or the producer has not finished writing
+    }
+    
+    item = cell.data;
+    cell.sequence.store(pos + CAPACITY, std::memory_order_release);
+    dequeuePos.store(pos + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /**
+   * Check whether a message is ready to pop (consumer side)
+   */
+  bool isEmpty() const {
+    uint32_t pos = dequeuePos.load(std::memory_order_relaxed);
+    uint32_t seq = cells[pos & MASK].sequence.load(std::memory_order_acquire);
+    return (int32_t)(seq - (pos + 1)) < 0;
+  }
+
+  /**
+   * Get the number of messages dropped because the queue was full
+   */
+  uint32_t getDroppedCount() const {
+    return droppedCount.load(std::memory_order_relaxed);
+  }
+
+private:
+  static const uint32_t MASK = CAPACITY - 1;
+
+  struct Cell {
+    std::atomic<uint32_t> sequence;  // pos: free, pos+1: full, pos+CAPACITY: free next lap
+    T data;
+  };
+
+  Cell cells[CAPACITY];
+  std::atomic<uint32_t> enqueuePos;  // Next position producers claim
+  std::atomic<uint32_t> dequeuePos;  // Next position the consumer reads
+  std::atomic<uint32_t> droppedCount;  // Producers on both cores may drop at once
+};
+
+#endif // LOCKFREEQUEUE_H
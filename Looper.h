@@ -0,0 +1,311 @@
+/**
+ * Looper.h
+ *
+ * Loop recorder on the output bus. The first take is copied into a large
+ * region (PSRAM on the ESP32, heap on a host build) and sets the loop
+ * length; from then on the loop is mixed back into every buffer, and while
+ * overdubbing the mixed buffer, which is exactly old loop + new playing, is
+ * copied back over the loop. Buffers are stored as the interleaved stereo
+ * frames I2S plays, so recording and overdubbing are one or two block
+ * memcpy()s (two when the block crosses the loop end) and mixing is a
+ * branch-free saturating add. Only the audio task calls process().
+ *
+ * The loop can be exported as a 16-bit stereo WAV; exportWav() reads the
+ * region, so the caller only exports while nothing is being written. The
+ * file goes out in framed, CRC-32 checked chunks, each in one write(), so
+ * log lines other tasks print meanwhile fall between frames where the
+ * receiver (tools/receive_wav.py) can skip them instead of saving them.
+ */
+
+#ifndef LOOPER_H
+#define LOOPER_H
+
+#include <Arduino.h>
+#if __has_include("esp_heap_caps.h")
+#include "esp_heap_caps.h"
+#define LOOPER_HAS_PSRAM 1
+#else
+#define LOOPER_HAS_PSRAM 0
+#endif
+
+// ========== Looper States ==========
+// Also the commands: the audio task moves the looper to the requested state
+enum LooperState {
+  LOOPER_EMPTY = 0,     // No loop (command: clear)
+  LOOPER_RECORDING,     // First take, the loop grows
+  LOOPER_PLAYING,       // Loop mixed into the output
+  LOOPER_OVERDUBBING,   // Playing, and the output is written back
+  LOOPER_STOPPED        // Loop kept, not played
+};
+
+// ========== Looper Class ==========
+class Looper {
+public:
+  static const int CHANNELS = 2;
+
+  // Export frame: magic, chunk index (u16), payload length (u16), payload,
+  // CRC-32 of index + length + payload (u32), all little-endian. The magic
+  // is not ASCII, so it never occurs in log text.
+  static constexpr uint8_t EXPORT_MAGIC[4] = {0xA5, 0x5A, 'W', 'V'};
+  static const int EXPORT_CHUNK_BYTES = 512;
+  static const int EXPORT_FRAME_OVERHEAD = 4 + 2 + 2 + 4;
+
+  /**
+   * Constructor - no region until begin()
+   */
+  Looper() : _region(nullptr), _capacity(0), _length(0), _position(0),
+             _sampleRate(0), _state(LOOPER_EMPTY), _inPsram(false) {}
+
+  ~Looper() {
+    free(_region);
+  }
+
+  /**
+   * Allocate the loop region
+   * @param seconds Longest loop at maxSampleRate
+   * @param maxSampleRate Highest engine rate (the region is sized for it)
+   * @return false if the memory is not available (the looper stays off)
+   */
+  bool begin(uint32_t seconds, uint32_t maxSampleRate) {
+    _capacity = seconds * maxSampleRate;
+    size_t bytes = (size_t)_capacity * CHANNELS * sizeof(int16_t);
+#if LOOPER_HAS_PSRAM
+    _region = (int16_t*)heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    _inPsram = (_region != nullptr);
+#else
+    _region = (int16_t*)malloc(bytes);  // Host build: same size on the heap
+#endif
+    if (_region == nullptr) {
+      _capacity = 0;
+      Serial.printf("Looper: %u bytes not available, looper off\n", (unsigned)bytes);
+      return false;
+    }
+    Serial.printf("Looper: %u s at %u Hz (%u bytes%s)\n", (unsigned)seconds, (unsigned)maxSampleRate,
+                  (unsigned)bytes, _inPsram ? " in PSRAM" : "");
+    return true;
+  }
+
+  /**
+   * Move to a state (audio task only, between buffers)
+   * Recording again discards the loop; playing, overdubbing or stopping
+   * during the first take closes the loop at the current length
+   * @param sampleRate Rate of the frames passed to process()
+   */
+  void setState(LooperState target, uint32_t sampleRate) {
+    if (_region == nullptr) {
+      return;
+    }
+    switch (target) {
+      case LOOPER_EMPTY:
+        _length = 0;
+        _position = 0;
+        _state = LOOPER_EMPTY;
+        break;
+
+      case LOOPER_RECORDING:
+        _length = 0;
+        _position = 0;
+        _sampleRate = sampleRate;
+        _state = LOOPER_RECORDING;
+        break;
+
+      case LOOPER_PLAYING:
+      case LOOPER_OVERDUBBING:
+      case LOOPER_STOPPED:
+        if (_state == LOOPER_RECORDING || _state == LOOPER_STOPPED) {
+          _position = 0;  // Loop starts where the take started
+        }
+        _state = (_length > 0) ? target : LOOPER_EMPTY;
+        break;
+    }
+  }
+
+  LooperState getState() const {
+    return _state;
+  }
+
+  /**
+   * Record, mix or overdub one buffer of interleaved stereo frames in place
+   * @return true if the buffer now carries loop audio
+   */
+  bool process(int16_t* bus, uint32_t frames) {
+    switch (_state) {
+      case LOOPER_RECORDING: {
+        uint32_t count = min(frames, _capacity - _length);
+        memcpy(&_region[_length * CHANNELS], bus, count * CHANNELS * sizeof(int16_t));
+        _length += count;
+        if (_length == _capacity) {
+          _position = 0;
+          _state = LOOPER_PLAYING;  // Region full: the take becomes the loop
+        }
+        return false;
+      }
+
+      case LOOPER_PLAYING:
+      case LOOPER_OVERDUBBING:
+        while (frames > 0) {
+          uint32_t count = min(frames, _length - _position);
+          int16_t* loop = &_region[_position * CHANNELS];
+          mix(bus, loop, count * CHANNELS);
+          if (_state == LOOPER_OVERDUBBING) {
+            memcpy(loop, bus, count * CHANNELS * sizeof(int16_t));  // Bus is now old + new
+          }
+          _position += count;
+          if (_position == _length) {
+            _position = 0;
+          }
+          bus += count * CHANNELS;
+          frames -= count;
+        }
+        return true;
+
+      default:
+        return false;
+    }
+  }
+
+  /**
+   * Clear the loop if it was recorded at another rate (it would play at the
+   * wrong speed); call after a sample rate change
+   */
+  void setSampleRate(uint32_t sampleRate) {
+    if (_state != LOOPER_EMPTY && sampleRate != _sampleRate) {
+      setState(LOOPER_EMPTY, sampleRate);
+    }
+  }
+
+  uint32_t getLengthFrames() const {
+    return _length;
+  }
+
+  uint32_t getCapacityFrames() const {
+    return _capacity;
+  }
+
+  uint32_t getSampleRate() const {
+    return _sampleRate;
+  }
+
+  bool isInPsram() const {
+    return _inPsram;
+  }
+
+  /**
+   * Write the loop as a 16-bit stereo WAV file in export frames
+   * Call only while the loop is not being written (playing or stopped)
+   * @param out Destination stream (e.g. Serial)
+   * @return WAV bytes written, frame overhead excluded (0 if there is no loop)
+   */
+  size_t exportWav(Print& out) const {
+    if (_length == 0 || _state == LOOPER_RECORDING || _state == LOOPER_OVERDUBBING) {
+      return 0;
+    }
+    uint32_t dataBytes = _length * CHANNELS * sizeof(int16_t);
+    uint8_t header[44];
+    memcpy(header, "RIFF", 4);
+    putLe32(&header[4], 36 + dataBytes);
+    memcpy(&header[8], "WAVEfmt ", 8);
+    putLe32(&header[16], 16);                                      // fmt chunk size
+    putLe16(&header[20], 1);                                       // PCM
+    putLe16(&header[22], CHANNELS);
+    putLe32(&header[24], _sampleRate);
+    putLe32(&header[28], _sampleRate * CHANNELS * sizeof(int16_t));  // Byte rate
+    putLe16(&header[32], CHANNELS * sizeof(int16_t));                // Block align
+    putLe16(&header[34], 16);                                      // Bits per sample
+    memcpy(&header[36], "data", 4);
+    putLe32(&header[40], dataBytes);
+
+    // The file is the header followed by the region (little-endian, like WAV)
+    uint32_t total = sizeof(header) + dataBytes;
+    const uint8_t* data = (const uint8_t*)_region;
+    uint8_t frame[EXPORT_FRAME_OVERHEAD + EXPORT_CHUNK_BYTES];
+    size_t written = 0;
+    for (uint32_t offset = 0, index = 0; offset < total; offset += EXPORT_CHUNK_BYTES, index++) {
+      uint16_t length = (uint16_t)min((uint32_t)EXPORT_CHUNK_BYTES, total - offset);
+      memcpy(frame, EXPORT_MAGIC, 4);
+      putLe16(&frame[4], (uint16_t)index);
+      putLe16(&frame[6], length);
+      for (uint16_t i = 0; i < length; i++) {
+        uint32_t at = offset + i;
+        frame[8 + i] = (at < sizeof(header)) ? header[at] : data[at - sizeof(header)];
+      }
+      putLe32(&frame[8 + length], crc32(&frame[4], 4 + length));
+      size_t sent = out.write(frame, EXPORT_FRAME_OVERHEAD + length);  // One write: atomic on the port
+      if (sent != (size_t)(EXPORT_FRAME_OVERHEAD + length)) {
+        break;
+      }
+      written += length;
+    }
+    return written;
+  }
+
+  /**
+   * Number of frames exportWav() sends, 0 if there is no loop
+   */
+  uint32_t getExportChunks() const {
+    return (getWavBytes() + EXPORT_CHUNK_BYTES - 1) / EXPORT_CHUNK_BYTES;
+  }
+
+  /**
+   * CRC-32 (IEEE 802.3, as zlib.crc32), bitwise: no table, and far faster than the port
+   */
+  static uint32_t crc32(const uint8_t* data, size_t length) {
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < length; i++) {
+      crc ^= data[i];
+      for (int bit = 0; bit < 8; bit++) {
+        crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+      }
+    }
+    return ~crc;
+  }
+
+  /**
+   * Size exportWav() will write (header included), 0 if there is no loop
+   */
+  uint32_t getWavBytes() const {
+    return (_length == 0) ? 0 : 44 + _length * CHANNELS * sizeof(int16_t);
+  }
+
+  static const char* getStateName(LooperState state) {
+    switch (state) {
+      case LOOPER_EMPTY:       return "empty";
+      case LOOPER_RECORDING:   return "recording";
+      case LOOPER_PLAYING:     return "playing";
+      case LOOPER_OVERDUBBING: return "overdubbing";
+      case LOOPER_STOPPED:     return "stopped";
+      default:                 return "???";
+    }
+  }
+
+private:
+  int16_t* _region;
+  uint32_t _capacity;    // Frames
+  uint32_t _length;      // Loop length in frames (grows while recording)
+  uint32_t _position;    // Next frame to play
+  uint32_t _sampleRate;  // Rate the loop was recorded at
+  volatile LooperState _state;
+  bool _inPsram;
+
+  /**
+   * Saturating add of the loop into the bus (min/max, no branches)
+   */
+  static void mix(int16_t* bus, const int16_t* loop, uint32_t samples) {
+    for (uint32_t i = 0; i < samples; i++) {
+      int32_t sum = (int32_t)bus[i] + loop[i];
+      bus[i] = (int16_t)constrain(sum, -32768, 32767);
+    }
+  }
+
+  static void putLe16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+  }
+
+  static void putLe32(uint8_t* p, uint32_t v) {
+    putLe16(p, (uint16_t)v);
+    putLe16(p + 2, (uint16_t)(v >> 16));
+  }
+};
+
+#endif // LOOPER_H
@@ -0,0 +1,88 @@
+/**
+ * MenuBuilder.h
+ * 
+ * constexpr factory functions for MenuItem nodes, so a whole menu tree can be
+ * written as nested constant arrays and placed in flash at compile time:
+ * 
+ *   constexpr MenuItem WAVE_ITEMS[] = {
+ *     MenuBuilder::choice("Sawtooth", PARAM_WAVEFORM, OSC_SAWTOOTH),
+ *     MenuBuilder::choice("Sine", PARAM_WAVEFORM, OSC_SINE)
+ *   };
+ *   constexpr MenuItem ROOT_ITEMS[] = {
+ *     MenuBuilder::submenu("WAVEFORM", WAVE_ITEMS),
+ *     MenuBuilder::exit()
+ *   };
+ *   constexpr MenuItem ROOT = MenuBuilder::submenu("MENU", ROOT_ITEMS);
+ */
+
+#ifndef MENUBUILDER_H
+#define MENUBUILDER_H
+
+#include <Arduino.h>
+#include "MenuItem.h"
+
+// ========== MenuBuilder Class ==========
+class MenuBuilder {
+public:
+  static const int MAX_CHILDREN = 255;
+
+  /**
+   * Submenu node (child count is taken from the array)
+   * @param label Menu title and list text
+   * @param children Constant array of child items
+   */
+  template <size_t N>
+  static constexpr MenuItem submenu(const char* label, const MenuItem (&children)[N]) {
+    static_assert(N > 0 && N <= MAX_CHILDREN, "Submenu needs 1-255 children");
+    return MenuItem{label, MENU_SUBMENU, PARAM_NONE, 0, 0, nullptr, children, (uint8_t)N, PARAM_NONE, 0};
+  }
+
+  /**
+   * Submenu node that is only listed while a parameter has a given value
+   * @param label Menu title and list text
+   * @param children Constant array of child items
+   * @param visibleParam Parameter to test
+   * @param visibleValue Value that makes the item visible
+   */
+  template <size_t N>
+  static constexpr MenuItem submenuIf(const char* label, const MenuItem (&children)[N],
+                                      ParamId visibleParam, int visibleValue) {
+    static_assert(N > 0 && N <= MAX_CHILDREN, "Submenu needs 1-255 children");
+    return MenuItem{label, MENU_SUBMENU, PARAM_NONE, 0, 0, nullptr, children, (uint8_t)N,
+                    visibleParam, (int16_t)visibleValue};
+  }
+
+  /**
+   * One option of a multiple choice parameter
+   * @param label List text
+   * @param param Parameter written when selected
+   * @param value Value written when selected
+   */
+  static constexpr MenuItem choice(const char* label, ParamId param, int value) {
+    return MenuItem{label, MENU_CHOICE, param, (int16_t)value, 0, nullptr, nullptr, 0, PARAM_NONE, 0};
+  }
+
+  /**
+   * Numeric parameter edited in steps of one
+   * @param label List text
+   * @param param Parameter to edit
+   * @param minValue Lowest value
+   * @param maxValue Highest value
+   * @param format printf format for one int (e.g. "x%d", "%d c")
+   */
+  static constexpr MenuItem value(const char* label, ParamId param, int minValue, int maxValue,
+                                  const char* format) {
+    return MenuItem{label, MENU_VALUE, param, (int16_t)minValue, (int16_t)maxValue, format,
+                    nullptr, 0, PARAM_NONE, 0};
+  }
+
+  /**
+   * Item that closes the menu
+   * @param label List text (default: "EXIT")
+   */
+  static constexpr MenuItem exit(const char* label = "EXIT") {
+    return MenuItem{label, MENU_EXIT, PARAM_NONE, 0, 0, nullptr, nullptr, 0, PARAM_NONE, 0};
+  }
+};
+
+#endif // MENUBUILDER_H
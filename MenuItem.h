@@ -0,0 +1,37 @@
+/**
+ * MenuItem.h
+ * 
+ * Menu tree node. Trees are plain constant data (see MenuBuilder.h): every
+ * node lives in flash, children are referenced by pointer and count, and
+ * nothing is allocated at runtime.
+ */
+
+#ifndef MENUITEM_H
+#define MENUITEM_H
+
+#include <Arduino.h>
+#include "SynthParams.h"
+
+// ========== Menu Item Types ==========
+enum MenuItemType : uint8_t {
+  MENU_SUBMENU,  // Opens the child list
+  MENU_CHOICE,   // Selecting writes 'value' to 'param' (shows a filled dot when active)
+  MENU_VALUE,    // Opens an editor for 'param' in [value, maxValue]
+  MENU_EXIT      // Closes the menu
+};
+
+// ========== Menu Item Structure ==========
+struct MenuItem {
+  const char* label;         // Text shown in the list (and breadcrumb)
+  MenuItemType type;
+  ParamId param;             // Parameter for CHOICE / VALUE items
+  int16_t value;             // CHOICE: value written; VALUE: minimum
+  int16_t maxValue;          // VALUE: maximum
+  const char* format;        // VALUE: printf format for the value (e.g. "%d c")
+  const MenuItem* children;  // SUBMENU: child items
+  uint8_t numChildren;
+  ParamId visibleParam;      // Shown only while visibleParam == visibleValue
+  int16_t visibleValue;      // (PARAM_NONE = always shown)
+};
+
+#endif // MENUITEM_H
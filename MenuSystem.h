@@ -0,0 +1,555 @@
+/*
+ * MenuSystem.h - Menu navigation and rendering for OLED displays
+ * 
+ * Walks a constant MenuItem tree (see MenuBuilder.h). Input from buttons and
+ * the dial is queued lock-free and processed in the display task, which owns
+ * all navigation state. Each screen is drawn once into a cached framebuffer;
+ * input afterwards only moves the highlight bar or redraws the edited value.
+ */
+
+#ifndef MENU_SYSTEM_H
+#define MENU_SYSTEM_H
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+#include <Adafruit_SSD1306.h>
+#include "MenuItem.h"
+#include "LockFreeQueue.h"
+
+// ========== Menu Input Events ==========
+enum MenuInput : uint8_t {
+  MENU_INPUT_OPEN,    // Open at the root (ignored while open)
+  MENU_INPUT_NEXT,    // Cursor down / value up
+  MENU_INPUT_PREV,    // Cursor up / value down
+  MENU_INPUT_SELECT,  // Enter submenu, apply choice, start or confirm edit
+  MENU_INPUT_BACK,    // Cancel edit, go to parent, or close at the root
+  MENU_INPUT_EXIT     // Close the menu from anywhere
+};
+
+/**
+ * MenuSystem - Navigation controller and cached renderer
+ * 
+ * Features:
+ * - No heap: fixed navigation stack, visible-item table and screen cache
+ * - O(1) cursor moves; the visible list is rebuilt only when a screen opens
+ * - Items can hide themselves based on a parameter (e.g. CHORD menu only in chord mode)
+ * - Static screen content is rendered once and cached (1 KB, page layout)
+ * - Per input, only the highlight row, position counter or edited value changes,
+ *   so the OLED's partial update sends just those pages
+ * - Values are read and written through callbacks; writes are expected to go to
+ *   a lock-free channel so menu handling never blocks the audio task
+ */
+class MenuSystem {
+public:
+  static const int MAX_DEPTH = 4;          // Root plus three submenu levels
+  static const int MAX_ITEMS = 32;         // Visible items per screen
+  static const int CACHE_BYTES = 128 * 64 / 8;
+  static const int FIRST_ROW_PAGE = 2;     // Page 0 = title, page 1 = separator
+  static const int DIAL_STEP = 256;        // ADC counts per navigation step
+
+  // Parameter access supplied by the application
+  typedef int (*ValueGetter)(ParamId param);
+  typedef void (*ValueSetter)(ParamId param, int value);
+
+  /**
+   * Constructor
+   */
+  MenuSystem() :
+    _display(nullptr),
+    _root(nullptr),
+    _getValue(nullptr),
+    _setValue(nullptr),
+    _open(false),
+    _depth(0),
+    _numVisible(0),
+    _cursor(0),
+    _scrollTop(0),
+    _isEditing(false),
+    _editValue(0),
+    _editOriginal(0),
+    _cacheDirty(true),
+    _dialReference(0),
+    _dialValid(false) {
+  }
+
+  /**
+   * Initialize with display, menu tree and parameter callbacks
+   * 
+   * @param display Pointer to Adafruit_SSD1306 display object
+   * @param root Root submenu item
+   * @param getValue Returns the current value of a parameter
+   * @param setValue Applies a new parameter value (called from the display task)
+   */
+  void init(Adafruit_SSD1306* display, const MenuItem* root,
+            ValueGetter getValue, ValueSetter setValue) {
+    _display = display;
+    _root = root;
+    _getValue = getValue;
+    _setValue = setValue;
+  }
+
+  // ----- Input side (loop task, ISRs) -----
+
+  /**
+   * Queue an input event for the display task; never blocks
+   * 
+   * @return false if the input queue was full
+   */
+  bool postInput(MenuInput input) {
+    return _inputs.push(input);
+  }
+
+  /**
+   * Feed the navigation dial (call from one task only)
+   * Each DIAL_STEP of travel posts one NEXT or PREV; the reference moves by
+   * whole steps, so noise around a step boundary cannot chatter
+   * 
+   * @param adcValue Smoothed dial reading (0-4095)
+   */
+  void onDial(int adcValue) {
+    if (!_open) {
+      _dialValid = false;  // Re-anchor when the menu opens
+      return;
+    }
+    
+    if (!_dialValid) {
+      _dialReference = adcValue;
+      _dialValid = true;
+      return;
+    }
+    
+    while (adcValue - _dialReference >= DIAL_STEP) {
+      _dialReference += DIAL_STEP;
+      postInput(MENU_INPUT_NEXT);
+    }
+    while (_dialReference - adcValue >= DIAL_STEP) {
+      _dialReference -= DIAL_STEP;
+      postInput(MENU_INPUT_PREV);
+    }
+  }
+
+  /**
+   * Check if the menu is on screen
+   */
+  bool isOpen() const {
+    return _open;
+  }
+
+  /**
+   * Check if input is waiting to be processed (display task)
+   */
+  bool hasPendingInput() const {
+    return !_inputs.isEmpty();
+  }
+
+  // ----- Display task -----
+
+  /**
+   * Process queued input and, if open, render into the display buffer
+   * Does not push the frame - the caller sends it with its normal update
+   * 
+   * @return true if the menu is open (and was drawn)
+   */
+  bool update() {
+    MenuInput input;
+    while (_inputs.pop(input)) {
+      handleInput(input);
+    }
+    
+    if (!_open || _display == nullptr) {
+      return false;
+    }
+    
+    render();
+    return true;
+  }
+
+  /**
+   * Force the cached screen to be rebuilt (e.g. after a value changed elsewhere)
+   */
+  void invalidate() {
+    _cacheDirty = true;
+  }
+
+private:
+  struct Level {
+    const MenuItem* menu;  // Submenu shown at this level
+    uint8_t selected;      // Child index of the highlighted item
+  };
+
+  Adafruit_SSD1306* _display;
+  const MenuItem* _root;
+  ValueGetter _getValue;
+  ValueSetter _setValue;
+  volatile bool _open;
+
+  // Input events (any producer -> display task)
+  LockFreeQueue<MenuInput, 16> _inputs;
+
+  // Navigation state (display task only)
+  Level _stack[MAX_DEPTH];
+  int _depth;
+  uint8_t _visible[MAX_ITEMS];  // Child indices of the visible items
+  int _numVisible;
+  int _cursor;                  // Position in _visible
+  int _scrollTop;               // First visible row
+
+  // Value editor
+  bool _isEditing;
+  int _editValue;
+  int _editOriginal;
+
+  // Static layer of the current screen (page layout, like the display buffer)
+  bool _cacheDirty;
+  uint8_t _cache[CACHE_BYTES];
+
+  // Dial detents (input task only)
+  int _dialReference;
+  bool _dialValid;
+
+  const MenuItem* currentMenu() const {
+    return _stack[_depth].menu;
+  }
+
+  const MenuItem* currentItem() const {
+    if (_numVisible == 0) return nullptr;
+    return &currentMenu()->children[_visible[_cursor]];
+  }
+
+  int getValue(ParamId param) const {
+    return (_getValue != nullptr) ? _getValue(param) : 0;
+  }
+
+  void setValue(ParamId param, int value) {
+    if (_setValue != nullptr) {
+      _setValue(param, value);
+    }
+  }
+
+  int rowsOnScreen() const {
+    return _display->height() / 8 - FIRST_ROW_PAGE;
+  }
+
+  /**
+   * Apply one input event to the navigation state
+   */
+  void handleInput(MenuInput input) {
+    if (input == MENU_INPUT_OPEN) {
+      if (!_open && _root != nullptr) {
+        _depth = 0;
+        _stack[0].menu = _root;
+        _stack[0].selected = 0;
+        _isEditing = false;
+        rebuildVisible();
+        _open = true;
+      }
+      return;
+    }
+    
+    if (!_open) {
+      return;
+    }
+    
+    switch (input) {
+      case MENU_INPUT_NEXT:
+      case MENU_INPUT_PREV:
+        step(input == MENU_INPUT_NEXT ? 1 : -1);
+        break;
+      case MENU_INPUT_SELECT:
+        select();
+        break;
+      case MENU_INPUT_BACK:
+        back();
+        break;
+      case MENU_INPUT_EXIT:
+        close();
+        break;
+      default:
+        break;
+    }
+  }
+
+  /**
+   * Move the cursor, or change the edited value (applied live)
+   */
+  void step(int direction) {
+    if (_isEditing) {
+      const MenuItem* item = currentItem();
+      int newValue = constrain(_editValue + direction, (int)item->value, (int)item->maxValue);
+      if (newValue != _editValue) {
+        _editValue = newValue;
+        setValue(item->param, _editValue);
+      }
+      return;
+    }
+    
+    int newCursor = constrain(_cursor + direction, 0, max(_numVisible - 1, 0));
+    if (newCursor == _cursor) {
+      return;
+    }
+    _cursor = newCursor;
+    _stack[_depth].selected = _visible[_cursor];
+    
+    // Scrolling changes the static layer; a plain cursor move does not
+    int rows = rowsOnScreen();
+    if (_cursor < _scrollTop) {
+      _scrollTop = _cursor;
+      _cacheDirty = true;
+    } else if (_cursor >= _scrollTop + rows) {
+      _scrollTop = _cursor - rows + 1;
+      _cacheDirty = true;
+    }
+  }
+
+  /**
+   * Act on the highlighted item
+   */
+  void select() {
+    const MenuItem* item = currentItem();
+    if (item == nullptr) {
+      return;
+    }
+    
+    if (_isEditing) {
+      _isEditing = false;  // Value is already applied - just confirm
+      _cacheDirty = true;
+      return;
+    }
+    
+    switch (item->type) {
+      case MENU_SUBMENU:
+        if (_depth < MAX_DEPTH - 1) {
+          _depth++;
+          _stack[_depth].menu = item;
+          _stack[_depth].selected = 0;
+          rebuildVisible();
+        }
+        break;
+      case MENU_CHOICE:
+        setValue(item->param, item->value);
+        _cacheDirty = true;  // Active dot moves
+        break;
+      case MENU_VALUE:
+        _editOriginal = getValue(item->param);
+        _editValue = _editOriginal;
+        _isEditing = true;
+        _cacheDirty = true;
+        break;
+      case MENU_EXIT:
+        close();
+        break;
+    }
+  }
+
+  /**
+   * Cancel the edit, or return to the parent menu, or close at the root
+   */
+  void back() {
+    if (_isEditing) {
+      const MenuItem* item = currentItem();
+      if (_editValue != _editOriginal) {
+        setValue(item->param, _editOriginal);
+      }
+      _isEditing = false;
+      _cacheDirty = true;
+      return;
+    }
+    
+    if (_depth > 0) {
+      _depth--;
+      rebuildVisible();  // Visibility may have changed (e.g. play mode)
+    } else {
+      close();
+    }
+  }
+
+  void close() {
+    _isEditing = false;
+    _open = false;
+  }
+
+  /**
+   * Rebuild the visible-item table for the current menu
+   * Only runs when a screen is entered, never per cursor move
+   */
+  void rebuildVisible() {
+    const MenuItem* menu = currentMenu();
+    _numVisible = 0;
+    _cursor = 0;
+    
+    for (int i = 0; i < menu->numChildren && _numVisible < MAX_ITEMS; i++) {
+      const MenuItem& child = menu->children[i];
+      if (child.visibleParam != PARAM_NONE && getValue(child.visibleParam) != child.visibleValue) {
+        continue;
+      }
+      if (i == _stack[_depth].selected) {
+        _cursor = _numVisible;
+      }
+      _visible[_numVisible++] = (uint8_t)i;
+    }
+    
+    if (_numVisible > 0) {
+      _stack[_depth].selected = _visible[_cursor];
+    }
+    
+    int rows = rowsOnScreen();
+    _scrollTop = (_cursor >= rows) ? _cursor - rows + 1 : 0;
+    _cacheDirty = true;
+  }
+
+  // ----- Rendering -----
+
+  /**
+   * Restore the cached static layer (rebuilding it if needed), then draw
+   * the parts that change with input
+   */
+  void render() {
+    uint8_t* buffer = _display->getBuffer();
+    int bytes = min((int)(_display->width() * _display->height() / 8), (int)CACHE_BYTES);
+    
+    if (_cacheDirty) {
+      _display->clearDisplay();
+      if (_isEditing) {
+        drawEditorStatic();
+      } else {
+        drawListStatic();
+      }
+      memcpy(_cache, buffer, bytes);
+      _cacheDirty = false;
+    } else {
+      memcpy(buffer, _cache, bytes);
+    }
+    
+    if (_isEditing) {
+      drawEditorValue();
+    } else {
+      drawListCursor();
+    }
+  }
+
+  /**
+   * Title text and separator line
+   */
+  void drawTitle(const char* parent, const char* title) {
+    _display->setTextSize(1);
+    _display->setTextColor(SSD1306_WHITE);
+    _display->setCursor(0, 0);
+    if (parent != nullptr) {
+      _display->print(parent);
+      _display->print(" > ");
+    }
+    _display->print(title);
+    _display->drawFastHLine(0, 10, _display->width(), SSD1306_WHITE);
+  }
+
+  /**
+   * List screen: title and one row of text (plus status) per visible item
+   */
+  void drawListStatic() {
+    const MenuItem* menu = currentMenu();
+    drawTitle(nullptr, menu->label);
+    
+    int width = _display->width();
+    int rows = rowsOnScreen();
+    char text[12];
+    
+    for (int row = 0; row < rows && _scrollTop + row < _numVisible; row++) {
+      const MenuItem& item = menu->children[_visible[_scrollTop + row]];
+      int y = (FIRST_ROW_PAGE + row) * 8;
+      
+      _display->setCursor(2, y);
+      _display->print(item.label);
+      
+      switch (item.type) {
+        case MENU_CHOICE:
+          // Filled dot = active option
+          if (getValue(item.param) == item.value) {
+            _display->fillCircle(width - 6, y + 3, 2, SSD1306_WHITE);
+          } else {
+            _display->drawCircle(width - 6, y + 3, 2, SSD1306_WHITE);
+          }
+          break;
+        case MENU_SUBMENU:
+          _display->setCursor(width - 8, y);
+          _display->print(">");
+          break;
+        case MENU_VALUE:
+          snprintf(text, sizeof(text), item.format, getValue(item.param));
+          _display->setCursor(width - 2 - 6 * (int)strlen(text), y);
+          _display->print(text);
+          break;
+        default:
+          break;
+      }
+    }
+  }
+
+  /**
+   * Position counter and inverted highlight bar over the cursor row
+   */
+  void drawListCursor() {
+    if (_numVisible == 0) {
+      return;
+    }
+    
+    char text[24];  // Room for any two ints, so the format cannot truncate
+    snprintf(text, sizeof(text), "%d/%d", _cursor + 1, _numVisible);
+    int width = _display->width();
+    _display->fillRect(width - 6 * (int)strlen(text) - 2, 0, 6 * (int)strlen(text) + 2, 8, SSD1306_BLACK);
+    _display->setTextSize(1);
+    _display->setCursor(width - 6 * (int)strlen(text), 0);
+    _display->print(text);
+    
+    // Rows are page aligned: inverting one page row is the whole highlight
+    int page = FIRST_ROW_PAGE + (_cursor - _scrollTop);
+    uint8_t* row = _display->getBuffer() + page * width;
+    for (int x = 0; x < width; x++) {
+      row[x] ^= 0xFF;
+    }
+  }
+
+  /**
+   * Editor screen: breadcrumb, range labels and value bar outline
+   */
+  void drawEditorStatic() {
+    const MenuItem* item = currentItem();
+    drawTitle(currentMenu()->label, item->label);
+    
+    int width = _display->width();
+    int height = _display->height();
+    char text[12];
+    
+    _display->drawRect(8, 44, width - 16, 6, SSD1306_WHITE);
+    
+    _display->setTextSize(1);
+    snprintf(text, sizeof(text), item->format, (int)item->value);
+    _display->setCursor(8, height - 8);
+    _display->print(text);
+    snprintf(text, sizeof(text), item->format, (int)item->maxValue);
+    _display->setCursor(width - 8 - 6 * (int)strlen(text), height - 8);
+    _display->print(text);
+  }
+
+  /**
+   * Editor value text and bar fill
+   */
+  void drawEditorValue() {
+    const MenuItem* item = currentItem();
+    int width = _display->width();
+    char text[12];
+    
+    snprintf(text, sizeof(text), item->format, _editValue);
+    _display->setTextSize(2);
+    _display->setCursor((width - 12 * (int)strlen(text)) / 2, 22);
+    _display->print(text);
+    _display->setTextSize(1);
+    
+    int range = item->maxValue - item->value;
+    int fill = (range > 0) ? ((_editValue - item->value) * (width - 20)) / range : 0;
+    if (fill > 0) {
+      _display->fillRect(10, 46, fill, 2, SSD1306_WHITE);
+    }
+  }
+};
+
+#endif // MENU_SYSTEM_H
@@ -0,0 +1,273 @@
+/**
+ * MidiClockSync.h
+ *
+ * Follows an external MIDI clock (24 pulses per quarter note) with a
+ * second-order phase-locked loop. Tick arrival times (in audio samples) are
+ * jittery by a millisecond or so; the loop turns them into a smooth period
+ * and a predicted tick grid, so the sequencer can place steps on the grid
+ * instead of on each noisy arrival. Lock is judged on the averaged phase
+ * error with separate lock and unlock thresholds, so single jittery ticks
+ * never drop it. Transport (start / stop / continue /
+ * song position) is tracked here too. Pure integer logic with no clock or
+ * UART dependency, so recorded clock streams can be replayed on the host.
+ */
+
+#ifndef MIDICLOCKSYNC_H
+#define MIDICLOCKSYNC_H
+
+#include <stdint.h>
+
+// ========== MidiClockSync Class ==========
+class MidiClockSync {
+public:
+  static const int PPQN = 24;
+
+  /**
+   * Constructor - unlocked and stopped
+   */
+  MidiClockSync() {
+    reset();
+  }
+
+  /**
+   * Forget the tempo and transport state
+   */
+  void reset() {
+    _state = STATE_IDLE;
+    _running = false;
+    _tickCount = -1;
+    _locked = false;
+    _trackedTicks = 0;
+    _meanErrorQ8 = 0;
+    _outliers = 0;
+    _periodQ8 = 0;
+    _predictedQ8 = 0;
+    _previousQ8 = 0;
+    _lastInput = 0;
+    _lastTime = 0;
+  }
+
+  // ----- Transport -----
+
+  /**
+   * Start: song position 0, the next clock is tick 0
+   */
+  void onStart() {
+    _running = true;
+    _tickCount = -1;
+  }
+
+  /**
+   * Stop: ticks keep the tempo locked but no longer advance the song
+   */
+  void onStop() {
+    _running = false;
+  }
+
+  /**
+   * Continue from the current song position
+   */
+  void onContinue() {
+    _running = true;
+  }
+
+  /**
+   * Song position pointer
+   * @param sixteenths Position in MIDI beats (sixteenth notes, 6 ticks each)
+   */
+  void onSongPosition(uint16_t sixteenths) {
+    _tickCount = (int32_t)sixteenths * 6 - 1;  // Next clock plays this position
+  }
+
+  // ----- Clock -----
+
+  /**
+   * Feed one clock pulse
+   * @param sampleTime Arrival time in audio samples (may wrap)
+   */
+  void onClock(uint32_t sampleTime) {
+    int64_t t = unwrap(sampleTime);
+    int64_t tQ8 = t << 8;
+
+    if (_running) {
+      _tickCount++;
+    }
+
+    switch (_state) {
+      case STATE_IDLE:
+        _state = STATE_FIRST_TICK;
+        _previousQ8 = tQ8;
+        return;
+
+      case STATE_FIRST_TICK:
+        acquire(tQ8, (int32_t)(tQ8 - _previousQ8));
+        return;
+
+      default:
+        break;
+    }
+
+    int32_t errorQ8 = (int32_t)(tQ8 - _predictedQ8);
+    int32_t intervalQ8 = (int32_t)(tQ8 - _previousQ8);
+    int32_t limit = _periodQ8 / 2;
+
+    if (errorQ8 > limit || errorQ8 < -limit) {
+      // Far off the grid: a dropped tick or a tempo jump - re-acquire if it persists
+      // (until then the lock stands and the grid runs on by itself)
+      if (++_outliers >= MAX_OUTLIERS) {
+        acquire(tQ8, intervalQ8);
+      } else {
+        _predictedQ8 += _periodQ8;
+      }
+      _previousQ8 = tQ8;
+      return;
+    }
+
+    // Loop filter: proportional term corrects phase, integral term tempo
+    // (gains 1/4 and 1/64 give a critically damped loop). The error is
+    // clamped to 1/8 of a tick first, so one tick read late (the receive
+    // task was held off) cannot drag the grid by more than jitter would
+    _outliers = 0;
+    int32_t stepLimit = _periodQ8 / STEP_DIV;
+    int32_t stepQ8 = (errorQ8 > stepLimit) ? stepLimit : (errorQ8 < -stepLimit) ? -stepLimit : errorQ8;
+    _periodQ8 += stepQ8 / INTEGRAL_DIV;
+    _predictedQ8 += _periodQ8 + stepQ8 / PROPORTIONAL_DIV;
+    _previousQ8 = tQ8;
+
+    // Lock detector: mean absolute phase error (about 8 ticks), with hysteresis
+    int32_t magnitudeQ8 = (errorQ8 < 0) ? -errorQ8 : errorQ8;
+    _meanErrorQ8 += (magnitudeQ8 - _meanErrorQ8) / ERROR_AVERAGE_DIV;
+    if (_trackedTicks < PPQN) {
+      _trackedTicks++;
+    }
+    if (_locked) {
+      if (_meanErrorQ8 > _periodQ8 / UNLOCK_DIV) {
+        acquire(tQ8, intervalQ8);  // Lost the grid (tempo change): measure afresh
+      }
+    } else {
+      _locked = (_trackedTicks >= PPQN && _meanErrorQ8 <= _periodQ8 / LOCK_DIV);
+    }
+  }
+
+  // ----- State -----
+
+  /**
+   * Check whether the predicted grid can be trusted
+   * Locks after a beat of tracking once the mean phase error is within
+   * 1/16 of a tick; unlocks only when it grows past 1/8 (and re-acquires)
+   * or after MAX_OUTLIERS ticks in a row far off the grid
+   */
+  bool isLocked() const {
+    return _state == STATE_TRACKING && _locked;
+  }
+
+  /**
+   * Check whether the transport is running (after start / continue)
+   */
+  bool isRunning() const {
+    return _running;
+  }
+
+  /**
+   * Check whether clock pulses are still arriving
+   * @param sampleTime Current time in samples
+   * @param timeoutSamples Silence that counts as clock lost
+   */
+  bool hasClock(uint32_t sampleTime, uint32_t timeoutSamples) const {
+    return _state != STATE_IDLE && (sampleTime - _lastInput) < timeoutSamples;
+  }
+
+  /**
+   * Song position in ticks since start (-1 before the first tick)
+   */
+  int32_t getTickCount() const {
+    return _tickCount;
+  }
+
+  /**
+   * Filtered tick period
+   * @return Samples per tick in Q8 (0 until two ticks have arrived)
+   */
+  int32_t getPeriodQ8() const {
+    return (_state == STATE_TRACKING) ? _periodQ8 : 0;
+  }
+
+  /**
+   * Filtered tempo in tenths of a BPM
+   * @param sampleRate Audio sample rate
+   */
+  int getBpmTenths(uint32_t sampleRate) const {
+    if (_state != STATE_TRACKING || _periodQ8 <= 0) {
+      return 0;
+    }
+    // bpm = sampleRate * 60 / (period * PPQN), period in Q8
+    int64_t numerator = (int64_t)sampleRate * 600 * 256;
+    return (int)((numerator + (int64_t)_periodQ8 * PPQN / 2) / ((int64_t)_periodQ8 * PPQN));
+  }
+
+  /**
+   * Time of a tick on the filtered grid
+   * @param tick Tick number (song position, as getTickCount())
+   * @return Predicted arrival in samples (same time base as onClock)
+   */
+  uint32_t predictTick(int32_t tick) const {
+    // _predictedQ8 is the time of tick _tickCount + 1
+    int64_t q8 = _predictedQ8 + (int64_t)(tick - (_tickCount + 1)) * _periodQ8;
+    return (uint32_t)((q8 + 128) >> 8);
+  }
+
+private:
+  enum State {
+    STATE_IDLE,        // No tick yet
+    STATE_FIRST_TICK,  // One tick seen, period unknown
+    STATE_TRACKING
+  };
+
+  static const int PROPORTIONAL_DIV = 4;
+  static const int INTEGRAL_DIV = 64;
+  static const int STEP_DIV = 8;           // Loop filter input clamped to 1/8 of a tick
+  static const int ERROR_AVERAGE_DIV = 8;  // Lock detector averaging (ticks)
+  static const int LOCK_DIV = 16;          // Lock below 1/16 of a tick mean error
+  static const int UNLOCK_DIV = 8;         // Unlock above 1/8
+  static const int MAX_OUTLIERS = 3;
+
+  State _state;
+  bool _running;
+  int32_t _tickCount;
+  bool _locked;
+  int _trackedTicks;     // Ticks since (re)acquire, up to PPQN
+  int32_t _meanErrorQ8;  // Mean absolute phase error (Q8 samples)
+  int _outliers;
+  int32_t _periodQ8;     // Samples per tick (Q8)
+  int64_t _predictedQ8;  // Expected time of the next tick (Q8, unwrapped)
+  int64_t _previousQ8;   // Time of the last tick (Q8, unwrapped)
+  uint32_t _lastInput;   // Last raw sample time, for unwrapping
+  int64_t _lastTime;     // Last unwrapped sample time
+
+  int64_t unwrap(uint32_t sampleTime) {
+    _lastTime += (int32_t)(sampleTime - _lastInput);
+    _lastInput = sampleTime;
+    return _lastTime;
+  }
+
+  /**
+   * (Re)start tracking from one measured tick interval
+   */
+  void acquire(int64_t tQ8, int32_t intervalQ8) {
+    if (intervalQ8 <= 0) {
+      _state = STATE_FIRST_TICK;
+      _previousQ8 = tQ8;
+      return;
+    }
+    _state = STATE_TRACKING;
+    _periodQ8 = intervalQ8;
+    _predictedQ8 = tQ8 + intervalQ8;
+    _previousQ8 = tQ8;
+    _locked = false;
+    _trackedTicks = 0;
+    _meanErrorQ8 = intervalQ8 / UNLOCK_DIV;  // Pessimistic: lock has to be earned
+    _outliers = 0;
+  }
+};
+
+#endif // MIDICLOCKSYNC_H
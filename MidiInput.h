@@ -0,0 +1,276 @@
+/*
+ * MidiInput.h - MIDI input on a hardware UART
+ *
+ * The ESP-IDF UART driver collects bytes in its interrupt into a ring buffer;
+ * a small task on core 0 blocks on that buffer, timestamps each byte as it is
+ * read, runs it through MidiParser and pushes complete messages to a
+ * lock-free queue for the audio task. Nothing is allocated after begin().
+ *
+ * On a host build the same receiver reads a serial device, pty or FIFO
+ * from a thread instead, so integration tests can write MIDI bytes to the
+ * other end of a pty and read timestamped events from the queue.
+ */
+
+#ifndef MIDI_INPUT_H
+#define MIDI_INPUT_H
+
+#include <Arduino.h>
+#include "MidiParser.h"
+#include "LockFreeQueue.h"
+
+#if __has_include("driver/uart.h")
+#include "driver/uart.h"
+#define MIDI_UART_AVAILABLE 1
+#define MIDI_HOST_PORT 0
+#elif __has_include(<termios.h>)
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#include <thread>
+#define MIDI_UART_AVAILABLE 0
+#define MIDI_HOST_PORT 1
+#else
+#define MIDI_UART_AVAILABLE 0
+#define MIDI_HOST_PORT 0
+#endif
+
+// ========== MIDI Event ==========
+// Message plus arrival time (micros()), so the audio task can place it at the
+// matching sample of the next buffer
+struct MidiEvent {
+  MidiMessage message;
+  uint32_t timeUs;
+};
+
+// MIDI task -> audio task
+typedef LockFreeQueue<MidiEvent, 64> MidiQueue;
+
+#if MIDI_UART_AVAILABLE || MIDI_HOST_PORT
+
+/**
+ * MidiInput - UART receiver feeding a MidiQueue
+ *
+ * Features:
+ * - 31250 baud, 8N1, RX only (TX pin left unassigned)
+ * - Interrupt per received byte (RX FIFO threshold of one), so timestamps
+ *   are within one byte time (320 us) of the wire
+ * - Channel filter (omni or one channel); system messages always pass
+ */
+class MidiInput {
+public:
+  static const int BAUD_RATE = 31250;
+  static const int RX_BUFFER_SIZE = 256;  // Driver ring buffer (bytes)
+
+  /**
+   * Constructor
+   */
+  MidiInput() :
+#if MIDI_UART_AVAILABLE
+    _port(UART_NUM_2),
+#else
+    _fd(-1),
+#endif
+    _queue(nullptr),
+    _channel(0),
+    _isRunning(false),
+    _bytesReceived(0) {
+  }
+
+#if MIDI_UART_AVAILABLE
+  /**
+   * Install the UART driver and start the receive task
+   *
+   * @param port UART to use (not the one Serial is on)
+   * @param rxPin GPIO for MIDI IN (through the usual optocoupler)
+   * @param queue Destination for parsed messages
+   * @param channel 1-16 to accept a single channel, 0 for omni
+   * @param core Core for the receive task
+   * @param priority Receive task priority
+   * @return true if initialization successful, false otherwise
+   */
+  bool begin(uart_port_t port, int rxPin, MidiQueue* queue, int channel,
+             int core, UBaseType_t priority) {
+    _port = port;
+    _queue = queue;
+    _channel = channel;
+
+    uart_config_t config = {};
+    config.baud_rate = BAUD_RATE;
+    config.data_bits = UART_DATA_8_BITS;
+    config.parity = UART_PARITY_DISABLE;
+    config.stop_bits = UART_STOP_BITS_1;
+    config.flow_ctrl = UART_HW_FLOWCTRL_DISABLE;
+    config.source_clk = UART_SCLK_DEFAULT;
+
+    esp_err_t err = uart_driver_install(_port, RX_BUFFER_SIZE, 0, 0, nullptr, 0);
+    if (err == ESP_OK) err = uart_param_config(_port, &config);
+    if (err == ESP_OK) err = uart_set_pin(_port, UART_PIN_NO_CHANGE, rxPin,
+                                          UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
+    if (err == ESP_OK) err = uart_set_rx_full_threshold(_port, 1);
+    if (err != ESP_OK) {
+      Serial.printf("MIDI: Failed to set up UART%d: %d\n", (int)_port, err);
+      return false;
+    }
+
+    _isRunning = true;
+    if (xTaskCreatePinnedToCore(taskEntry, "MidiInput", 2048, this, priority,
+                                nullptr, core) != pdPASS) {
+      Serial.println("MIDI: Failed to create task");
+      _isRunning = false;
+      return false;
+    }
+    return true;
+  }
+#else
+  ~MidiInput() {
+    end();
+  }
+
+  /**
+   * Host stand-in: open a serial device, pty or FIFO and start the receive thread
+   *
+   * @param device Path to read MIDI bytes from (e.g. the slave side of a pty)
+   * @param queue Destination for parsed messages
+   * @param channel 1-16 to accept a single channel, 0 for omni
+   * @return true if the device could be opened
+   */
+  bool begin(const char* device, MidiQueue* queue, int channel) {
+    _queue = queue;
+    _channel = channel;
+
+    _fd = open(device, O_RDONLY | O_NOCTTY | O_NONBLOCK);
+    if (_fd < 0) {
+      Serial.printf("MIDI: Failed to open %s\n", device);
+      return false;
+    }
+    if (isatty(_fd)) {
+      termios raw;
+      tcgetattr(_fd, &raw);
+      cfmakeraw(&raw);  // Bytes as they come: no line editing, no echo
+      tcsetattr(_fd, TCSANOW, &raw);
+    }
+
+    _isRunning = true;
+    _thread = std::thread(taskEntry, this);
+    return true;
+  }
+
+  /**
+   * Stop the receive thread and close the device
+   */
+  void end() {
+    if (_thread.joinable()) {
+      _isRunning = false;
+      _thread.join();
+    }
+    if (_fd >= 0) {
+      close(_fd);
+      _fd = -1;
+    }
+  }
+#endif
+
+  /**
+   * Get the number of bytes received since begin()
+   */
+  uint32_t getBytesReceived() const {
+    return _bytesReceived;
+  }
+
+  /**
+   * Get the number of data bytes dropped for lack of a status byte
+   */
+  uint32_t getStrayBytes() const {
+    return _parser.getStrayBytes();
+  }
+
+private:
+#if MIDI_UART_AVAILABLE
+  uart_port_t _port;
+#else
+  int _fd;
+  std::thread _thread;
+#endif
+  MidiQueue* _queue;
+  int _channel;
+  volatile bool _isRunning;
+  volatile uint32_t _bytesReceived;
+  MidiParser _parser;
+
+  static void taskEntry(void* arg) {
+    ((MidiInput*)arg)->run();
+#if MIDI_UART_AVAILABLE
+    vTaskDelete(nullptr);
+#endif
+  }
+
+  /**
+   * Block until a byte arrives, then take whatever else is already buffered
+   * without waiting for more (the host port wakes every 50 ms to check end())
+   * @return Bytes read, 0 if none
+   */
+  int readBytes(uint8_t* bytes, int size) {
+#if MIDI_UART_AVAILABLE
+    int count = uart_read_bytes(_port, bytes, 1, portMAX_DELAY);
+    size_t waiting = 0;
+    if (count == 1 && uart_get_buffered_data_len(_port, &waiting) == ESP_OK && waiting > 0) {
+      int more = uart_read_bytes(_port, bytes + 1, min((int)waiting, size - 1), 0);
+      count += (more > 0) ? more : 0;
+    }
+    return count;
+#else
+    pollfd request = {_fd, POLLIN, 0};
+    if (poll(&request, 1, 50) <= 0) {
+      return 0;
+    }
+    int count = (int)read(_fd, bytes, size);
+    if (count <= 0) {
+      usleep(1000);  // End of a file, or the pty writer went away: wait for more
+      return 0;
+    }
+    return count;
+#endif
+  }
+
+  /**
+   * Receive task: block until bytes arrive, parse, queue
+   */
+  void run() {
+    uint8_t bytes[16];
+
+    while (_isRunning) {
+      int count = readBytes(bytes, sizeof(bytes));
+      uint32_t now = micros();
+
+      for (int i = 0; i < count; i++) {
+        MidiMessage message;
+        if (!_parser.parse(bytes[i], message) || !accept(message)) {
+          continue;
+        }
+
+        // Bytes read together were all in the buffer by now; when each
+        // arrived is not known, so they share the read time
+        MidiEvent event;
+        event.message = message;
+        event.timeUs = now;
+        _queue->push(event);
+      }
+      _bytesReceived += count > 0 ? count : 0;
+    }
+  }
+
+  /**
+   * Channel filter
+   */
+  bool accept(const MidiMessage& message) const {
+    if (message.status >= 0xF0 || _channel == 0) {
+      return true;
+    }
+    return message.channel() == _channel - 1;
+  }
+};
+
+#endif // MIDI_UART_AVAILABLE || MIDI_HOST_PORT
+
+#endif // MIDI_INPUT_H
@@ -0,0 +1,203 @@
+/**
+ * MidiParser.h
+ *
+ * Byte-at-a-time MIDI 1.0 stream parser. A fixed-size state machine with no
+ * allocation: running status, System Exclusive skipped, real-time bytes
+ * (clock, start, stop, ...) passed through even in the middle of another
+ * message. Pure logic on plain integers - no UART, no clock - so recorded
+ * byte streams can be replayed through it on the host.
+ */
+
+#ifndef MIDIPARSER_H
+#define MIDIPARSER_H
+
+#include <stdint.h>
+
+// ========== MIDI Message Types ==========
+enum MidiType : uint8_t {
+  // Channel voice messages (low nibble of the status byte is the channel)
+  MIDI_NOTE_OFF         = 0x80,
+  MIDI_NOTE_ON          = 0x90,
+  MIDI_POLY_PRESSURE    = 0xA0,
+  MIDI_CONTROL_CHANGE   = 0xB0,
+  MIDI_PROGRAM_CHANGE   = 0xC0,
+  MIDI_CHANNEL_PRESSURE = 0xD0,
+  MIDI_PITCH_BEND       = 0xE0,
+
+  // System common
+  MIDI_TIME_CODE        = 0xF1,
+  MIDI_SONG_POSITION    = 0xF2,
+  MIDI_SONG_SELECT      = 0xF3,
+  MIDI_TUNE_REQUEST     = 0xF6,
+
+  // System real-time (single byte, may appear anywhere)
+  MIDI_CLOCK            = 0xF8,
+  MIDI_START            = 0xFA,
+  MIDI_CONTINUE         = 0xFB,
+  MIDI_STOP             = 0xFC,
+  MIDI_ACTIVE_SENSING   = 0xFE,
+  MIDI_SYSTEM_RESET     = 0xFF
+};
+
+// ========== MIDI Message ==========
+struct MidiMessage {
+  uint8_t status;  // Full status byte (type | channel for channel messages)
+  uint8_t data1;   // Note / controller / LSB (0 if unused)
+  uint8_t data2;   // Velocity / value / MSB (0 if unused)
+
+  MidiType type() const {
+    return (MidiType)(status < 0xF0 ? (status & 0xF0) : status);
+  }
+
+  uint8_t channel() const {
+    return status & 0x0F;  // 0-15 (meaningless for system messages)
+  }
+
+  /**
+   * Pitch bend amount
+   * @return -8192 (full down) to +8191 (full up), 0 = centre
+   */
+  int bend() const {
+    return (int)(((uint16_t)data2 << 7) | data1) - 8192;
+  }
+};
+
+// ========== MidiParser Class ==========
+class MidiParser {
+public:
+  /**
+   * Constructor
+   */
+  MidiParser() {
+    reset();
+  }
+
+  /**
+   * Forget any partial message and the running status
+   */
+  void reset() {
+    _status = 0;
+    _expected = 0;
+    _count = 0;
+    _inSysEx = false;
+    _strayBytes = 0;
+  }
+
+  /**
+   * Feed one byte
+   * @param byte Next byte from the wire
+   * @param out Receives the message when one completes
+   * @return true if out holds a complete message
+   */
+  bool parse(uint8_t byte, MidiMessage& out) {
+    // Real-time: one byte, never disturbs the message it interrupts
+    if (byte >= 0xF8) {
+      if (byte == 0xF9 || byte == 0xFD) {
+        return false;  // Undefined
+      }
+      out.status = byte;
+      out.data1 = 0;
+      out.data2 = 0;
+      return true;
+    }
+
+    if (byte & 0x80) {
+      return parseStatus(byte, out);
+    }
+
+    // Data byte
+    if (_inSysEx) {
+      return false;  // SysEx payload is skipped
+    }
+    if (_status == 0) {
+      _strayBytes++;  // Data with no status to run on (e.g. joined mid-stream)
+      return false;
+    }
+
+    _data[_count++] = byte;
+    if (_count < _expected) {
+      return false;
+    }
+
+    out.status = _status;
+    out.data1 = _data[0];
+    out.data2 = (_expected > 1) ? _data[1] : 0;
+    _count = 0;
+
+    // Running status applies to channel messages only
+    if (_status >= 0xF0) {
+      _status = 0;
+    }
+
+    // Note-on with velocity 0 is a note-off by definition
+    if ((out.status & 0xF0) == MIDI_NOTE_ON && out.data2 == 0) {
+      out.status = MIDI_NOTE_OFF | (out.status & 0x0F);
+    }
+    return true;
+  }
+
+  /**
+   * Get the number of data bytes dropped for lack of a status byte
+   */
+  uint32_t getStrayBytes() const {
+    return _strayBytes;
+  }
+
+private:
+  uint8_t _status;     // Running status (0 = none)
+  uint8_t _expected;   // Data bytes the current status takes
+  uint8_t _count;      // Data bytes received so far
+  uint8_t _data[2];
+  bool _inSysEx;
+  uint32_t _strayBytes;
+
+  /**
+   * Number of data bytes after a status byte
+   */
+  static uint8_t dataLength(uint8_t status) {
+    switch (status & 0xF0) {
+      case MIDI_PROGRAM_CHANGE:
+      case MIDI_CHANNEL_PRESSURE:
+        return 1;
+      case 0xF0:
+        switch (status) {
+          case MIDI_TIME_CODE:
+          case MIDI_SONG_SELECT:   return 1;
+          case MIDI_SONG_POSITION: return 2;
+          default:                 return 0;
+        }
+      default:
+        return 2;
+    }
+  }
+
+  bool parseStatus(uint8_t byte, MidiMessage& out) {
+    _count = 0;
+
+    if (byte == 0xF0) {
+      _inSysEx = true;   // Skip everything up to EOX
+      _status = 0;
+      return false;
+    }
+    _inSysEx = false;
+
+    if (byte == 0xF7 || byte == 0xF4 || byte == 0xF5) {
+      _status = 0;       // EOX or undefined system common
+      return false;
+    }
+
+    _status = byte;
+    _expected = dataLength(byte);
+    if (_expected == 0) {
+      // Tune request: complete on its own
+      _status = 0;
+      out.status = byte;
+      out.data1 = 0;
+      out.data2 = 0;
+      return true;
+    }
+    return false;
+  }
+};
+
+#endif // MIDIPARSER_H
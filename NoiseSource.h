@@ -0,0 +1,234 @@
+/**
+ * NoiseSource.h
+ *
+ * Noise for the NOISE waveform and a random modulation source. Every voice
+ * owns a xorshift32 generator (three shifts and three XORs per sample, no
+ * table and no libc rand), so voices are uncorrelated and the audio task
+ * never shares generator state with another task. An optional one-pole
+ * low-pass colors the noise from white (bypassed) to a dark rumble, with a
+ * makeup gain (set with the color) that keeps the loudness of white noise.
+ *
+ * SampleAndHold draws a new random value at a set rate and holds it between
+ * draws. It is ticked once per audio buffer, so it costs nothing per sample.
+ * Integer only, in both engine builds.
+ */
+
+#ifndef NOISESOURCE_H
+#define NOISESOURCE_H
+
+#include <Arduino.h>
+#include "SynthConfig.h"
+
+// ========== XorShift32 Generator ==========
+struct XorShift32 {
+  uint32_t state;  // Never zero (zero is the one fixed point)
+
+  explicit XorShift32(uint32_t seed = 2463534242u) : state(seed ? seed : 2463534242u) {}
+
+  /**
+   * Next value (Marsaglia 13/17/5, period 2^32 - 1)
+   */
+  uint32_t next() {
+    uint32_t x = state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    state = x;
+    return x;
+  }
+
+  /**
+   * Next value as a signed 16-bit sample (full scale)
+   */
+  int16_t nextSample() {
+    return (int16_t)(next() >> 16);
+  }
+};
+
+// ========== Noise Color ==========
+namespace NoiseColor {
+  static const int MAX_COLOR = 100;  // Percent: 0 = white, 100 = darkest
+
+  static const int GAIN_BITS = 12;
+  static const int32_t WHITE = 1 << GAIN_BITS;
+
+  /**
+   * One-pole low-pass gain (Q12) for a color setting: y += gain * (x - y)
+   * 0 gives WHITE (filter bypassed); 100 is a pole at 0.99 (about 70 Hz at 44.1 kHz)
+   */
+  inline int32_t gain(int color) {
+    return WHITE - constrain(color, 0, MAX_COLOR) * (WHITE - 41) / MAX_COLOR;
+  }
+
+  /**
+   * Makeup gain (Q8) restoring white-noise power after a low-pass gain
+   * The filter passes gain / (2 - gain) of it, so the makeup is sqrt((2 - gain) / gain)
+   */
+  inline int32_t makeup(int32_t lowpassGain) {
+    uint32_t square = (uint32_t)(((uint64_t)(2 * WHITE - lowpassGain) << 16) / lowpassGain);
+    uint32_t root = 0;
+    for (uint32_t bit = 1u << 15; bit != 0; bit >>= 1) {
+      if ((root | bit) * (root | bit) <= square) {
+        root |= bit;
+      }
+    }
+    return (int32_t)root;
+  }
+}
+
+// ========== NoiseEngine Class ==========
+template <class Config>
+class BasicNoiseEngine {
+private:
+  typedef typename Config::Sample Sample;
+  static constexpr int NOTES = Config::CHORD_NOTES;
+
+  struct Voice {
+    XorShift32 rng;
+    int32_t lowpass;  // One-pole state, sample units << STATE_BITS
+  };
+
+  // Fraction bits of the filter state: (x - y) * gain stays within 32 bits
+  static constexpr int STATE_BITS = 3;
+
+  Voice voices[NOTES];
+  int color;
+  int32_t gain;    // Q12 low-pass gain, NoiseColor::WHITE = bypassed
+  int32_t makeup;  // Q8 level correction for the colored mix
+
+  /**
+   * Sample loop for white or colored noise (no per-sample branch on color)
+   * Each voice gets 1/NOTES of the peak, so the sum cannot clip
+   */
+  template <bool Colored>
+  void renderVoices(Sample* out, int frames) {
+    const int32_t voiceAmplitude = Config::MAX_AMPLITUDE / NOTES;
+    for (int i = 0; i < frames; i++) {
+      int32_t mix = 0;
+      for (int n = 0; n < NOTES; n++) {
+        int32_t white = voices[n].rng.nextSample();
+        if constexpr (Colored) {
+          // A convex average of input and state, so |y| stays within |x|
+          int32_t& y = voices[n].lowpass;
+          y += (((white << STATE_BITS) - y) * gain) >> NoiseColor::GAIN_BITS;
+          white = y >> STATE_BITS;
+        }
+        mix += white;
+      }
+      int32_t sample = (mix * voiceAmplitude) >> 15;
+      if constexpr (Colored) {
+        sample = constrain((sample * makeup) >> 8, -32767, 32767);  // Filtered peaks are rarer but taller
+      }
+      out[i] = (Sample)sample;
+    }
+  }
+
+public:
+  /**
+   * Constructor - white noise, one distinct seed per voice
+   */
+  BasicNoiseEngine() : color(0), gain(NoiseColor::WHITE), makeup(256) {
+    for (int n = 0; n < NOTES; n++) {
+      voices[n].rng = XorShift32(0x9E3779B9u * (n + 1));
+      voices[n].lowpass = 0;
+    }
+  }
+
+  /**
+   * Set the noise color
+   * @param percent 0 (white) to 100 (darkest)
+   */
+  void setColor(int percent) {
+    color = constrain(percent, 0, NoiseColor::MAX_COLOR);
+    gain = NoiseColor::gain(color);
+    makeup = NoiseColor::makeup(gain);
+  }
+
+  int getColor() const {
+    return color;
+  }
+
+  /**
+   * Render mixed noise samples
+   */
+  void render(Sample* out, int frames) {
+    if (gain == NoiseColor::WHITE) {
+      renderVoices<false>(out, frames);
+    } else {
+      renderVoices<true>(out, frames);
+    }
+  }
+
+  /**
+   * Clear the color filters (the generators simply run on)
+   */
+  void reset() {
+    for (int n = 0; n < NOTES; n++) {
+      voices[n].lowpass = 0;
+    }
+  }
+};
+
+// ========== SampleAndHold Class ==========
+class SampleAndHold {
+public:
+  static const int MAX_RATE_HZ = 40;
+
+  /**
+   * Constructor - 4 Hz, held at zero until the first draw
+   */
+  SampleAndHold() : _rng(0x2545F491u), _rateHz(4), _sampleRate(44100), _countdown(0), _value(0) {}
+
+  /**
+   * Set the draw rate (limited by the caller's tick interval)
+   * @param rateHz Draws per second (1-40)
+   * @param sampleRate Rate of the frames passed to tick()
+   */
+  void setRate(int rateHz, uint32_t sampleRate) {
+    _rateHz = constrain(rateHz, 1, MAX_RATE_HZ);
+    _sampleRate = sampleRate;
+    if (_countdown > (int32_t)(_sampleRate / _rateHz)) {
+      _countdown = _sampleRate / _rateHz;
+    }
+  }
+
+  int getRate() const {
+    return _rateHz;
+  }
+
+  /**
+   * Account for a block of frames (call once per block)
+   * @return true if a new value was drawn
+   */
+  bool tick(uint32_t frames) {
+    _countdown -= (int32_t)frames;
+    if (_countdown > 0) {
+      return false;
+    }
+    _countdown += _sampleRate / _rateHz;
+    if (_countdown <= 0) {
+      _countdown = _sampleRate / _rateHz;  // Block longer than a period: one draw, restart
+    }
+    _value = _rng.nextSample();
+    return true;
+  }
+
+  /**
+   * Get the held value (Q15, -32768 to 32767)
+   */
+  int16_t getValue() const {
+    return _value;
+  }
+
+private:
+  XorShift32 _rng;
+  int _rateHz;
+  uint32_t _sampleRate;
+  int32_t _countdown;  // Frames until the next draw
+  int16_t _value;
+};
+
+// Engine noise voices (configuration chosen at build time, see SynthConfig.h)
+typedef BasicNoiseEngine<SynthEngineConfig> NoiseEngine;
+
+#endif // NOISESOURCE_H
@@ -0,0 +1,266 @@
+/*
+ * OledBus.h - Transport backends for OledDisplay frame transfers
+ * 
+ * OledDisplay stages each frame's dirty windows into an OledFrame (a list of
+ * ready-to-send I2C transactions) and hands it to an OledBus. The bus decides
+ * whether the transfer is blocking (Wire), asynchronous (ESP-IDF I2C master,
+ * see AsyncI2CBus.h) or only recorded (MockOledBus).
+ */
+
+#ifndef OLED_BUS_H
+#define OLED_BUS_H
+
+#include <Arduino.h>
+#include <Wire.h>
+
+// Largest supported panel (128x64 SSD1306)
+#define OLED_MAX_WIDTH  128
+#define OLED_MAX_PAGES  8
+
+/**
+ * OledFrame - One frame's worth of staged I2C transactions
+ * 
+ * Each segment is a complete transaction payload starting with its SSD1306
+ * control byte (0x00 = command stream, 0x40 = data stream). The buffer must
+ * not be touched while inFlight is set.
+ */
+struct OledFrame {
+  static const int MAX_SEGMENTS = 2 * OLED_MAX_PAGES;         // Command + data per page
+  static const int MAX_BYTES = OLED_MAX_PAGES * (8 + 1 + OLED_MAX_WIDTH);
+
+  uint8_t bytes[MAX_BYTES];
+  uint16_t segmentOffset[MAX_SEGMENTS];
+  uint16_t segmentLength[MAX_SEGMENTS];
+  int numSegments;
+  size_t used;
+
+  volatile int pending;        // Segments not yet completed by the bus
+  volatile bool inFlight;      // Set from submit() until the last segment completes
+  uint32_t submitMicros;       // micros() when handed to the bus
+
+  OledFrame() : numSegments(0), used(0), pending(0), inFlight(false), submitMicros(0) {}
+
+  /**
+   * Clear segments so the frame can be rebuilt
+   */
+  void reset() {
+    numSegments = 0;
+    used = 0;
+  }
+
+  /**
+   * Append a transaction: control byte followed by payload
+   * 
+   * @return true if it fit, false if the frame is full
+   */
+  bool addSegment(uint8_t control, const uint8_t* payload, size_t length) {
+    if (numSegments >= MAX_SEGMENTS || used + 1 + length > (size_t)MAX_BYTES) {
+      return false;
+    }
+    
+    segmentOffset[numSegments] = used;
+    segmentLength[numSegments] = 1 + length;
+    bytes[used] = control;
+    memcpy(&bytes[used + 1], payload, length);
+    used += 1 + length;
+    numSegments++;
+    return true;
+  }
+};
+
+/**
+ * OledBus - Interface for delivering staged frames to the panel
+ * 
+ * submit() takes ownership of the frame until the bus reports completion
+ * through the callback, which may run in ISR context (fromISR = true). The
+ * callback returns true if it woke a higher priority task. It is called from
+ * the I2C interrupt while flash cache may be off, so it must be IRAM_ATTR
+ * and call only IRAM-safe functions, like completeFrame() itself.
+ */
+class OledBus {
+public:
+  typedef bool (*FrameCompleteCallback)(OledFrame* frame, void* arg, bool fromISR);
+
+  OledBus() : _onComplete(nullptr), _callbackArg(nullptr) {}
+  virtual ~OledBus() {}
+
+  /**
+   * Start transferring a frame
+   * 
+   * @param frame Staged frame (inFlight and pending already set by the caller)
+   * @return true if accepted, false on bus error (frame is completed anyway)
+   */
+  virtual bool submit(OledFrame* frame) = 0;
+
+  /**
+   * Check whether transfers can overlap with drawing
+   */
+  virtual bool isAsync() const {
+    return false;
+  }
+
+  /**
+   * Register the frame-complete callback
+   */
+  void setFrameCompleteCallback(FrameCompleteCallback callback, void* arg) {
+    _onComplete = callback;
+    _callbackArg = arg;
+  }
+
+protected:
+  FrameCompleteCallback _onComplete;
+  void* _callbackArg;
+
+  /**
+   * Mark a frame finished and publish the frame-complete event
+   * 
+   * @return true if a higher priority task was woken (ISR context only)
+   */
+  bool IRAM_ATTR completeFrame(OledFrame* frame, bool fromISR) {
+    frame->pending = 0;
+    frame->inFlight = false;
+    if (_onComplete != nullptr) {
+      return _onComplete(frame, _callbackArg, fromISR);
+    }
+    return false;
+  }
+};
+
+/**
+ * WireOledBus - Blocking transfers through the Arduino Wire library
+ * 
+ * Splits data segments to fit Wire's transmit buffer, repeating the
+ * control byte for each chunk.
+ */
+class WireOledBus : public OledBus {
+public:
+  WireOledBus() : _twi(nullptr), _address(0), _clockHz(400000UL) {}
+
+  /**
+   * Attach to an already started Wire bus
+   * 
+   * @param twi I2C bus
+   * @param address Panel I2C address
+   * @param clockHz Bus clock while transferring
+   */
+  void begin(TwoWire* twi, uint8_t address, uint32_t clockHz) {
+    _twi = twi;
+    _address = address;
+    _clockHz = clockHz;
+  }
+
+  bool submit(OledFrame* frame) override {
+    if (_twi == nullptr) {
+      completeFrame(frame, false);
+      return false;
+    }
+    
+    // Adafruit_SSD1306 drops the clock after its own transfers; raise it per frame
+    _twi->setClock(_clockHz);
+    
+    bool ok = true;
+    for (int i = 0; i < frame->numSegments; i++) {
+      const uint8_t* segment = &frame->bytes[frame->segmentOffset[i]];
+      int remaining = frame->segmentLength[i] - 1;
+      const uint8_t* payload = segment + 1;
+      
+      do {
+        int chunk = min(remaining, I2C_CHUNK - 1);
+        _twi->beginTransmission(_address);
+        _twi->write(segment[0]);
+        _twi->write(payload, chunk);
+        ok = (_twi->endTransmission() == 0) && ok;
+        payload += chunk;
+        remaining -= chunk;
+      } while (remaining > 0);
+    }
+    
+    completeFrame(frame, false);
+    return ok;
+  }
+
+private:
+  // Bytes per I2C transaction (control byte included), bounded by Wire's buffer
+#ifdef I2C_BUFFER_LENGTH
+  static const int I2C_CHUNK = I2C_BUFFER_LENGTH;
+#else
+  static const int I2C_CHUNK = 32;
+#endif
+
+  TwoWire* _twi;
+  uint8_t _address;
+  uint32_t _clockHz;
+};
+
+/**
+ * MockOledBus - Records transfers instead of sending them
+ * 
+ * Stands in for the panel in host builds and bench measurements: logs the
+ * size and submit time of recent frames and simulates the wire time an
+ * I2C bus at the given clock would need (9 clocks per byte).
+ */
+class MockOledBus : public OledBus {
+public:
+  static const int MAX_RECORDS = 64;
+
+  struct Record {
+    uint32_t submitMicros;     // micros() at submit
+    uint16_t bytes;            // Payload bytes including control bytes
+    uint16_t transactions;     // I2C transactions in the frame
+    uint32_t wireMicros;       // Simulated bus time at the configured clock
+  };
+
+  explicit MockOledBus(uint32_t clockHz = 400000UL) :
+    _clockHz(clockHz),
+    _count(0),
+    _totalBytes(0) {
+  }
+
+  bool submit(OledFrame* frame) override {
+    Record& record = _records[_count % MAX_RECORDS];
+    record.submitMicros = micros();
+    record.bytes = frame->used;
+    record.transactions = frame->numSegments;
+    
+    // Address byte + payload per transaction, 9 SCL clocks per byte (8 data + ACK)
+    uint32_t wireBytes = frame->used + frame->numSegments;
+    record.wireMicros = (uint32_t)((uint64_t)wireBytes * 9 * 1000000UL / _clockHz);
+    
+    _count++;
+    _totalBytes += frame->used;
+    completeFrame(frame, false);
+    return true;
+  }
+
+  /**
+   * Get the number of frames submitted since startup
+   */
+  uint32_t getFrameCount() const {
+    return _count;
+  }
+
+  /**
+   * Get total payload bytes submitted since startup
+   */
+  uint32_t getTotalBytes() const {
+    return _totalBytes;
+  }
+
+  /**
+   * Get a recorded frame (0 = most recent)
+   */
+  const Record* getRecord(int age) const {
+    if (age < 0 || (uint32_t)age >= _count || age >= MAX_RECORDS) {
+      return nullptr;
+    }
+    return &_records[(_count - 1 - age) % MAX_RECORDS];
+  }
+
+private:
+  uint32_t _clockHz;
+  Record _records[MAX_RECORDS];
+  uint32_t _count;
+  uint32_t _totalBytes;
+};
+
+#endif // OLED_BUS_H
@@ -0,0 +1,281 @@
+/*
+ * OledDisplay.h - SSD1306 display with dirty-region partial updates
+ * 
+ * Drop-in Adafruit_SSD1306 subclass that keeps a shadow copy of the last
+ * frame sent to the panel and only transfers the pages and column spans
+ * that changed since then. Transfers go through a pluggable OledBus, so
+ * they can run asynchronously while the next frame is drawn.
+ */
+
+#ifndef OLED_DISPLAY_H
+#define OLED_DISPLAY_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <Adafruit_GFX.h>
+#include <Adafruit_SSD1306.h>
+#include "OledBus.h"
+
+/**
+ * OledDisplay - Adafruit_SSD1306 with dirty page/column tracking
+ * 
+ * Features:
+ * - Draw with the normal Adafruit GFX API, then call update()
+ * - Per page (8 pixel rows), finds the first and last changed column
+ * - Sends one addressed window per dirty page (PAGEADDR + COLUMNADDR + data)
+ * - Unchanged frames cost a 1 KB compare and no I2C traffic at all
+ * - Transfer statistics for measuring bus load
+ * - Double-buffered staging: with an async bus, update() returns as soon as
+ *   the frame is queued and only waits if both staging buffers are in flight
+ * - Frame-complete event (waitFrameComplete) and transfer timing
+ * 
+ * Note: display() from the base class still pushes a full frame but does not
+ * update the shadow copy - call invalidate() afterwards if it was used.
+ */
+class OledDisplay : public Adafruit_SSD1306 {
+public:
+  // Shadow buffer sized for the largest supported panel (128x64)
+  static const int MAX_WIDTH = OLED_MAX_WIDTH;
+  static const int MAX_PAGES = OLED_MAX_PAGES;
+  static const int MAX_HEIGHT = MAX_PAGES * 8;
+  
+  // Longest wait for a staging buffer before a frame is dropped
+  static const uint32_t FRAME_TIMEOUT_MS = 100;
+
+  /**
+   * Constructor
+   * 
+   * @param width Panel width in pixels (max MAX_WIDTH)
+   * @param height Panel height in pixels (max MAX_HEIGHT)
+   * @param twi I2C bus the panel is attached to
+   * @param resetPin Reset pin (-1 if sharing the ESP32 reset pin)
+   * @param clockHz I2C clock used while transferring (default: 400 kHz)
+   */
+  OledDisplay(uint8_t width, uint8_t height, TwoWire* twi, int8_t resetPin = -1,
+              uint32_t clockHz = 400000UL) :
+    Adafruit_SSD1306(width, height, twi, resetPin, clockHz),
+    _twi(twi),
+    _clockHz(clockHz),
+    _bus(&_wireBus),
+    _nextFrame(0),
+    _frameDone(nullptr),
+    _shadowValid(false),
+    _lastBytesSent(0),
+    _lastPagesSent(0),
+    _totalBytesSent(0),
+    _framesCompleted(0),
+    _lastTransferMicros(0) {
+  }
+
+  /**
+   * Initialize the panel
+   * 
+   * @param vccState SSD1306_SWITCHCAPVCC or SSD1306_EXTERNALVCC
+   * @param address I2C address (0x3C or 0x3D)
+   * @return true if initialization successful, false otherwise
+   */
+  bool begin(uint8_t vccState, uint8_t address) {
+    _shadowValid = false;
+    if (_frameDone == nullptr) {
+      _frameDone = xSemaphoreCreateBinary();
+    }
+    
+    _wireBus.begin(_twi, address, _clockHz);
+    setBus(&_wireBus);
+    return Adafruit_SSD1306::begin(vccState, address);
+  }
+
+  /**
+   * Route frame transfers through a different bus backend
+   * Waits for in-flight frames on the current bus first.
+   * 
+   * @param bus Backend (e.g. AsyncI2CBus or MockOledBus); nullptr restores Wire
+   */
+  void setBus(OledBus* bus) {
+    waitFrameComplete(FRAME_TIMEOUT_MS);
+    _bus = (bus != nullptr) ? bus : &_wireBus;
+    _bus->setFrameCompleteCallback(onFrameComplete, this);
+  }
+
+  /**
+   * Block until every submitted frame has left the bus
+   * 
+   * @param timeoutMs Maximum time to wait
+   * @return true if the bus is idle, false on timeout
+   */
+  bool waitFrameComplete(uint32_t timeoutMs) {
+    for (int i = 0; i < NUM_FRAMES; i++) {
+      if (!waitForFrame(_frames[i], timeoutMs)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * Force the next update() to send the full frame
+   * Use after anything wrote to the panel behind this class's back.
+   */
+  void invalidate() {
+    _shadowValid = false;
+  }
+
+  /**
+   * Send only the regions that changed since the last update()
+   * With an async bus this returns once the frame is queued; the framebuffer
+   * can be redrawn immediately since the dirty bytes are staged separately.
+   * 
+   * @return Number of framebuffer bytes transferred (0 if nothing changed)
+   */
+  size_t update() {
+    OledFrame& frame = _frames[_nextFrame];
+    if (!waitForFrame(frame, FRAME_TIMEOUT_MS)) {
+      return 0;  // Bus stalled - drop this frame, shadow stays as it was
+    }
+    frame.reset();
+    
+    uint8_t* buffer = getBuffer();
+    int w = min((int)width(), (int)MAX_WIDTH);
+    int pages = min((int)height(), (int)MAX_HEIGHT) / 8;
+    
+    size_t bytesSent = 0;
+    int pagesSent = 0;
+    
+    for (int page = 0; page < pages; page++) {
+      const uint8_t* row = &buffer[page * w];
+      uint8_t* shadowRow = &_shadow[page * MAX_WIDTH];
+      
+      // Find the changed column span in this page
+      int first = 0;
+      int last = w - 1;
+      if (_shadowValid) {
+        while (first < w && row[first] == shadowRow[first]) first++;
+        if (first == w) continue;  // Page unchanged
+        while (row[last] == shadowRow[last]) last--;
+      }
+      
+      // Address a single-page window (horizontal addressing, set by begin())
+      const uint8_t window[6] = {
+        SSD1306_PAGEADDR, (uint8_t)page, (uint8_t)page,
+        SSD1306_COLUMNADDR, (uint8_t)first, (uint8_t)last
+      };
+      int length = last - first + 1;
+      frame.addSegment(0x00, window, sizeof(window));   // Co = 0, D/C = 0: commands
+      frame.addSegment(0x40, &row[first], length);      // Co = 0, D/C = 1: data
+      
+      memcpy(&shadowRow[first], &row[first], length);
+      bytesSent += length;
+      pagesSent++;
+    }
+    
+    _shadowValid = true;
+    _lastBytesSent = bytesSent;
+    _lastPagesSent = pagesSent;
+    _totalBytesSent += bytesSent;
+    
+    if (frame.numSegments > 0) {
+      frame.pending = frame.numSegments;
+      frame.inFlight = true;
+      frame.submitMicros = micros();
+      _bus->submit(&frame);
+      _nextFrame = (_nextFrame + 1) % NUM_FRAMES;
+    }
+    return bytesSent;
+  }
+
+  /**
+   * Get the number of framebuffer bytes sent by the last update()
+   */
+  size_t getLastBytesSent() const {
+    return _lastBytesSent;
+  }
+
+  /**
+   * Get the number of pages touched by the last update()
+   */
+  int getLastPagesSent() const {
+    return _lastPagesSent;
+  }
+
+  /**
+   * Get the total framebuffer bytes sent since startup
+   */
+  uint32_t getTotalBytesSent() const {
+    return _totalBytesSent;
+  }
+
+  /**
+   * Get the number of frames that have finished transferring
+   */
+  uint32_t getFramesCompleted() const {
+    return _framesCompleted;
+  }
+
+  /**
+   * Get the bus time of the most recently completed frame
+   * 
+   * @return Microseconds from submit to frame-complete
+   */
+  uint32_t getLastTransferMicros() const {
+    return _lastTransferMicros;
+  }
+
+private:
+  static const int NUM_FRAMES = 2;  // Double-buffered staging
+
+  TwoWire* _twi;
+  uint32_t _clockHz;
+  
+  // Transport
+  WireOledBus _wireBus;
+  OledBus* _bus;
+  OledFrame _frames[NUM_FRAMES];
+  int _nextFrame;
+  SemaphoreHandle_t _frameDone;  // Given on every frame-complete event
+
+  // Last frame known to be on the panel (SSD1306 page layout)
+  uint8_t _shadow[MAX_WIDTH * MAX_PAGES];
+  bool _shadowValid;
+
+  // Transfer statistics
+  size_t _lastBytesSent;
+  int _lastPagesSent;
+  uint32_t _totalBytesSent;
+  volatile uint32_t _framesCompleted;
+  volatile uint32_t _lastTransferMicros;
+
+  /**
+   * Wait until a staging buffer is no longer owned by the bus
+   */
+  bool waitForFrame(const OledFrame& frame, uint32_t timeoutMs) {
+    while (frame.inFlight) {
+      if (_frameDone == nullptr ||
+          xSemaphoreTake(_frameDone, pdMS_TO_TICKS(timeoutMs)) != pdTRUE) {
+        return !frame.inFlight;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * Frame-complete event from the bus (task or ISR context)
+   */
+  static bool IRAM_ATTR onFrameComplete(OledFrame* frame, void* arg, bool fromISR) {
+    OledDisplay* self = static_cast<OledDisplay*>(arg);
+    self->_lastTransferMicros = micros() - frame->submitMicros;
+    self->_framesCompleted++;
+    
+    if (self->_frameDone == nullptr) {
+      return false;
+    }
+    if (!fromISR) {
+      xSemaphoreGive(self->_frameDone);
+      return false;
+    }
+    BaseType_t woken = pdFALSE;
+    xSemaphoreGiveFromISR(self->_frameDone, &woken);
+    return woken == pdTRUE;
+  }
+};
+
+#endif // OLED_DISPLAY_H
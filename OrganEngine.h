@@ -0,0 +1,222 @@
+/**
+ * OrganEngine.h
+ *
+ * Drawbar organ voices for the chord modes. Each chord note has nine
+ * partials at the tonewheel footages 16' 5 1/3' 8' 4' 2 2/3' 2' 1 3/5' 1 1/3'
+ * 1', which are 1 3 2 4 6 8 10 12 16 times half the note frequency. One
+ * 32-bit accumulator per note runs at that half frequency; each partial's
+ * phase is an integer multiple of it (the product wraps modulo one cycle),
+ * so the partials stay phase-locked and cost one multiply and one sine table
+ * read each, with no per-partial state.
+ *
+ * When notes or drawbars change, partials at or above Nyquist and partials
+ * with the drawbar pushed in are culled from the per-note list, and levels
+ * are normalized so a full registration cannot clip.
+ */
+
+#ifndef ORGANENGINE_H
+#define ORGANENGINE_H
+
+#include <Arduino.h>
+#include "SynthConfig.h"
+
+// ========== Drawbar Registration ==========
+struct OrganRegistration {
+  const char* name;
+  uint8_t drawbars[9];  // 0-8 per footage, 16' first (as written on the organ: 88 8000 000)
+};
+
+// ========== Registration Library ==========
+namespace OrganLib {
+  static const int NUM_DRAWBARS = 9;
+  static const int MAX_LEVEL = 8;
+
+  // Partial frequency in half note frequencies, per drawbar
+  constexpr uint8_t HARMONICS[NUM_DRAWBARS] = {1, 3, 2, 4, 6, 8, 10, 12, 16};
+
+  // Drawbar position to amplitude (Q8), about 3 dB per step
+  constexpr uint16_t LEVELS_Q8[MAX_LEVEL + 1] = {0, 23, 32, 45, 64, 91, 128, 181, 256};
+
+  constexpr OrganRegistration JAZZ    = {"Jazz",    {8, 8, 8, 0, 0, 0, 0, 0, 0}};
+  constexpr OrganRegistration GOSPEL  = {"Gospel",  {8, 8, 8, 8, 0, 0, 0, 0, 0}};
+  constexpr OrganRegistration FULL    = {"Full",    {8, 8, 8, 8, 8, 8, 8, 8, 8}};
+  constexpr OrganRegistration WHISTLE = {"Whistle", {8, 0, 0, 0, 0, 0, 8, 8, 8}};
+
+  constexpr const OrganRegistration* ALL_REGISTRATIONS[] = {&JAZZ, &GOSPEL, &FULL, &WHISTLE};
+  constexpr int NUM_REGISTRATIONS = sizeof(ALL_REGISTRATIONS) / sizeof(ALL_REGISTRATIONS[0]);
+
+  /**
+   * Pack drawbars as the nine digits an organist writes (888000000)
+   */
+  inline int32_t pack(const uint8_t drawbars[NUM_DRAWBARS]) {
+    int32_t packed = 0;
+    for (int i = 0; i < NUM_DRAWBARS; i++) {
+      packed = packed * 10 + drawbars[i];
+    }
+    return packed;
+  }
+
+  /**
+   * Unpack nine digits; false if a digit is above MAX_LEVEL
+   */
+  inline bool unpack(int32_t packed, uint8_t drawbars[NUM_DRAWBARS]) {
+    if (packed < 0 || packed > 888888888) {
+      return false;
+    }
+    for (int i = NUM_DRAWBARS - 1; i >= 0; i--) {
+      int digit = packed % 10;
+      if (digit > MAX_LEVEL) {
+        return false;
+      }
+      drawbars[i] = (uint8_t)digit;
+      packed /= 10;
+    }
+    return true;
+  }
+}
+
+// ========== OrganEngine Class ==========
+template <class Config>
+class BasicOrganEngine {
+private:
+  typedef typename Config::Sample Sample;
+  static constexpr int NOTES = Config::CHORD_NOTES;
+  static constexpr int NUM_DRAWBARS = OrganLib::NUM_DRAWBARS;
+  static constexpr int SINE_SHIFT = 32 - Config::TABLE_BITS;
+
+  struct Note {
+    uint32_t phase;       // 16' accumulator (half the note frequency)
+    uint32_t increment;
+    int partials;         // Sounding partials after culling
+    uint8_t multiples[NUM_DRAWBARS];
+    int16_t levels[NUM_DRAWBARS];  // Q15, normalized across the chord
+  };
+
+  Note notes[NOTES];
+  uint32_t noteIncrements[NOTES];  // Note fundamentals (2^32 = one cycle)
+  uint8_t drawbars[NUM_DRAWBARS];
+  const Sample* sineTable;
+
+  /**
+   * Rebuild the partial lists: drop silent and above-Nyquist partials,
+   * scale levels so the loudest possible chord sum stays at the table peak
+   */
+  void buildPartials() {
+    uint32_t levelSum = 0;
+    for (int d = 0; d < NUM_DRAWBARS; d++) {
+      levelSum += OrganLib::LEVELS_Q8[drawbars[d]];
+    }
+
+    for (int n = 0; n < NOTES; n++) {
+      Note& note = notes[n];
+      note.increment = noteIncrements[n] / 2;
+      note.partials = 0;
+      if (levelSum == 0) {
+        continue;
+      }
+      for (int d = 0; d < NUM_DRAWBARS; d++) {
+        uint16_t level = OrganLib::LEVELS_Q8[drawbars[d]];
+        uint64_t partialIncrement = (uint64_t)note.increment * OrganLib::HARMONICS[d];
+        if (level == 0 || partialIncrement >= 0x80000000ULL) {
+          continue;  // Drawbar in, or at/above Nyquist (half a cycle per sample)
+        }
+        note.multiples[note.partials] = OrganLib::HARMONICS[d];
+        note.levels[note.partials] = (int16_t)(((uint32_t)level << 15) / (levelSum * NOTES));
+        note.partials++;
+      }
+    }
+  }
+
+public:
+  /**
+   * Constructor - first registration, silent until notes are set
+   */
+  BasicOrganEngine() : sineTable(nullptr) {
+    for (int n = 0; n < NOTES; n++) {
+      noteIncrements[n] = 0;
+      notes[n].phase = 0;
+    }
+    setRegistration(OrganLib::ALL_REGISTRATIONS[0]->drawbars);
+  }
+
+  /**
+   * Set the sine table the partials read (Oscillator::getSineTable())
+   */
+  void setSineTable(const Sample* table) {
+    sineTable = table;
+  }
+
+  /**
+   * Set all nine drawbars (0-8, 16' first); phases are kept
+   */
+  void setRegistration(const uint8_t newDrawbars[NUM_DRAWBARS]) {
+    for (int d = 0; d < NUM_DRAWBARS; d++) {
+      drawbars[d] = (newDrawbars[d] > OrganLib::MAX_LEVEL) ? OrganLib::MAX_LEVEL : newDrawbars[d];
+    }
+    buildPartials();
+  }
+
+  /**
+   * Set the fundamental of each chord note (culls partials for the new pitch)
+   * @param increments Per-sample phase steps, 2^32 = one cycle
+   */
+  void setNoteIncrements(const uint32_t increments[NOTES]) {
+    for (int n = 0; n < NOTES; n++) {
+      noteIncrements[n] = increments[n];
+    }
+    buildPartials();
+  }
+
+  /**
+   * Get the number of partials a note is playing after culling
+   */
+  int getPartialCount(int note) const {
+    return notes[note].partials;
+  }
+
+  /**
+   * Render mixed chord samples
+   */
+  void render(Sample* out, int frames) {
+    if (sineTable == nullptr) {
+      memset(out, 0, frames * sizeof(Sample));
+      return;
+    }
+
+    for (int i = 0; i < frames; i++) {
+      int32_t mix = 0;
+      for (int n = 0; n < NOTES; n++) {
+        Note& note = notes[n];
+        for (int p = 0; p < note.partials; p++) {
+          uint32_t phase = note.phase * note.multiples[p];  // Wraps like the accumulator
+          mix += (int32_t)sineTable[phase >> SINE_SHIFT] * note.levels[p];
+        }
+        note.phase += note.increment;
+      }
+      out[i] = (Sample)(mix >> 15);
+    }
+  }
+
+  /**
+   * Advance every note as if frames samples had been rendered
+   */
+  void advance(uint32_t frames) {
+    for (int n = 0; n < NOTES; n++) {
+      notes[n].phase += notes[n].increment * frames;
+    }
+  }
+
+  /**
+   * Reset all note phases
+   */
+  void reset() {
+    for (int n = 0; n < NOTES; n++) {
+      notes[n].phase = 0;
+    }
+  }
+};
+
+// Engine organ voices (configuration chosen at build time, see SynthConfig.h)
+typedef BasicOrganEngine<SynthEngineConfig> OrganEngine;
+
+#endif // ORGANENGINE_H
@@ -4,12 +4,14 @@
  * Encapsulates oscillator waveform generation and management.
  * Provides multiple waveform types (sine, triangle, square, sawtooth)
  * with thread-safe switching capabilities.
+ * Table size and amplitude come from the SynthConfig it is built for.
  */
 
 #ifndef OSCILLATOR_H
 #define OSCILLATOR_H
 
 #include <Arduino.h>
+#include "SynthConfig.h"
 
 // ========== Oscillator Types ==========
 enum OscillatorType {
@@ -17,19 +19,25 @@ enum OscillatorType {
   OSC_TRIANGLE,
   OSC_SQUARE,
   OSC_SAWTOOTH,
+  OSC_FM,    // Chord modes: operator stacks on the sine table (FmEngine); NOTE mode plays the sine
+  OSC_ORGAN, // Chord modes: drawbar partials on the sine table (OrganEngine); NOTE mode plays the sine
+  OSC_NOISE, // xorshift32 generators, no table (NoiseEngine); getSample() falls back to the sine
+  OSC_SAMPLER, // Chord modes: PCM samples from flash (SamplerEngine); NOTE mode plays the sine
   OSC_COUNT  // Total number of oscillator types
 };
 
 // ========== Oscillator Class ==========
-class Oscillator {
+template <class Config>
+class BasicOscillator {
 private:
-  static const int TABLE_SIZE = 256;
-  static const int16_t MAX_AMPLITUDE = 14000;  // Reduced to prevent clipping
+  typedef typename Config::Sample Sample;
+  static constexpr int TABLE_SIZE = Config::TABLE_SIZE;
+  static constexpr Sample MAX_AMPLITUDE = Config::MAX_AMPLITUDE;  // Reduced to prevent clipping
   
-  int16_t sineTable[TABLE_SIZE];
-  int16_t triangleTable[TABLE_SIZE];
-  int16_t squareTable[TABLE_SIZE];
-  int16_t sawtoothTable[TABLE_SIZE];
+  Sample sineTable[TABLE_SIZE];
+  Sample triangleTable[TABLE_SIZE];
+  Sample squareTable[TABLE_SIZE];
+  Sample sawtoothTable[TABLE_SIZE];
   
   volatile OscillatorType currentType;
   
@@ -37,7 +45,7 @@ public:
   /**
    * Constructor - initializes oscillator with sine wave
    */
-  Oscillator() : currentType(OSC_SINE) {}
+  BasicOscillator() : currentType(OSC_SINE) {}
   
   /**
    * Build all waveform lookup tables
@@ -48,7 +56,7 @@ public:
       float phase = (2.0f * PI * i) / TABLE_SIZE;
       
       // Sine wave
-      sineTable[i] = (int16_t)(sinf(phase) * MAX_AMPLITUDE);
+      sineTable[i] = (Sample)(sinf(phase) * MAX_AMPLITUDE);
       
       // Triangle wave
       float triangleValue;
@@ -57,14 +65,14 @@ public:
       } else {
         triangleValue = 3.0f - (4.0f * i / TABLE_SIZE);
       }
-      triangleTable[i] = (int16_t)(triangleValue * MAX_AMPLITUDE);
+      triangleTable[i] = (Sample)(triangleValue * MAX_AMPLITUDE);
       
       // Square wave
       squareTable[i] = (i < TABLE_SIZE / 2) ? MAX_AMPLITUDE : -MAX_AMPLITUDE;
       
       // Sawtooth wave
       float sawtoothValue = (2.0f * i / TABLE_SIZE) - 1.0f;
-      sawtoothTable[i] = (int16_t)(sawtoothValue * MAX_AMPLITUDE);
+      sawtoothTable[i] = (Sample)(sawtoothValue * MAX_AMPLITUDE);
     }
   }
   
@@ -109,6 +117,10 @@ public:
       case OSC_TRIANGLE: return "TRI";
       case OSC_SQUARE:   return "SQR";
       case OSC_SAWTOOTH: return "SAW";
+      case OSC_FM:       return "FM";
+      case OSC_ORGAN:    return "ORGAN";
+      case OSC_NOISE:    return "NOISE";
+      case OSC_SAMPLER:  return "SAMPLE";
       default:           return "???";
     }
   }
@@ -118,7 +130,7 @@ public:
    * @param index Table index (0 to TABLE_SIZE-1)
    * @return 16-bit audio sample
    */
-  int16_t getSample(int index) const {
+  Sample getSample(int index) const {
     return getSample(currentType, index);
   }
   
@@ -129,11 +141,11 @@ public:
    * @param customAmplitude Target amplitude for scaling
    * @return 16-bit audio sample scaled to custom amplitude
    */
-  int16_t getSampleScaled(int index, int16_t customAmplitude) const {
+  Sample getSampleScaled(int index, Sample customAmplitude) const {
     // Get normalized sample (-1.0 to 1.0)
     float normalized = getSample(index) / (float)MAX_AMPLITUDE;
     // Scale to custom amplitude
-    return (int16_t)(normalized * customAmplitude);
+    return (Sample)(normalized * customAmplitude);
   }
   
   /**
@@ -142,7 +154,7 @@ public:
    * @param index Table index (0 to TABLE_SIZE-1)
    * @return 16-bit audio sample
    */
-  int16_t getSample(OscillatorType type, int index) const {
+  Sample getSample(OscillatorType type, int index) const {
     if (index < 0 || index >= TABLE_SIZE) {
       return 0;
     }
@@ -157,52 +169,22 @@ public:
   }
   
   /**
-   * Get the table size
+   * Get the sine table (FM operators read it directly)
    */
-  static int getTableSize() {
-    return TABLE_SIZE;
+  const Sample* getSineTable() const {
+    return sineTable;
   }
   
   /**
-   * Calculate a display waveform value for visualization
-   * @param phase Phase angle (0 to 2*PI)
-   * @return Normalized value (-1.0 to 1.0)
-   */
-  float getDisplayValue(float phase) const {
-    return getDisplayValue(currentType, phase);
-  }
-  
-  /**
-   * Calculate a display waveform value for visualization
-   * @param type Oscillator type
-   * @param phase Phase angle (0 to 2*PI)
-   * @return Normalized value (-1.0 to 1.0)
+   * Get the table size
    */
-  static float getDisplayValue(OscillatorType type, float phase) {
-    float normalizedPhase = fmod(phase, TWO_PI) / TWO_PI;
-    
-    switch (type) {
-      case OSC_SINE:
-        return sin(phase);
-        
-      case OSC_TRIANGLE:
-        if (normalizedPhase < 0.5f) {
-          return (4.0f * normalizedPhase) - 1.0f;
-        } else {
-          return 3.0f - (4.0f * normalizedPhase);
-        }
-        
-      case OSC_SQUARE:
-        return (fmod(phase, TWO_PI) < PI) ? 1.0f : -1.0f;
-        
-      case OSC_SAWTOOTH:
-        return (2.0f * normalizedPhase) - 1.0f;
-        
-      default:
-        return sin(phase);
-    }
+  static constexpr int getTableSize() {
+    return TABLE_SIZE;
   }
 };
 
+// Engine oscillator (configuration chosen at build time, see SynthConfig.h)
+typedef BasicOscillator<SynthEngineConfig> Oscillator;
+
 #endif // OSCILLATOR_H
 
@@ -0,0 +1,377 @@
+/*
+ * PotSampler.h - Continuous potentiometer sampling off the audio core
+ *
+ * Samples every registered pot into a DMA buffer with the ESP-IDF continuous
+ * ADC driver at a fixed rate, filters each channel in its own task, and
+ * publishes the results as atomic control values. Readers never touch the ADC.
+ */
+
+#ifndef POT_SAMPLER_H
+#define POT_SAMPLER_H
+
+#include <Arduino.h>
+#include <atomic>
+
+#if __has_include("esp_adc/adc_continuous.h")
+#include "esp_adc/adc_continuous.h"
+#define POT_SAMPLER_DMA_AVAILABLE 1
+#else
+#define POT_SAMPLER_DMA_AVAILABLE 0
+#endif
+
+/**
+ * PotSampler - Oversampled, filtered potentiometer values
+ *
+ * Features:
+ * - ADC1 pins are sampled by DMA (continuous driver) at SAMPLE_RATE_HZ total
+ * - Per frame, each channel's samples are averaged (oversampling/decimation),
+ *   then a median of the last three frame means rejects single-frame spikes,
+ *   then a one-pole low-pass smooths the result
+ * - Optional zones with hysteresis (e.g. unison x1-x4), so a value sitting on
+ *   a boundary does not flicker between two zones
+ * - Pins the driver cannot stream (ADC2 on the classic ESP32) fall back to
+ *   oversampled oneshot reads in the same task, at the same control rate
+ * - Results are std::atomic - safe to read from any task or core
+ *
+ * Note: on the classic ESP32 the continuous ADC borrows I2S0, so start the
+ * sampler before creating the audio I2S channel (I2S_NUM_AUTO then picks I2S1).
+ */
+class PotSampler {
+public:
+  static const int MAX_POTS = 4;
+  static const int ADC_MAX = 4095;
+
+  // DMA rate (all channels together) and conversion frame size
+  static const uint32_t SAMPLE_RATE_HZ = 20000;
+  static const int FRAME_SAMPLES = 256;        // ~78 control updates per second
+  static const int FALLBACK_OVERSAMPLE = 8;    // Oneshot reads per update for non-DMA pins
+
+  /**
+   * Constructor
+   */
+  PotSampler() :
+    _numPots(0),
+    _numDmaPots(0),
+    _isRunning(false),
+    _taskHandle(nullptr)
+#if POT_SAMPLER_DMA_AVAILABLE
+    , _adcHandle(nullptr)
+#endif
+  {
+  }
+
+  /**
+   * Register a potentiometer (call before begin())
+   *
+   * @param pin GPIO connected to the wiper
+   * @param zones Number of zones for getZone() (0 = no zones)
+   * @param hysteresis Extra travel needed to leave a zone, in ADC counts
+   * @return Pot id, or -1 if MAX_POTS is exceeded
+   */
+  int addPot(uint8_t pin, int zones = 0, int hysteresis = 0) {
+    if (_numPots >= MAX_POTS || _isRunning) {
+      return -1;
+    }
+
+    int id = _numPots++;
+    Pot& pot = _pots[id];
+    pot.pin = pin;
+    pot.zones = zones;
+    pot.hysteresis = hysteresis;
+    pot.useDma = false;
+    pot.channel = 0;
+    pot.history[0] = pot.history[1] = pot.history[2] = -1;
+    pot.filtered = -1;
+    pot.value.store(0);
+    pot.zone.store(0);
+    pinMode(pin, INPUT);
+    return id;
+  }
+
+  /**
+   * Start sampling and the filter task
+   *
+   * @param core Core for the filter task (keep it off the audio core)
+   * @param priority Filter task priority
+   * @return true if sampling started (DMA or fallback), false otherwise
+   */
+  bool begin(int core, UBaseType_t priority) {
+    if (_numPots == 0 || _isRunning) {
+      return false;
+    }
+
+#if POT_SAMPLER_DMA_AVAILABLE
+    startDma();
+#endif
+
+    // Prime the filters so readers see a real value from the start
+    for (int i = 0; i < _numPots; i++) {
+      if (!_pots[i].useDma) {
+        publish(_pots[i], readOneshot(_pots[i]));
+      }
+    }
+
+    _isRunning = true;
+    BaseType_t ok = xTaskCreatePinnedToCore(taskEntry, "PotSampler", 3072, this,
+                                            priority, &_taskHandle, core);
+    if (ok != pdPASS) {
+      Serial.println("PotSampler: Failed to create task");
+      _isRunning = false;
+      return false;
+    }
+
+    Serial.printf("PotSampler: %d pot(s) by DMA, %d by oneshot\n",
+                  _numDmaPots, _numPots - _numDmaPots);
+    return true;
+  }
+
+  /**
+   * Filtered value of a pot
+   * @return 0 - ADC_MAX
+   */
+  int getValue(int id) const {
+    return (id >= 0 && id < _numPots) ? _pots[id].value.load(std::memory_order_relaxed) : 0;
+  }
+
+  /**
+   * Current zone of a pot (with hysteresis)
+   * @return 0 - zones-1 (0 if the pot has no zones)
+   */
+  int getZone(int id) const {
+    return (id >= 0 && id < _numPots) ? _pots[id].zone.load(std::memory_order_relaxed) : 0;
+  }
+
+  /**
+   * Check whether a pot is streamed by DMA (false = oneshot fallback)
+   */
+  bool isDma(int id) const {
+    return id >= 0 && id < _numPots && _pots[id].useDma;
+  }
+
+private:
+  struct Pot {
+    uint8_t pin;
+    int zones;
+    int hysteresis;
+    bool useDma;
+    int channel;                    // ADC1 channel (DMA pots)
+    int history[3];                 // Last three frame means (median input)
+    int filtered;                   // Low-pass state in Q4 (-1 = not primed)
+    std::atomic<uint16_t> value;    // Published filtered value
+    std::atomic<uint8_t> zone;      // Published zone
+  };
+
+  static const int FILTER_SHIFT = 4;
+
+  Pot _pots[MAX_POTS];
+  int _numPots;
+  int _numDmaPots;
+  volatile bool _isRunning;
+  TaskHandle_t _taskHandle;
+
+  /**
+   * Median of three
+   */
+  static int median3(int a, int b, int c) {
+    int lo = min(a, b);
+    int hi = max(a, b);
+    return max(lo, min(hi, c));
+  }
+
+  /**
+   * Run one decimated sample through median, low-pass and zone logic
+   */
+  void publish(Pot& pot, int mean) {
+    // Median of the last three frame means (fill history on the first sample)
+    if (pot.history[0] < 0) {
+      pot.history[0] = pot.history[1] = pot.history[2] = mean;
+    }
+    pot.history[0] = pot.history[1];
+    pot.history[1] = pot.history[2];
+    pot.history[2] = mean;
+    int med = median3(pot.history[0], pot.history[1], pot.history[2]);
+
+    // One-pole low-pass in Q4 (1/4 per update, ~50 ms time constant at 78 Hz)
+    if (pot.filtered < 0) {
+      pot.filtered = med << FILTER_SHIFT;
+    }
+    pot.filtered += ((med << FILTER_SHIFT) - pot.filtered) / 4;
+    int value = pot.filtered >> FILTER_SHIFT;
+    pot.value.store((uint16_t)value, std::memory_order_relaxed);
+
+    if (pot.zones > 0) {
+      pot.zone.store((uint8_t)updateZone(pot.zone.load(std::memory_order_relaxed), value,
+                                         pot.zones, pot.hysteresis),
+                     std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * Zone with hysteresis: the value must pass a boundary by 'hysteresis'
+   * counts before the zone changes
+   */
+  static int updateZone(int zone, int value, int zones, int hysteresis) {
+    const int span = (ADC_MAX + 1) / zones;
+    int lower = zone * span - hysteresis;             // Leave downwards below this
+    int upper = (zone + 1) * span + hysteresis;       // Leave upwards at or above this
+    if (value >= lower && value < upper) {
+      return zone;
+    }
+    int next = value / span;
+    return (next >= zones) ? zones - 1 : next;
+  }
+
+  /**
+   * Averaged oneshot reads (pins the DMA driver cannot stream)
+   */
+  int readOneshot(const Pot& pot) {
+    int sum = 0;
+    for (int i = 0; i < FALLBACK_OVERSAMPLE; i++) {
+      sum += analogRead(pot.pin);
+    }
+    return sum / FALLBACK_OVERSAMPLE;
+  }
+
+  static void taskEntry(void* arg) {
+    ((PotSampler*)arg)->run();
+  }
+
+  /**
+   * Filter task: wait for a DMA frame (or the control period), decimate,
+   * and publish every pot
+   */
+  void run() {
+    const TickType_t period = pdMS_TO_TICKS((FRAME_SAMPLES * 1000) / SAMPLE_RATE_HZ);
+
+    while (true) {
+      bool gotFrame = false;
+#if POT_SAMPLER_DMA_AVAILABLE
+      gotFrame = readDmaFrame();
+#endif
+      if (!gotFrame) {
+        vTaskDelay(period > 0 ? period : 1);
+      }
+
+      for (int i = 0; i < _numPots; i++) {
+        if (!_pots[i].useDma) {
+          publish(_pots[i], readOneshot(_pots[i]));
+        }
+      }
+    }
+  }
+
+#if POT_SAMPLER_DMA_AVAILABLE
+  static const int RESULT_BYTES = SOC_ADC_DIGI_RESULT_BYTES;
+  static const int FRAME_BYTES = FRAME_SAMPLES * RESULT_BYTES;
+
+  adc_continuous_handle_t _adcHandle;
+  uint8_t _frame[FRAME_BYTES];
+
+  /**
+   * Put every ADC1 pot into one DMA conversion pattern and start it
+   */
+  void startDma() {
+    adc_digi_pattern_config_t patterns[MAX_POTS] = {};
+    int numPatterns = 0;
+
+    for (int i = 0; i < _numPots; i++) {
+      adc_unit_t unit;
+      adc_channel_t channel;
+      if (adc_continuous_io_to_channel(_pots[i].pin, &unit, &channel) != ESP_OK ||
+          unit != ADC_UNIT_1) {
+        continue;  // Not streamable - oneshot fallback
+      }
+
+      adc_digi_pattern_config_t& p = patterns[numPatterns++];
+      p.atten = ADC_ATTEN_DB_12;  // Full 0-3.3 V wiper range
+      p.channel = (uint8_t)channel;
+      p.unit = ADC_UNIT_1;
+      p.bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+      _pots[i].channel = (int)channel;
+      _pots[i].useDma = true;
+    }
+
+    if (numPatterns == 0) {
+      return;
+    }
+
+    adc_continuous_handle_cfg_t handleConfig = {};
+    handleConfig.max_store_buf_size = FRAME_BYTES * 4;
+    handleConfig.conv_frame_size = FRAME_BYTES;
+
+    adc_continuous_config_t config = {};
+    config.pattern_num = numPatterns;
+    config.adc_pattern = patterns;
+    config.sample_freq_hz = SAMPLE_RATE_HZ;
+    config.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+#if SOC_ADC_DIGI_RESULT_BYTES == 2
+    config.format = ADC_DIGI_OUTPUT_FORMAT_TYPE1;
+#else
+    config.format = ADC_DIGI_OUTPUT_FORMAT_TYPE2;
+#endif
+
+    esp_err_t err = adc_continuous_new_handle(&handleConfig, &_adcHandle);
+    if (err == ESP_OK) err = adc_continuous_config(_adcHandle, &config);
+    if (err == ESP_OK) err = adc_continuous_start(_adcHandle);
+
+    if (err != ESP_OK) {
+      Serial.printf("PotSampler: DMA sampling unavailable (%d), using oneshot reads\n", err);
+      if (_adcHandle != nullptr) {
+        adc_continuous_deinit(_adcHandle);
+        _adcHandle = nullptr;
+      }
+      for (int i = 0; i < _numPots; i++) {
+        _pots[i].useDma = false;
+      }
+      return;
+    }
+
+    _numDmaPots = numPatterns;
+  }
+
+  /**
+   * Block until the next DMA frame, then publish the mean of each channel
+   * @return true if a frame was processed
+   */
+  bool readDmaFrame() {
+    if (_adcHandle == nullptr) {
+      return false;
+    }
+
+    uint32_t length = 0;
+    if (adc_continuous_read(_adcHandle, _frame, FRAME_BYTES, &length, 100) != ESP_OK) {
+      return false;
+    }
+
+    // Oversampling: average every sample of each channel in the frame
+    int32_t sums[MAX_POTS] = {};
+    int counts[MAX_POTS] = {};
+    for (uint32_t offset = 0; offset + RESULT_BYTES <= length; offset += RESULT_BYTES) {
+      const adc_digi_output_data_t* result = (const adc_digi_output_data_t*)&_frame[offset];
+#if SOC_ADC_DIGI_RESULT_BYTES == 2
+      int channel = result->type1.channel;
+      int data = result->type1.data;
+#else
+      int channel = result->type2.channel;
+      int data = result->type2.data;
+#endif
+      for (int i = 0; i < _numPots; i++) {
+        if (_pots[i].useDma && _pots[i].channel == channel) {
+          sums[i] += data;
+          counts[i]++;
+          break;
+        }
+      }
+    }
+
+    for (int i = 0; i < _numPots; i++) {
+      if (_pots[i].useDma && counts[i] > 0) {
+        publish(_pots[i], (int)(sums[i] / counts[i]));
+      }
+    }
+    return true;
+  }
+#endif // POT_SAMPLER_DMA_AVAILABLE
+};
+
+#endif // POT_SAMPLER_H
@@ -0,0 +1,157 @@
+/**
+ * PowerManager.h
+ *
+ * Active / idle power state of the synth. While the output is silent the
+ * audio task stops rendering voices and reports idle here; the manager then
+ * drops its CPU-frequency lock so ESP-IDF dynamic frequency scaling can run
+ * the cores at the minimum clock, and takes it again the moment sound
+ * resumes. I2S keeps its own APB lock, so the audio clock never moves.
+ *
+ * DFS needs CONFIG_PM_ENABLE in the IDF build; without it the state is still
+ * tracked (and shown by the console) but the clock stays at maximum.
+ */
+
+#ifndef POWERMANAGER_H
+#define POWERMANAGER_H
+
+#include <Arduino.h>
+#if __has_include("esp_pm.h")
+#include "esp_pm.h"
+#define POWER_MANAGER_HAS_PM 1
+#else
+#define POWER_MANAGER_HAS_PM 0
+#endif
+
+// ========== PowerManager Class ==========
+class PowerManager {
+public:
+  /**
+   * Constructor - active, no frequency scaling until begin()
+   */
+  PowerManager() :
+#if POWER_MANAGER_HAS_PM
+    _lock(nullptr),
+#endif
+    _dfsEnabled(false),
+    _maxMhz(0),
+    _minMhz(0),
+    _idle(false),
+    _transitions(0),
+    _idleSinceMs(0),
+    _idleTotalMs(0),
+    _startMs(0) {
+  }
+
+  /**
+   * Configure dynamic frequency scaling and hold the maximum clock
+   * @param maxMhz CPU clock while rendering
+   * @param minMhz CPU clock while idle
+   * @return true if DFS is available (false = state tracking only)
+   */
+  bool begin(int maxMhz, int minMhz) {
+    _maxMhz = maxMhz;
+    _minMhz = minMhz;
+    _startMs = millis();
+#if POWER_MANAGER_HAS_PM
+    esp_pm_config_t config = {};
+    config.max_freq_mhz = maxMhz;
+    config.min_freq_mhz = minMhz;
+    config.light_sleep_enable = false;  // Light sleep would stop the I2S clock
+    esp_err_t err = esp_pm_configure(&config);
+    if (err == ESP_OK) {
+      err = esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "synth", &_lock);
+    }
+    if (err != ESP_OK) {
+      Serial.printf("Power: DFS unavailable (%d), clock stays at maximum\n", err);
+      return false;
+    }
+    esp_pm_lock_acquire(_lock);
+    _dfsEnabled = true;
+#else
+    Serial.println("Power: No esp_pm, clock stays at maximum");
+#endif
+    return _dfsEnabled;
+  }
+
+  /**
+   * Enter or leave idle (audio task only)
+   */
+  void setIdle(bool idle) {
+    if (idle == _idle) {
+      return;
+    }
+    uint32_t now = millis();
+#if POWER_MANAGER_HAS_PM
+    if (_dfsEnabled) {
+      if (idle) {
+        esp_pm_lock_release(_lock);
+      } else {
+        esp_pm_lock_acquire(_lock);
+      }
+    }
+#endif
+    if (idle) {
+      _idleSinceMs = now;
+    } else {
+      _idleTotalMs += now - _idleSinceMs;
+    }
+    _idle = idle;
+    _transitions++;
+  }
+
+  bool isIdle() const {
+    return _idle;
+  }
+
+  bool isDfsEnabled() const {
+    return _dfsEnabled;
+  }
+
+  /**
+   * Get the CPU clock the current state asks for (MHz)
+   */
+  int getTargetMhz() const {
+    return (_idle && _dfsEnabled) ? _minMhz : _maxMhz;
+  }
+
+  /**
+   * Get the number of active/idle switches since begin()
+   */
+  uint32_t getTransitions() const {
+    return _transitions;
+  }
+
+  /**
+   * Get the time spent idle since begin(), including the current stretch
+   */
+  uint32_t getIdleMillis() const {
+    uint32_t total = _idleTotalMs;
+    if (_idle) {
+      total += millis() - _idleSinceMs;
+    }
+    return total;
+  }
+
+  /**
+   * Get the share of time spent idle since begin() (0-100)
+   */
+  int getIdlePercent() const {
+    uint32_t uptime = millis() - _startMs;
+    return (uptime == 0) ? 0 : (int)((uint64_t)getIdleMillis() * 100 / uptime);
+  }
+
+private:
+#if POWER_MANAGER_HAS_PM
+  esp_pm_lock_handle_t _lock;
+#endif
+  bool _dfsEnabled;
+  int _maxMhz;
+  int _minMhz;
+  volatile bool _idle;
+  volatile uint32_t _transitions;
+  volatile uint32_t _idleSinceMs;
+  volatile uint32_t _idleTotalMs;
+  uint32_t _startMs;
+};
+
+#endif // POWERMANAGER_H
@@ -0,0 +1,199 @@
+/**
+ * SampleBank.h
+ *
+ * Read-only bank of PCM instrument samples, memory-mapped instead of loaded.
+ * On the ESP32 the bank is the "samples" data partition (see partitions.csv)
+ * mapped with esp_partition_mmap: the sampler reads it zero-copy through the
+ * flash cache and no RAM holds sample data. On a host build the same bank
+ * is a regular file mapped with mmap(), so playback can be tested on Linux.
+ *
+ * Bank layout (little-endian, written by tools/make_sample_bank.py):
+ *   header   "CSB1", uint32 sample count
+ *   entries  SampleBankEntry per sample
+ *   data     16-bit mono PCM per sample, followed by one guard frame (a copy
+ *            of the loop start, or 0 for a one-shot), so interpolation can
+ *            always read the next frame without a bounds check
+ */
+
+#ifndef SAMPLEBANK_H
+#define SAMPLEBANK_H
+
+#include <Arduino.h>
+#if __has_include("esp_partition.h")
+#include "esp_partition.h"
+#define SAMPLE_BANK_FLASH 1
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SAMPLE_BANK_FLASH 0
+#endif
+
+// ========== Bank Format ==========
+struct SampleBankEntry {
+  char name[16];        // NUL-terminated
+  uint32_t offset;      // Byte offset of the PCM data from the bank start (even)
+  uint32_t frames;      // Playable frames (the guard frame follows)
+  uint32_t loopStart;   // Loop runs loopStart..frames; frames = one-shot
+  uint32_t rootHzQ8;    // Pitch recorded in the sample (Hz Q8)
+  uint32_t sampleRate;  // Rate the sample was recorded at
+};
+
+// ========== Mapped Sample ==========
+struct PcmSample {
+  const char* name;
+  const int16_t* data;  // frames + 1 frames (guard included)
+  uint32_t frames;
+  uint32_t loopStart;
+  uint32_t rootHzQ8;
+  uint32_t sampleRate;
+
+  bool isLooped() const {
+    return loopStart < frames;
+  }
+};
+
+// ========== SampleBank Class ==========
+class SampleBank {
+public:
+  static const int MAX_SAMPLES = 16;
+  static constexpr uint32_t MAGIC = 0x31425343;  // "CSB1"
+
+  /**
+   * Constructor - empty until begin()
+   */
+  SampleBank() :
+#if SAMPLE_BANK_FLASH
+    _handle(0),
+#endif
+    _base(nullptr),
+    _size(0),
+    _count(0) {
+  }
+
+  ~SampleBank() {
+    end();
+  }
+
+  /**
+   * Map the bank and index its samples
+   * @param source Partition label (ESP32) or file path (host)
+   * @return false if the bank is missing or malformed (the bank stays empty)
+   */
+  bool begin(const char* source = "samples") {
+    end();
+#if SAMPLE_BANK_FLASH
+    const esp_partition_t* partition =
+      esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, source);
+    if (partition == nullptr) {
+      Serial.printf("Samples: no '%s' partition\n", source);
+      return false;
+    }
+    const void* mapped = nullptr;
+    if (esp_partition_mmap(partition, 0, partition->size, ESP_PARTITION_MMAP_DATA,
+                           &mapped, &_handle) != ESP_OK) {
+      Serial.println("Samples: partition mmap failed");
+      return false;
+    }
+    _base = (const uint8_t*)mapped;
+    _size = partition->size;
+#else
+    int fd = open(source, O_RDONLY);
+    if (fd < 0) {
+      Serial.printf("Samples: cannot open %s\n", source);
+      return false;
+    }
+    struct stat info;
+    void* mapped = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+      mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);  // The mapping keeps the file
+    if (mapped == MAP_FAILED) {
+      Serial.printf("Samples: cannot map %s\n", source);
+      return false;
+    }
+    _base = (const uint8_t*)mapped;
+    _size = info.st_size;
+#endif
+    if (!index()) {
+      Serial.println("Samples: bank is empty or malformed");
+      end();
+      return false;
+    }
+    Serial.printf("Samples: %d mapped (%u bytes)\n", _count, (unsigned)_size);
+    return true;
+  }
+
+  /**
+   * Unmap the bank (nothing may be playing from it)
+   */
+  void end() {
+    if (_base != nullptr) {
+#if SAMPLE_BANK_FLASH
+      esp_partition_munmap(_handle);
+#else
+      munmap((void*)_base, _size);
+#endif
+    }
+    _base = nullptr;
+    _size = 0;
+    _count = 0;
+  }
+
+  int getCount() const {
+    return _count;
+  }
+
+  /**
+   * Get a sample (nullptr if out of range)
+   */
+  const PcmSample* getSample(int index) const {
+    return (index >= 0 && index < _count) ? &_samples[index] : nullptr;
+  }
+
+private:
+#if SAMPLE_BANK_FLASH
+  esp_partition_mmap_handle_t _handle;
+#endif
+  const uint8_t* _base;
+  size_t _size;
+  int _count;
+  PcmSample _samples[MAX_SAMPLES];
+
+  /**
+   * Validate the header and every entry; nothing past the bank is ever read
+   */
+  bool index() {
+    const uint32_t* header = (const uint32_t*)_base;
+    if (_size < 8 || header[0] != MAGIC || header[1] == 0 || header[1] > MAX_SAMPLES) {
+      return false;
+    }
+    uint32_t count = header[1];
+    if (8 + count * sizeof(SampleBankEntry) > _size) {
+      return false;
+    }
+
+    const SampleBankEntry* entries = (const SampleBankEntry*)(_base + 8);
+    for (uint32_t i = 0; i < count; i++) {
+      const SampleBankEntry& entry = entries[i];
+      uint64_t end = (uint64_t)entry.offset + ((uint64_t)entry.frames + 1) * sizeof(int16_t);
+      if ((entry.offset & 1) || entry.frames == 0 || end > _size || entry.loopStart > entry.frames ||
+          entry.rootHzQ8 == 0 || entry.sampleRate == 0 || memchr(entry.name, 0, sizeof(entry.name)) == nullptr) {
+        return false;
+      }
+      PcmSample& sample = _samples[i];
+      sample.name = entry.name;
+      sample.data = (const int16_t*)(_base + entry.offset);
+      sample.frames = entry.frames;
+      sample.loopStart = entry.loopStart;
+      sample.rootHzQ8 = entry.rootHzQ8;
+      sample.sampleRate = entry.sampleRate;
+    }
+    _count = count;
+    return true;
+  }
+};
+
+#endif // SAMPLEBANK_H
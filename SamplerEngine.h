@@ -0,0 +1,190 @@
+/**
+ * SamplerEngine.h
+ *
+ * PCM sample voices for the chord modes. Each chord note plays the selected
+ * SampleBank sample, read in place from the mapped bank. Pitch comes from a
+ * 32.32 fixed-point read position: the step per output sample is the note
+ * frequency over the sample's root, times the sample rate over the render
+ * rate, so transposition, pitch bend and oversampling are just another step.
+ * Neighbouring frames are linearly interpolated; the guard frame after every
+ * sample means the second read never needs a bounds check.
+ *
+ * Looped samples sustain between loopStart and their end; one-shots play
+ * once and fall silent until the next trigger (chord change or reset).
+ * Integer only, in both engine builds.
+ */
+
+#ifndef SAMPLERENGINE_H
+#define SAMPLERENGINE_H
+
+#include <Arduino.h>
+#include "SynthConfig.h"
+#include "SampleBank.h"
+
+// ========== SamplerEngine Class ==========
+template <class Config>
+class BasicSamplerEngine {
+private:
+  typedef typename Config::Sample Sample;
+  static constexpr int NOTES = Config::CHORD_NOTES;
+
+  struct Voice {
+    uint32_t position;  // Frame index
+    uint32_t fraction;  // Between position and position + 1 (2^32 = one frame)
+    uint32_t stepFrames;
+    uint32_t stepFraction;
+    bool playing;
+  };
+
+  Voice voices[NOTES];
+  uint32_t noteIncrements[NOTES];  // Note fundamentals (2^32 = one cycle per output sample)
+  const PcmSample* sample;
+
+  void calculateSteps() {
+    for (int n = 0; n < NOTES; n++) {
+      uint64_t step = 0;
+      if (sample != nullptr) {
+        // (f / renderRate) * 2^32 * sampleRate / root = read frames per output sample, Q32
+        step = (uint64_t)noteIncrements[n] * sample->sampleRate * 256 / sample->rootHzQ8;
+      }
+      voices[n].stepFrames = (uint32_t)(step >> 32);
+      voices[n].stepFraction = (uint32_t)step;
+    }
+  }
+
+  /**
+   * Past the end: wrap into the loop, or stop a one-shot
+   */
+  void wrap(Voice& voice) {
+    if (sample->isLooped()) {
+      uint32_t loopLength = sample->frames - sample->loopStart;
+      voice.position = sample->loopStart + (voice.position - sample->loopStart) % loopLength;
+    } else {
+      voice.playing = false;
+    }
+  }
+
+public:
+  /**
+   * Constructor - no sample, silent
+   */
+  BasicSamplerEngine() : sample(nullptr) {
+    for (int n = 0; n < NOTES; n++) {
+      noteIncrements[n] = 0;
+    }
+    trigger();
+    calculateSteps();
+  }
+
+  /**
+   * Select the sample all notes play and restart them
+   * @param newSample Sample from a SampleBank (nullptr = silence)
+   */
+  void setSample(const PcmSample* newSample) {
+    sample = newSample;
+    calculateSteps();
+    trigger();
+  }
+
+  const PcmSample* getSample() const {
+    return sample;
+  }
+
+  /**
+   * Set the fundamental of each chord note
+   * @param increments Per-sample phase steps, 2^32 = one cycle
+   */
+  void setNoteIncrements(const uint32_t increments[NOTES]) {
+    for (int n = 0; n < NOTES; n++) {
+      noteIncrements[n] = increments[n];
+    }
+    calculateSteps();
+  }
+
+  /**
+   * Restart every note from the first frame
+   */
+  void trigger() {
+    for (int n = 0; n < NOTES; n++) {
+      voices[n].position = 0;
+      voices[n].fraction = 0;
+      voices[n].playing = (sample != nullptr);
+    }
+  }
+
+  /**
+   * Render mixed chord samples
+   */
+  void render(Sample* out, int frames) {
+    if (sample == nullptr) {
+      memset(out, 0, frames * sizeof(Sample));
+      return;
+    }
+
+    const int16_t* data = sample->data;
+    const uint32_t end = sample->frames;
+    const int32_t voiceAmplitude = Config::MAX_AMPLITUDE / NOTES;
+    for (int i = 0; i < frames; i++) {
+      int32_t mix = 0;
+      for (int n = 0; n < NOTES; n++) {
+        Voice& voice = voices[n];
+        if (!voice.playing) {
+          continue;
+        }
+        // Linear interpolation on the top 15 bits of the fraction
+        int32_t a = data[voice.position];
+        int32_t b = data[voice.position + 1];  // Guard frame at the end
+        mix += a + (((b - a) * (int32_t)(voice.fraction >> 17)) >> 15);
+
+        uint32_t fraction = voice.fraction + voice.stepFraction;
+        voice.position += voice.stepFrames + (fraction < voice.fraction);  // Carry
+        voice.fraction = fraction;
+        if (voice.position >= end) {
+          wrap(voice);
+        }
+      }
+      out[i] = (Sample)((mix * voiceAmplitude) >> 15);
+    }
+  }
+
+  /**
+   * Advance every note as if frames samples had been rendered
+   */
+  void advance(uint32_t frames) {
+    if (sample == nullptr) {
+      return;
+    }
+    for (int n = 0; n < NOTES; n++) {
+      Voice& voice = voices[n];
+      if (!voice.playing) {
+        continue;
+      }
+      uint64_t step = ((uint64_t)voice.stepFrames << 32) | voice.stepFraction;
+      uint64_t target = (((uint64_t)voice.position << 32) | voice.fraction) + step * frames;
+      voice.fraction = (uint32_t)target;
+      if ((target >> 32) >= sample->frames) {
+        if (!sample->isLooped()) {
+          voice.playing = false;
+          continue;
+        }
+        uint32_t loopLength = sample->frames - sample->loopStart;
+        target = sample->loopStart + ((target >> 32) - sample->loopStart) % loopLength;
+      } else {
+        target >>= 32;
+      }
+      voice.position = (uint32_t)target;
+    }
+  }
+
+  /**
+   * Restart every note (chord players call this on reset)
+   */
+  void reset() {
+    trigger();
+  }
+};
+
+// Engine sampler voices (configuration chosen at build time, see SynthConfig.h)
+typedef BasicSamplerEngine<SynthEngineConfig> SamplerEngine;
+
+#endif // SAMPLERENGINE_H
@@ -0,0 +1,152 @@
+/*
+ * Scope.h - Oscilloscope display component
+ * 
+ * Draws a trigger-aligned trace of the real audio output, read from the
+ * AudioRingBuffer that the audio task fills with a decimated copy of every
+ * buffer it sends to I2S.
+ */
+
+#ifndef SCOPE_H
+#define SCOPE_H
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+#include <Adafruit_SSD1306.h>
+#include "AudioRingBuffer.h"
+
+/**
+ * Scope - Oscilloscope trace for OLED displays
+ * 
+ * Features:
+ * - Rising zero-crossing trigger with hysteresis for a stable trace
+ * - Free-running fallback when no trigger is found (e.g. silence)
+ * - Integer-only sample to pixel mapping (no float or trig per pixel)
+ */
+class Scope {
+public:
+  static const int MAX_WIDTH = 128;       // Widest supported trace in pixels
+  static const int TRIGGER_SEARCH = 256;  // Samples searched for a trigger point
+
+  /**
+   * Constructor
+   */
+  Scope() :
+    _display(nullptr),
+    _ring(nullptr),
+    _x(0),
+    _centerY(0),
+    _width(0),
+    _halfHeight(0),
+    _fullScale(1),
+    _hysteresis(0),
+    _triggered(false) {
+  }
+
+  /**
+   * Initialize the scope with display, source and geometry
+   * 
+   * @param display Pointer to Adafruit_SSD1306 display object
+   * @param ring Ring buffer filled by the audio task
+   * @param x Left edge of the trace
+   * @param centerY Y coordinate of the zero line
+   * @param width Trace width in pixels (one sample per pixel, max MAX_WIDTH)
+   * @param halfHeight Pixels from zero line to full scale
+   * @param fullScale Sample value drawn at halfHeight
+   */
+  void init(Adafruit_SSD1306* display, AudioRingBuffer* ring, int x, int centerY,
+            int width, int halfHeight, int16_t fullScale) {
+    _display = display;
+    _ring = ring;
+    _x = x;
+    _centerY = centerY;
+    _width = min(width, (int)MAX_WIDTH);
+    _halfHeight = halfHeight;
+    _fullScale = (fullScale > 0) ? fullScale : 1;
+    _hysteresis = _fullScale / 32;  // Ignore crossings smaller than ~3% of full scale
+  }
+
+  /**
+   * Draw the latest audio as a trigger-aligned trace
+   * 
+   * @return true if a trigger point was found, false if free-running
+   */
+  bool draw() {
+    if (_display == nullptr || _ring == nullptr || _width < 2) {
+      return false;
+    }
+    
+    int count = _ring->readLatest(_window, TRIGGER_SEARCH + _width);
+    if (count < _width) {
+      return false;  // Not enough audio yet
+    }
+    
+    int start = findTrigger(count - _width);
+    _triggered = (start >= 0);
+    if (start < 0) {
+      start = count - _width;  // Free-run on the most recent samples
+    }
+    
+    int prevY = sampleToY(_window[start]);
+    for (int i = 1; i < _width; i++) {
+      int y = sampleToY(_window[start + i]);
+      _display->drawLine(_x + i - 1, prevY, _x + i, y, SSD1306_WHITE);
+      prevY = y;
+    }
+    
+    return _triggered;
+  }
+
+  /**
+   * Check whether the last draw() found a trigger point
+   */
+  bool isTriggered() const {
+    return _triggered;
+  }
+
+private:
+  Adafruit_SSD1306* _display;
+  AudioRingBuffer* _ring;
+
+  // Geometry
+  int _x;
+  int _centerY;
+  int _width;
+  int _halfHeight;
+  int16_t _fullScale;
+  int16_t _hysteresis;
+
+  // Trigger state
+  bool _triggered;
+
+  // Latest samples (trigger search area + one screen width)
+  int16_t _window[TRIGGER_SEARCH + MAX_WIDTH];
+
+  /**
+   * Find a rising zero crossing that was preceded by a dip below -hysteresis
+   * 
+   * @param searchLength Number of candidate start positions
+   * @return Index of the trigger sample, or -1 if none
+   */
+  int findTrigger(int searchLength) {
+    bool armed = false;
+    for (int i = 0; i < searchLength; i++) {
+      if (_window[i] < -_hysteresis) {
+        armed = true;
+      } else if (armed && _window[i] >= 0) {
+        return i;
+      }
+    }
+    return -1;
+  }
+
+  /**
+   * Map a sample to a screen row (clamped to the trace area)
+   */
+  int sampleToY(int16_t sample) const {
+    int offset = ((int32_t)sample * _halfHeight) / _fullScale;
+    offset = constrain(offset, -_halfHeight, _halfHeight);
+    return _centerY - offset;
+  }
+};
+
+#endif // SCOPE_H
@@ -0,0 +1,200 @@
+/**
+ * SerialConsole.h
+ *
+ * Line-oriented command console on a Stream (the USB serial port). A
+ * low-priority task collects characters into a fixed line buffer, splits a
+ * finished line into words and calls the matching handler from a command
+ * table. Handlers only queue changes (the sketch routes them through
+ * sendParam), so typing a command never touches the audio engine directly.
+ *
+ * Every command answers with "ok" or "error: ..." on its last line, so bench
+ * runs can be scripted from a host (or the simulator's serial monitor).
+ */
+
+#ifndef SERIALCONSOLE_H
+#define SERIALCONSOLE_H
+
+#include <Arduino.h>
+#include <string.h>
+
+// ========== Console Command ==========
+struct ConsoleCommand {
+  const char* name;   // First word of the line
+  const char* usage;  // Arguments, shown by help and on a bad call
+  const char* help;   // One-line description
+  bool (*handler)(int argc, char* argv[]);  // argv[0] is the command; false = bad arguments
+};
+
+// ========== SerialConsole Class ==========
+class SerialConsole {
+public:
+  static const int MAX_LINE = 64;   // Longer lines are rejected, not truncated
+  static const int MAX_ARGS = 6;
+  static const int POLL_MS = 20;    // Idle poll period of the console task
+
+  /**
+   * Constructor
+   */
+  SerialConsole() :
+    _stream(nullptr),
+    _commands(nullptr),
+    _numCommands(0),
+    _length(0),
+    _overflow(false),
+    _linesExecuted(0) {
+  }
+
+  /**
+   * Attach the command table without starting a task (feed() drives it)
+   * @param stream Where replies are printed
+   * @param commands Command table (must outlive the console)
+   * @param numCommands Number of entries in commands
+   */
+  void init(Stream& stream, const ConsoleCommand* commands, int numCommands) {
+    _stream = &stream;
+    _commands = commands;
+    _numCommands = numCommands;
+    _length = 0;
+    _overflow = false;
+  }
+
+  /**
+   * Attach the command table and start the console task
+   * @param stream Serial port to read commands from and print replies to
+   * @param commands Command table (must outlive the console)
+   * @param numCommands Number of entries in commands
+   * @param core Core for the console task
+   * @param priority Console task priority (below audio, display and input)
+   * @return true if the task was created
+   */
+  bool begin(Stream& stream, const ConsoleCommand* commands, int numCommands,
+             int core, UBaseType_t priority) {
+    init(stream, commands, numCommands);
+    if (xTaskCreatePinnedToCore(taskEntry, "Console", 4096, this, priority,
+                                nullptr, core) != pdPASS) {
+      Serial.println("Console: Failed to create task");
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * Feed one received character
+   * @return true if it completed a line that was executed
+   */
+  bool feed(char c) {
+    if (c == '\r' || c == '\n') {
+      if (_overflow) {
+        _overflow = false;
+        _length = 0;
+        reply("error: line too long");
+        return false;
+      }
+      if (_length == 0) {
+        return false;  // Blank line (or the \n of a \r\n pair)
+      }
+      _line[_length] = '\0';
+      _length = 0;
+      execute(_line);
+      return true;
+    }
+
+    if (c == '\b' || c == 0x7F) {
+      if (_length > 0) _length--;
+      return false;
+    }
+
+    if (_length < MAX_LINE) {
+      _line[_length++] = c;
+    } else {
+      _overflow = true;
+    }
+    return false;
+  }
+
+  /**
+   * Run one command line (modified in place by the tokenizer)
+   */
+  void execute(char* line) {
+    char* argv[MAX_ARGS];
+    int argc = 0;
+
+    char* word = strtok(line, " \t");
+    while (word != nullptr && argc < MAX_ARGS) {
+      argv[argc++] = word;
+      word = strtok(nullptr, " \t");
+    }
+    if (argc == 0) {
+      return;
+    }
+    _linesExecuted++;
+
+    if (strcmp(argv[0], "help") == 0) {
+      printHelp();
+      reply("ok");
+      return;
+    }
+
+    for (int i = 0; i < _numCommands; i++) {
+      const ConsoleCommand& command = _commands[i];
+      if (strcmp(argv[0], command.name) != 0) {
+        continue;
+      }
+      if (command.handler(argc, argv)) {
+        reply("ok");
+      } else {
+        _stream->printf("error: usage: %s %s\n", command.name, command.usage);
+      }
+      return;
+    }
+
+    _stream->printf("error: unknown command '%s' (try help)\n", argv[0]);
+  }
+
+  /**
+   * List every command with its arguments
+   */
+  void printHelp() {
+    for (int i = 0; i < _numCommands; i++) {
+      _stream->printf("  %-10s %-18s %s\n", _commands[i].name, _commands[i].usage, _commands[i].help);
+    }
+  }
+
+  /**
+   * Get the number of command lines run since begin()
+   */
+  uint32_t getLinesExecuted() const {
+    return _linesExecuted;
+  }
+
+private:
+  Stream* _stream;
+  const ConsoleCommand* _commands;
+  int _numCommands;
+  char _line[MAX_LINE + 1];
+  int _length;
+  bool _overflow;
+  uint32_t _linesExecuted;
+
+  static void taskEntry(void* arg) {
+    ((SerialConsole*)arg)->run();
+  }
+
+  /**
+   * Console task: drain received characters, sleep when there are none
+   */
+  void run() {
+    while (true) {
+      while (_stream->available() > 0) {
+        feed((char)_stream->read());
+      }
+      vTaskDelay(pdMS_TO_TICKS(POLL_MS));
+    }
+  }
+
+  void reply(const char* text) {
+    _stream->println(text);
+  }
+};
+
+#endif // SERIALCONSOLE_H
@@ -0,0 +1,162 @@
+/*
+ * Spectrum.h - Spectrum analyzer display component
+ * 
+ * Runs a fixed-point real FFT over the latest window of the audio tap and
+ * draws log-spaced bars with falling peaks. Runs entirely in the display
+ * task on Core 0; the audio task only pays for the ring buffer write.
+ */
+
+#ifndef SPECTRUM_H
+#define SPECTRUM_H
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+#include <Adafruit_SSD1306.h>
+#include "AudioRingBuffer.h"
+#include "FixedFFT.h"
+
+/**
+ * Spectrum - Log-frequency bar spectrum for OLED displays
+ * 
+ * Features:
+ * - 512-point Hann-windowed fixed-point real FFT; bins are tap rate / 512
+ *   wide (audio rate / SCOPE_DECIMATION: ~43 Hz at the 44.1 kHz default)
+ * - Bars spaced logarithmically from bin 2 (~86 Hz at the default) to the tap's Nyquist
+ * - Integer log2 magnitude scale (about 0.75 dB per step)
+ * - Bars fall back gradually for a readable display
+ */
+class Spectrum {
+public:
+  static const int FFT_SIZE = 512;
+  static const int NUM_BARS = 32;
+
+  /**
+   * Constructor
+   */
+  Spectrum() :
+    _display(nullptr),
+    _ring(nullptr),
+    _x(0),
+    _bottomY(0),
+    _barWidth(1),
+    _height(0) {
+  }
+
+  /**
+   * Initialize the spectrum with display, source and geometry
+   * Computes the bar-to-bin mapping once (the only float math in this class)
+   * 
+   * @param display Pointer to Adafruit_SSD1306 display object
+   * @param ring Ring buffer filled by the audio task
+   * @param x Left edge of the bars
+   * @param bottomY Baseline of the bars
+   * @param width Total width in pixels (divided among NUM_BARS)
+   * @param height Bar height at full scale
+   */
+  void init(Adafruit_SSD1306* display, AudioRingBuffer* ring, int x, int bottomY,
+            int width, int height) {
+    _display = display;
+    _ring = ring;
+    _x = x;
+    _bottomY = bottomY;
+    _barWidth = max(1, width / NUM_BARS);
+    _height = height;
+    
+    // Log-spaced bin edges from bin 2 to the last bin below Nyquist
+    const float firstBin = 2.0f;
+    const float lastBin = (float)(FixedFFT<FFT_SIZE>::BINS - 1);
+    for (int b = 0; b <= NUM_BARS; b++) {
+      float edge = firstBin * powf(lastBin / firstBin, (float)b / NUM_BARS);
+      _barEdges[b] = (uint16_t)edge;
+    }
+    for (int b = 1; b <= NUM_BARS; b++) {
+      if (_barEdges[b] <= _barEdges[b - 1]) {
+        _barEdges[b] = _barEdges[b - 1] + 1;  // Every bar covers at least one bin
+      }
+    }
+    
+    for (int b = 0; b < NUM_BARS; b++) {
+      _barLevels[b] = 0;
+    }
+  }
+
+  /**
+   * Analyze the latest audio window and draw the bars
+   * 
+   * @return true if a full window was available
+   */
+  bool draw() {
+    if (_display == nullptr || _ring == nullptr) {
+      return false;
+    }
+    
+    bool fresh = (_ring->readLatest(_window, FFT_SIZE) == FFT_SIZE);
+    if (fresh) {
+      _fft.powerSpectrum(_window, _power);
+    }
+    
+    for (int b = 0; b < NUM_BARS; b++) {
+      int level = 0;
+      if (fresh) {
+        uint32_t peak = 0;
+        for (int k = _barEdges[b]; k < _barEdges[b + 1]; k++) {
+          peak = max(peak, _power[k]);
+        }
+        level = powerToHeight(peak);
+      }
+      
+      // Rise instantly, fall back slowly
+      _barLevels[b] = max(level, _barLevels[b] - FALL_PER_FRAME);
+      if (_barLevels[b] > 0) {
+        int x = _x + b * _barWidth;
+        int width = (_barWidth > 1) ? _barWidth - 1 : 1;  // 1 px gap between bars
+        _display->fillRect(x, _bottomY - _barLevels[b], width, _barLevels[b], SSD1306_WHITE);
+      }
+    }
+    
+    return fresh;
+  }
+
+private:
+  static const int FALL_PER_FRAME = 2;   // Pixels a bar drops per frame
+  static const int FLOOR_LOG2Q3 = 8 * 6;  // Power below 2^6 draws nothing (noise floor)
+  static const int TOP_LOG2Q3 = 8 * 24;   // Power of a full-scale sine, ~(14000/4)^2
+
+  Adafruit_SSD1306* _display;
+  AudioRingBuffer* _ring;
+
+  // Geometry
+  int _x;
+  int _bottomY;
+  int _barWidth;
+  int _height;
+
+  // Analysis
+  FixedFFT<FFT_SIZE> _fft;
+  int16_t _window[FFT_SIZE];
+  uint32_t _power[FixedFFT<FFT_SIZE>::BINS];
+  uint16_t _barEdges[NUM_BARS + 1];
+  int _barLevels[NUM_BARS];
+
+  /**
+   * Integer log2 with 3 fractional bits (Q3)
+   */
+  static int log2Q3(uint32_t v) {
+    if (v == 0) return 0;
+    int whole = 31 - __builtin_clz(v);
+    uint32_t frac = (whole >= 3) ? (v >> (whole - 3)) : (v << (3 - whole));
+    return whole * 8 + (int)(frac & 7);
+  }
+
+  /**
+   * Map bin power to bar height on a log (dB) scale
+   */
+  int powerToHeight(uint32_t power) const {
+    int level = log2Q3(power) - FLOOR_LOG2Q3;
+    if (level <= 0) return 0;
+    int h = (level * _height) / (TOP_LOG2Q3 - FLOOR_LOG2Q3);
+    return min(h, _height);
+  }
+};
+
+#endif // SPECTRUM_H
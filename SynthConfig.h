@@ -0,0 +1,93 @@
+/**
+ * SynthConfig.h
+ *
+ * Compile-time engine configuration. Sample rate, wavetable size, unison
+ * depth, block size, sample format and number format (float or pure
+ * fixed point) are template parameters; everything
+ * derived from them (voice count, table mask, block time, per-voice headroom)
+ * is a constexpr member, and static_asserts reject inconsistent choices at
+ * build time. Oscillator, ChordPlayer and UnisonConfig are templates on this
+ * type, so their voice and table loops have constant trip counts.
+ *
+ * The build picks the engine configuration with -D flags, e.g.
+ *   arduino-cli compile --build-property "compiler.cpp.extra_flags=-DSYNTH_TABLE_BITS=10" ...
+ */
+
+#ifndef SYNTHCONFIG_H
+#define SYNTHCONFIG_H
+
+#include <stdint.h>
+#include <type_traits>
+#if __has_include("sdkconfig.h")
+#include "sdkconfig.h"  // CONFIG_IDF_TARGET_* for the engine default below
+#endif
+
+// ========== SynthConfig Template ==========
+template <int SampleRate, int TableBits, int MaxUnison, int BlockFrames, typename SampleType,
+          bool FixedPoint = false>
+struct SynthConfig {
+  // ----- Parameters -----
+  static constexpr int SAMPLE_RATE = SampleRate;
+  static constexpr int TABLE_BITS = TableBits;
+  static constexpr int MAX_UNISON = MaxUnison;      // Detuned copies per chord note
+  static constexpr int BLOCK_FRAMES = BlockFrames;  // Frames per I2S write
+  typedef SampleType Sample;
+  static constexpr bool FIXED_POINT = FixedPoint;  // Integer-only render path (no FPU needed)
+
+  // ----- Derived -----
+  static constexpr int TABLE_SIZE = 1 << TABLE_BITS;
+  static constexpr int TABLE_MASK = TABLE_SIZE - 1;
+  static constexpr int CHORD_NOTES = 3;
+  static constexpr int MAX_VOICES = CHORD_NOTES * MAX_UNISON;
+  static constexpr int CHANNELS = 2;                // Interleaved stereo
+  static constexpr int BLOCK_SAMPLES = BLOCK_FRAMES * CHANNELS;
+  static constexpr uint32_t BLOCK_MICROS = (uint32_t)((uint64_t)BLOCK_FRAMES * 1000000 / SAMPLE_RATE);
+
+  // Oscillator phase: table steps (float), or a 32-bit accumulator where
+  // 2^32 is one cycle and the top TABLE_BITS bits index the table
+  typedef typename std::conditional<FIXED_POINT, uint32_t, float>::type Phase;
+  static constexpr int PHASE_SHIFT = 32 - TABLE_BITS;
+
+  // Waveform peak: headroom below full scale so a full chord mix cannot clip
+  static constexpr int32_t FULL_SCALE = (int32_t)(((uint64_t)1 << (8 * sizeof(Sample) - 1)) - 1);
+  static constexpr Sample MAX_AMPLITUDE = (Sample)(FULL_SCALE * 14000LL / 32767);
+
+  // ----- Consistency checks -----
+  static_assert(SAMPLE_RATE >= 8000 && SAMPLE_RATE <= 96000, "Sample rate out of range");
+  static_assert(TABLE_BITS >= 6 && TABLE_BITS <= 12, "Wavetable must be 64 to 4096 entries");
+  static_assert(MAX_UNISON >= 1 && MAX_UNISON <= 8, "Unison depth must be 1 to 8");
+  static_assert(BLOCK_FRAMES >= 32 && (BLOCK_FRAMES & (BLOCK_FRAMES - 1)) == 0,
+                "Block size must be a power of two of at least 32 frames");
+  static_assert(BLOCK_MICROS >= 1000, "Blocks shorter than a FreeRTOS tick starve the other tasks");
+  static_assert(std::is_same<Sample, int16_t>::value,
+                "I2S channel, scope tap and spectrum take 16-bit samples");
+  static_assert(MAX_AMPLITUDE / MAX_VOICES > 0, "Too many voices for the sample format");
+};
+
+// ========== Build Selection ==========
+#ifndef SYNTH_SAMPLE_RATE
+#define SYNTH_SAMPLE_RATE 44100
+#endif
+#ifndef SYNTH_TABLE_BITS
+#define SYNTH_TABLE_BITS 8      // 256-entry wavetables
+#endif
+#ifndef SYNTH_MAX_UNISON
+#define SYNTH_MAX_UNISON 4
+#endif
+#ifndef SYNTH_BLOCK_FRAMES
+#define SYNTH_BLOCK_FRAMES 512  // 11.6 ms at 44.1 kHz
+#endif
+#ifndef SYNTH_FIXED_POINT
+// Parts without an FPU (RISC-V ESP32-C3/C6) default to the integer engine
+#if defined(CONFIG_IDF_TARGET_ESP32C3) || defined(CONFIG_IDF_TARGET_ESP32C6) || \
+    defined(CONFIG_IDF_TARGET_ESP32C2) || defined(CONFIG_IDF_TARGET_ESP32H2)
+#define SYNTH_FIXED_POINT 1
+#else
+#define SYNTH_FIXED_POINT 0
+#endif
+#endif
+
+typedef SynthConfig<SYNTH_SAMPLE_RATE, SYNTH_TABLE_BITS, SYNTH_MAX_UNISON,
+                    SYNTH_BLOCK_FRAMES, int16_t, SYNTH_FIXED_POINT> SynthEngineConfig;
+
+#endif // SYNTHCONFIG_H
@@ -0,0 +1,49 @@
+/**
+ * SynthParams.h
+ * 
+ * Parameter identifiers and the change message that control code (buttons,
+ * menu, dials) sends to the audio task. The audio task drains the queue at
+ * the start of each buffer and is the only code that touches the engine.
+ */
+
+#ifndef SYNTHPARAMS_H
+#define SYNTHPARAMS_H
+
+#include <Arduino.h>
+#include "LockFreeQueue.h"
+
+// ========== Parameter IDs ==========
+enum ParamId : uint8_t {
+  PARAM_NONE = 0,
+  PARAM_PLAY_MODE,       // PlayMode
+  PARAM_WAVEFORM,        // OscillatorType
+  PARAM_CHORD,           // Index into ChordLib::ALL_CHORDS
+  PARAM_PROGRESSION,     // Index into ChordLib::PROGRESSIONS
+  PARAM_UNISON_COUNT,    // 1-4 voices
+  PARAM_UNISON_DETUNE,   // 0-50 cents
+  PARAM_TEMPO,           // Internal progression tempo (BPM)
+  PARAM_OVERSAMPLE,      // Chord render oversampling (1 or 2)
+  PARAM_SAMPLE_RATE,     // Index into SAMPLE_RATES
+  PARAM_FM_PATCH,        // Index into FmLib::ALL_PATCHES
+  PARAM_FM_DEPTH,        // FM modulation depth, 0-200%
+  PARAM_ORGAN_PRESET,    // Index into OrganLib::ALL_REGISTRATIONS
+  PARAM_ORGAN_DRAWBARS,  // Nine drawbar digits, e.g. 888000000
+  PARAM_NOISE_COLOR,     // Noise one-pole color, 0 (white) - 100%
+  PARAM_SH_RATE,         // Sample-and-hold draws per second, 1-40
+  PARAM_SH_DEPTH,        // Sample-and-hold pitch modulation, 0-12 semitones
+  PARAM_SAMPLER_SLOT,    // Sample number in the SampleBank, 1-16
+  PARAM_LOOPER,          // LooperState to move the looper to
+  PARAM_COUNT
+};
+
+// ========== Parameter Change Message ==========
+struct ParamChange {
+  ParamId id;
+  int32_t value;
+  uint32_t timeUs;  // micros() when sent (queue latency metric)
+};
+
+// Control code -> audio task (multi-producer, audio task consumes)
+typedef LockFreeQueue<ParamChange, 32> ParamQueue;
+
+#endif // SYNTHPARAMS_H
@@ -2,16 +2,20 @@
  * UnisonConfig.h
  * 
  * Manages unison voice configuration and detuning calculations.
- * Provides dynamic detune spread based on voice count (1-4 voices)
- * with configurable detune amount (0-50 cents).
+ * Provides dynamic detune spread based on voice count (1 to the
+ * SynthConfig's MAX_UNISON, 4 by default) with configurable detune
+ * amount (0-50 cents).
  * 
  * Detuning patterns:
  * - 1 voice: [0] - no detune
  * - 2 voices: [-d, +d]
  * - 3 voices: [-d, 0, +d]
  * - 4 voices: [-1.5d, -0.5d, +0.5d, +1.5d]
+ * - more voices: evenly spaced d apart, centred on 0
  * 
  * Where d = baseDetuneCents (default: 7 cents, range: 0-50 cents)
+ * 
+ * Ratios are float, or Q20 integers (FixedPitch) in a fixed-point build.
  */
 
 #ifndef UNISONCONFIG_H
@@ -19,25 +23,34 @@
 
 #include <Arduino.h>
 #include <math.h>
+#include <type_traits>
+#include "SynthConfig.h"
+#include "FixedPitch.h"
 
 // ========== UnisonConfig Class ==========
-class UnisonConfig {
+template <class Config>
+class BasicUnisonConfig {
 public:
+  static constexpr int MAX_UNISON = Config::MAX_UNISON;
+  
+  // Frequency multiplier: float, or Q20 in a fixed-point build
+  typedef typename std::conditional<Config::FIXED_POINT, uint32_t, float>::type Ratio;
+  
   /**
    * Constructor - initializes with single voice (no unison) and default detune
    */
-  UnisonConfig() : unisonCount(1), baseDetuneCents(7.0f) {
+  BasicUnisonConfig() : unisonCount(1), baseDetuneCents(7) {
     recalculateRatios();
   }
   
   /**
-   * Set the number of unison voices (1-4)
+   * Set the number of unison voices (1-MAX_UNISON)
    * Automatically recalculates detune ratios
-   * @param count Number of voices (1 = no unison, 2-4 = unison active)
+   * @param count Number of voices (1 = no unison, 2+ = unison active)
    */
   void setUnisonCount(int count) {
     if (count < 1) count = 1;
-    if (count > 4) count = 4;
+    if (count > MAX_UNISON) count = MAX_UNISON;
     
     if (count != unisonCount) {
       unisonCount = count;
@@ -47,7 +60,7 @@ public:
   
   /**
    * Get the current unison voice count
-   * @return Number of voices (1-4)
+   * @return Number of voices (1-MAX_UNISON)
    */
   int getUnisonCount() const {
     return unisonCount;
@@ -57,7 +70,7 @@ public:
    * Get array of frequency multiplier ratios for each voice
    * @return Pointer to array of ratios (length = unisonCount)
    */
-  const float* getDetuneRatios() const {
+  const Ratio* getDetuneRatios() const {
     return detuneRatios;
   }
   
@@ -67,13 +80,12 @@ public:
    * @param cents Detune amount in cents (clamped to 0-50 range)
    * @return true if value was changed and ratios recalculated, false otherwise
    */
-  bool setBaseDetuneCents(float cents) {
+  bool setBaseDetuneCents(int cents) {
     // Clamp to reasonable range
-    if (cents < 0.0f) cents = 0.0f;
-    if (cents > 50.0f) cents = 50.0f;
+    if (cents < 0) cents = 0;
+    if (cents > 50) cents = 50;
     
-    // Check if value actually changed (with small tolerance for float comparison)
-    if (abs(cents - baseDetuneCents) < 0.001f) {
+    if (cents == baseDetuneCents) {
       return false;
     }
     
@@ -86,7 +98,7 @@ public:
    * Get the current base detune amount in cents
    * @return Base detune amount in cents
    */
-  float getBaseDetuneCents() const {
+  int getBaseDetuneCents() const {
     return baseDetuneCents;
   }
   
@@ -100,44 +112,33 @@ public:
   }
 
 private:
-  int unisonCount;            // Current number of voices (1-4)
-  float baseDetuneCents;      // Base detune amount in cents (0-50)
-  float detuneRatios[4];      // Frequency multipliers for each voice
+  int unisonCount;            // Current number of voices (1-MAX_UNISON)
+  int baseDetuneCents;        // Base detune amount in cents (0-50)
+  Ratio detuneRatios[MAX_UNISON];  // Frequency multipliers for each voice
   
   /**
    * Recalculate detune ratios based on current unison count and base detune amount
    * Updates detuneRatios array with appropriate frequency multipliers
    */
   void recalculateRatios() {
-    switch (unisonCount) {
-      case 1:
-        // Single voice - no detune
-        detuneRatios[0] = 1.0f;
-        break;
-        
-      case 2:
-        // Two voices: [-d, +d]
-        detuneRatios[0] = centsToRatio(-baseDetuneCents);
-        detuneRatios[1] = centsToRatio(+baseDetuneCents);
-        break;
-        
-      case 3:
-        // Three voices: [-d, 0, +d]
-        detuneRatios[0] = centsToRatio(-baseDetuneCents);
-        detuneRatios[1] = 1.0f;  // Center voice, no detune
-        detuneRatios[2] = centsToRatio(+baseDetuneCents);
-        break;
-        
-      case 4:
-        // Four voices: [-1.5d, -0.5d, +0.5d, +1.5d]
-        detuneRatios[0] = centsToRatio(-1.5f * baseDetuneCents);
-        detuneRatios[1] = centsToRatio(-0.5f * baseDetuneCents);
-        detuneRatios[2] = centsToRatio(+0.5f * baseDetuneCents);
-        detuneRatios[3] = centsToRatio(+1.5f * baseDetuneCents);
-        break;
+    // Voices sit d apart around the pitch: [-d, 0, +d], [-1.5d .. +1.5d], ...
+    // except a pair, which spreads to [-d, +d] so two voices still beat at 2d
+    int spacing = (unisonCount == 2) ? 2 * baseDetuneCents : baseDetuneCents;
+    
+    for (int i = 0; i < unisonCount; i++) {
+      int halfSteps = 2 * i - (unisonCount - 1);  // Offset in half spacings
+      if constexpr (Config::FIXED_POINT) {
+        detuneRatios[i] = FixedPitch::ratioQ20(halfSteps * spacing * (FixedPitch::CENT / 2));
+      } else {
+        float offset = halfSteps * spacing * 0.5f;
+        detuneRatios[i] = (offset == 0.0f) ? 1.0f : centsToRatio(offset);
+      }
     }
   }
 };
 
+// Engine unison configuration (see SynthConfig.h)
+typedef BasicUnisonConfig<SynthEngineConfig> UnisonConfig;
+
 #endif // UNISONCONFIG_H
 
@@ -43,7 +43,8 @@
  * OK Button:
  *   One side  -> GPIO 13
  *   Other side -> GND
- *   Function: Cycle waveform (same as short press on BOOT)
+ *   Short press: Cycle waveform (same as short press on BOOT)
+ *   Long press: Toggle oscilloscope / spectrum view
  * 
  * BACK Button:
  *   One side  -> GPIO 16
@@ -60,6 +61,7 @@
 #include <Adafruit_GFX.h>
 #include <Adafruit_SSD1306.h>
 
+#include "SynthConfig.h"
 #include "Oscillator.h"
 #include "ChordLibrary.h"
 #include "ChordPlayer.h"
@@ -67,6 +69,24 @@
 #include "UnisonConfig.h"
 #include "I2SDriver.h"
 #include "BootAnimation.h"
+#include "OledDisplay.h"
+#include "AsyncI2CBus.h"
+#include "AudioRingBuffer.h"
+#include "Scope.h"
+#include "Spectrum.h"
+#include "FrameScheduler.h"
+#include "SynthParams.h"
+#include "MenuBuilder.h"
+#include "MenuSystem.h"
+#include "ButtonInput.h"
+#include "PotSampler.h"
+#include "MidiInput.h"
+#include "MidiClockSync.h"
+#include "SerialConsole.h"
+#include "LatencyHistogram.h"
+#include "PowerManager.h"
+#include "Looper.h"
+#include <atomic>
 
 // ========== OLED Display Configuration ==========
 #define SCREEN_WIDTH  128
@@ -75,9 +95,28 @@
 #define OLED_SDA      21    // I2C Data
 #define OLED_SCL      19    // I2C Clock (custom pin to avoid conflict with I2S)
 #define OLED_ADDRESS  0x3C  // I2C address (0x3C or 0x3D)
+#define OLED_I2C_CLOCK 400000UL  // I2C clock during frame transfers
 
-// Initialize OLED display using I2C
-Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET);
+// Hand frames to the ESP-IDF I2C master driver asynchronously after boot.
+// Set to 0 on cores whose Wire library still uses the legacy I2C driver.
+#ifndef OLED_ASYNC_I2C
+#define OLED_ASYNC_I2C 1
+#endif
+
+// Initialize OLED display using I2C (partial updates: only changed regions are sent)
+OledDisplay display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET, OLED_I2C_CLOCK);
+
+#if OLED_ASYNC_I2C && ASYNC_I2C_BUS_AVAILABLE
+AsyncI2CBus oledAsyncBus;  // Non-blocking frame transfers (double-buffered)
+#endif
+
+// ========== Display Frame Rates ==========
+#define DISPLAY_ANIMATION_FPS  60  // Gauge needle animations
+#define DISPLAY_LIVE_FPS       30  // Scope / spectrum while audio is playing
+#define DISPLAY_STATS_LOG_MS   0   // Log FPS and frame time every N ms (0 = off)
+
+// Paces the display task; static screens draw nothing until requestRedraw()
+FrameScheduler frameScheduler;
 
 // ========== I2S Audio Configuration ==========
 // MAX98357A connections: BCLK=GPIO25, LRC=GPIO26, DIN=GPIO22
@@ -88,11 +127,18 @@ Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET);
 // ========== Potentiometer Configuration ==========
 #define DIAL1       4    // First potentiometer for volume control (GPIO 4 / D4)
 #define DIAL2       33   // Second potentiometer (GPIO 33)
+#define UNISON_DIAL_HYSTERESIS 200  // ADC counts past a zone edge before the unison count changes
+
+// Pots are sampled and filtered on Core 0; the audio task only reads the results
+PotSampler potSampler;
+int volumePotId = -1;
+int dial2PotId = -1;
 
 // ========== Button Configuration ==========
 #define BOOT_BUTTON 0    // BOOT button (GPIO 0)
-#define OK_BUTTON   13   // OK button (GPIO 13) - same as short press BOOT
+#define OK_BUTTON   13   // OK button (GPIO 13) - short = waveform, long = display view
 #define BACK_BUTTON 16   // BACK button (GPIO 16) - same as long press BOOT
+#define INPUT_LATENCY_LOG 0  // Log each button gesture with its edge-to-dispatch latency
 
 // ========== Play Mode ==========
 enum PlayMode {
@@ -102,12 +148,76 @@ enum PlayMode {
 };
 
 // ========== Audio Configuration ==========
-#define SAMPLE_RATE     44100          // 44.1 kHz
+// Engine sample rate, table size, unison depth and block size are chosen at
+// build time in SynthConfig.h (SYNTH_* flags)
+constexpr int SAMPLE_RATE = SynthEngineConfig::SAMPLE_RATE;                // Boot rate, 44.1 kHz
+constexpr int AUDIO_BUFFER_FRAMES = SynthEngineConfig::BLOCK_FRAMES;       // Frames per I2S write
 #define TONE_FREQUENCY  880.0f        // A5, 880 Hz (higher frequency reduces speaker load)
+#define TONE_NOTE       81            // MIDI note of TONE_FREQUENCY
+#define SERIAL_CONSOLE_ENABLED 1       // Line commands on Serial (type "help")
+#define CHORD_RENDER_CHUNK  64         // Frames per ChordPlayer::render() call (stack buffer)
+#define BENCH_BLOCKS        16         // Buffers timed per configuration by "bench"
+#define SAMPLE_BANK_SOURCE  "samples"  // Data partition with the PCM bank (partitions.csv)
+#define LOOPER_SECONDS      8          // Longest loop at 48 kHz (1.5 MB of PSRAM, stereo)
+#define LOOP_EXPORT_HOLD_MS 100        // Wait for the audio task to freeze the loop before "loop export"
+#define LOOP_EXPORT_DEFERRED 8         // Looper / rate changes held back during an export
+#define AUDIO_TASK_STACK    8192       // Bytes: 2 KB buffer, render chunk, Serial.printf ("stats" shows the margin)
+#define DISPLAY_TASK_STACK  4096       // Bytes
+
+// Rates selectable at run time (menu ENGINE -> Rate, console "rate"); the
+// buffer stays AUDIO_BUFFER_FRAMES long, so its duration follows the rate
+constexpr uint32_t SAMPLE_RATES[] = {22050, 32000, 44100, 48000};
+constexpr int NUM_SAMPLE_RATES = sizeof(SAMPLE_RATES) / sizeof(SAMPLE_RATES[0]);
+
+constexpr int sampleRateIndex(uint32_t rate) {
+  for (int i = 0; i < NUM_SAMPLE_RATES; i++) {
+    if (SAMPLE_RATES[i] == rate) return i;
+  }
+  return -1;
+}
+static_assert(sampleRateIndex(SAMPLE_RATE) >= 0, "Build sample rate must be one of SAMPLE_RATES");
 
 // I2S audio driver
 I2SDriver i2sDriver;
 
+// ========== Idle / Power Configuration ==========
+// Silent buffers are not rendered; after IDLE_ENTER_MS of silence the synth
+// goes idle: CPU clock drops, live display frames pause, scope tap stops
+#define IDLE_POWER_SAVING  1     // Scale the CPU clock down while idle (needs CONFIG_PM_ENABLE)
+#define IDLE_ENTER_MS      250   // Continuous silence before going idle
+#define CPU_ACTIVE_MHZ     240
+#define CPU_IDLE_MHZ       80
+
+PowerManager powerManager;
+
+// ========== MIDI Input Configuration ==========
+#define MIDI_ENABLED      1
+#define MIDI_UART         2     // UART2 (UART0 is Serial)
+#define MIDI_RX_PIN       18    // MIDI IN through an optocoupler (6N138 or similar)
+#define MIDI_CHANNEL      0     // 1-16, or 0 for omni
+#define MIDI_BEND_RANGE   2     // Pitch bend range in semitones
+#define MIDI_ROOT_NOTE    60    // Key that plays chords untransposed (middle C)
+#define MIDI_MAX_HELD     8     // Held keys remembered for last-note priority
+#define MIDI_CLOCK_TICKS_PER_CHORD  48   // Half note per chord at 24 PPQN, as the internal timer
+#define MIDI_CLOCK_TIMEOUT_MS       500  // Internal timer takes over when the clock stops arriving
+
+// Parsed messages from the MIDI task, stamped with their arrival time
+MidiQueue midiQueue;
+#if MIDI_ENABLED && MIDI_UART_AVAILABLE
+MidiInput midiInput;
+#endif
+
+// ========== Scope Configuration ==========
+#define SCOPE_DECIMATION  2        // Audio samples averaged per scope sample (22.05 kHz)
+#define SCOPE_FULL_SCALE  SynthEngineConfig::MAX_AMPLITUDE  // Oscillator peak, drawn at full trace height
+
+// Decimated copy of the real audio output (written by audio task, read by display)
+AudioRingBuffer scopeRing;
+
+// One buffer's worth of scope samples, staged by the audio task (kept off its stack)
+constexpr int SCOPE_BLOCK_SAMPLES = AUDIO_BUFFER_FRAMES / SCOPE_DECIMATION;
+int16_t scopeBlock[SCOPE_BLOCK_SAMPLES];
+
 // ========== FreeRTOS Task Handles ==========
 TaskHandle_t audioTaskHandle = NULL;
 TaskHandle_t displayTaskHandle = NULL;
@@ -117,19 +227,73 @@ SemaphoreHandle_t volumeMutex = NULL;
 Oscillator oscillator;  // Single global oscillator - shared by all modes
 ChordPlayer chordPlayer;
 UnisonConfig unisonConfig;  // Unison configuration for chord modes
+NoiseEngine noteNoise;      // NOISE in NOTE mode (chord modes use the ChordPlayer's)
+SampleAndHold sampleAndHold;  // Random pitch modulation, ticked once per buffer
+SampleBank sampleBank;      // PCM samples mapped from flash (read-only, shared)
+Looper looper;              // Output-bus loop recorder (process() on the audio task only)
 
 // ========== Shared Variables ==========
 float currentAmplitude = 1.0f;        // Current amplitude multiplier (0.0 to 1.0)
 int volumePercent = 100;              // Current volume percentage
 volatile PlayMode currentMode = MODE_PROGRESSION;  // Current play mode (default: progression)
 OscillatorType currentGlobalWaveform = OSC_SAWTOOTH;  // Global waveform (default: sawtooth)
+volatile int selectedChordIndex = 0;        // ChordLib::ALL_CHORDS index for CHORD mode
+volatile int selectedProgressionIndex = 0;  // ChordLib::PROGRESSIONS index
+volatile int unisonCountSetting = 1;        // Requested unison voices (1-4)
+volatile int unisonDetuneSetting = 7;       // Requested unison detune (cents)
+volatile int oversampleSetting = 1;         // Requested chord oversampling (1 or 2)
+volatile int fmPatchSetting = 0;            // FmLib::ALL_PATCHES index
+volatile int fmDepthSetting = 100;          // FM modulation depth (%)
+volatile int organPresetSetting = 0;        // OrganLib::ALL_REGISTRATIONS index (-1 = custom drawbars)
+volatile int32_t organDrawbarsSetting = 888000000;  // Packed drawbars (OrganLib::pack)
+volatile int noiseColorSetting = 0;         // Noise color (0 = white)
+volatile int shRateSetting = 4;             // Sample-and-hold rate (Hz)
+volatile int shDepthSetting = 0;            // Sample-and-hold pitch depth (semitones, 0 = off)
+volatile int samplerSlotSetting = 1;        // SampleBank sample number (1-based)
+volatile int sampleRateSetting = sampleRateIndex(SAMPLE_RATE);  // Requested SAMPLE_RATES index
+
+// ========== Parameter Channel ==========
+// Settings above are what the UI shows; the audio task applies them to the
+// engine from this queue at the start of each buffer (lock-free, never blocks)
+ParamQueue paramQueue;
+PlayMode engineMode = MODE_PROGRESSION;               // Mode being rendered (audio task only)
+const Chord* engineChord = ChordLib::ALL_CHORDS[0];  // Chord for CHORD mode (audio task only)
+volatile uint32_t audioSampleRate = SAMPLE_RATE;     // Rate being rendered (written by audio task)
+volatile uint32_t audioBlockMicros = SynthEngineConfig::BLOCK_MICROS;  // One buffer at that rate
 
-// ========== Button State Tracking ==========
-volatile unsigned long buttonPressStartTime = 0;
-volatile bool buttonIsPressed = false;
-volatile bool buttonReleased = false;
+// ========== MIDI Engine State (audio task only) ==========
+uint8_t midiHeldNotes[MIDI_MAX_HELD];  // Held keys, most recent last
+int midiHeldCount = 0;
+bool midiKeysPlayed = false;           // Keys gate the sound once any key was played
+int midiBend = 0;                      // -8192 .. 8191
+int midiVolume = 127;                  // CC7
+SynthEngineConfig::Phase singleNoteIncrement = 0;  // Phase step per sample in NOTE mode
+int shDepthSemitones = 0;              // Sample-and-hold pitch depth being applied
+
+// ========== MIDI Clock Sync (audio task only) ==========
+// Clock ticks are stamped in samples; the PLL predicts the tick that ends a
+// chord, so the change is rendered on the filtered grid, not on a jittery tick
+MidiClockSync midiClock;
+uint32_t audioSampleTime = 0;   // Sample position of the current buffer's first frame
+bool clockStepPending = false;  // Progression step scheduled on the predicted grid
+uint32_t clockStepSample = 0;
+int32_t clockStepTick = 0;
+int32_t lastClockStepTick = -1; // Tick whose step has been played (no double step)
+
+// ========== Button Input ==========
+// GPIO interrupts queue timestamped edges; loop() sleeps until an edge or a
+// gesture deadline, then dispatches the resulting events
 const unsigned long LONG_PRESS_THRESHOLD = 1000;  // 1 second
-const unsigned long DEBOUNCE_DELAY = 50;  // 50ms debounce
+const unsigned long VERY_LONG_PRESS_THRESHOLD = 2000;  // 2 seconds (menu)
+const unsigned long DEBOUNCE_DELAY = 30;  // Bounce lockout after an accepted edge
+const unsigned long DOUBLE_CLICK_WINDOW = 250;  // BACK double click
+const unsigned long HOLD_REPEAT_DELAY = 600;  // OK hold-to-scroll in the menu
+const unsigned long HOLD_REPEAT_INTERVAL = 150;
+const unsigned long MENU_DIAL_POLL_MS = 20;  // DIAL2 sampling while the menu is open
+ButtonInput buttonInput;
+int bootButtonId = -1;
+int okButtonId = -1;
+int backButtonId = -1;
 
 // ========== Animation Modes ==========
 enum AnimationMode {
@@ -137,35 +301,206 @@ enum AnimationMode {
   ANIM_WAVEFORM,
   ANIM_UNISON
 };
-volatile AnimationMode currentAnimation = ANIM_NONE;
+AnimationMode currentAnimation = ANIM_NONE;  // Display task only
+
+// Gauge animation posted by another task for the display task, which owns the
+// gauge: (AnimationMode << 8) | waveform or unison count, 0 when none.
+// A newer request replaces one not yet applied.
+std::atomic<uint16_t> gaugeRequest(0);
+
+// ========== Display Views ==========
+enum DisplayView {
+  VIEW_SCOPE,
+  VIEW_SPECTRUM
+};
+volatile DisplayView currentView = VIEW_SCOPE;
 
 // ========== Chord Progression Timing ==========
 unsigned long lastChordChangeTime = 0;
-const unsigned long CHORD_DURATION_MS = 1600;  // 1.6 seconds (half note at 75 BPM)
+const int DEFAULT_TEMPO_BPM = 75;
+const int MIN_TEMPO_BPM = 30;
+const int MAX_TEMPO_BPM = 240;
+volatile int tempoSetting = DEFAULT_TEMPO_BPM;  // Requested internal tempo (BPM)
+int engineTempoBpm = DEFAULT_TEMPO_BPM;  // Internal timer tempo (audio task only)
+unsigned long chordDurationMs = 2 * 60000UL / DEFAULT_TEMPO_BPM;  // Half note: 1.6 s at 75 BPM
 volatile int currentChordIndex = 0;
+volatile int progressionBpmTenths = DEFAULT_TEMPO_BPM * 10;  // MIDI clock tempo when synced
+volatile bool progressionClockSynced = false;
 const Chord* const* currentProgression = ChordLib::JAZZ_PROGRESSION_1;
 int currentProgressionLength = ChordLib::JAZZ_PROGRESSION_1_LENGTH;
 
 // NOTE: Single note mode now uses global oscillator - no separate tables needed
 
+// ========== Performance Metrics ==========
+// Recorded by the audio task, read by the serial console
+LatencyHistogram renderHistogram;        // Time to render one buffer (us)
+LatencyHistogram paramLatencyHistogram;  // sendParam() to applied (us)
+volatile uint32_t audioBuffersRendered = 0;
+volatile uint32_t audioBuffersSilent = 0;  // Buffers written without rendering any voice
+volatile bool paramTraceEnabled = false;  // Log each applied change (console "trace")
+
+// ========== Loop Export ==========
+// "loop export" reads the loop region on the console task while the audio
+// task keeps playing. The console raises the request; between buffers the
+// audio task answers with the hold and from then on keeps looper commands
+// and sample rate changes (which write or clear the region) back until the
+// request drops, then applies them in order.
+volatile bool loopExportRequested = false;  // Set by the console task
+volatile bool loopExportHeld = false;       // Set by the audio task
+ParamChange loopExportDeferred[LOOP_EXPORT_DEFERRED];  // Audio task only
+int loopExportDeferredCount = 0;
+
 // ========== Gauge Display ==========
 Gauge gauge;
-const char* WAVEFORM_LABELS[] = {"SAW", "SQR", "TRI", "SIN"};
-const float WAVEFORM_ANGLES[] = {180.0f, 120.0f, 60.0f, 0.0f};
-const int NUM_WAVEFORMS = 4;
+int gaugeWaveformLayout = -1;  // Precomputed gauge layouts (see setup)
+int gaugeUnisonLayout = -1;
+const char* WAVEFORM_LABELS[] = {"SAW", "SQR", "TRI", "SIN", "FM", "ORG", "NSE", "SMP"};
+const float WAVEFORM_ANGLES[] = {180.0f, 154.3f, 128.6f, 102.9f, 77.1f, 51.4f, 25.7f, 0.0f};
+const int NUM_WAVEFORMS = 8;
 
 const char* UNISON_LABELS[] = {"x1", "x2", "x3", "x4"};
 const float UNISON_ANGLES[] = {180.0f, 120.0f, 60.0f, 0.0f};
-const int NUM_UNISON = 4;
+const int NUM_UNISON = UnisonConfig::MAX_UNISON;
+static_assert(sizeof(UNISON_LABELS) / sizeof(UNISON_LABELS[0]) == NUM_UNISON,
+              "Unison gauge needs a label and angle per voice count");
+
+// ========== Menu Tree (constant data in flash) ==========
+constexpr MenuItem MENU_PLAY_MODE[] = {
+  MenuBuilder::choice("Single Note", PARAM_PLAY_MODE, MODE_SINGLE_NOTE),
+  MenuBuilder::choice("Chord", PARAM_PLAY_MODE, MODE_CHORD),
+  MenuBuilder::choice("Progression", PARAM_PLAY_MODE, MODE_PROGRESSION)
+};
+
+constexpr MenuItem MENU_CHORD[] = {
+  MenuBuilder::choice(ChordLib::ALL_CHORDS[0]->name, PARAM_CHORD, 0),
+  MenuBuilder::choice(ChordLib::ALL_CHORDS[1]->name, PARAM_CHORD, 1),
+  MenuBuilder::choice(ChordLib::ALL_CHORDS[2]->name, PARAM_CHORD, 2),
+  MenuBuilder::choice(ChordLib::ALL_CHORDS[3]->name, PARAM_CHORD, 3),
+  MenuBuilder::choice(ChordLib::ALL_CHORDS[4]->name, PARAM_CHORD, 4),
+  MenuBuilder::choice(ChordLib::ALL_CHORDS[5]->name, PARAM_CHORD, 5)
+};
+static_assert(sizeof(MENU_CHORD) / sizeof(MENU_CHORD[0]) == ChordLib::NUM_CHORDS,
+              "CHORD menu must list every chord");
+
+constexpr MenuItem MENU_PROGRESSION[] = {
+  MenuBuilder::choice(ChordLib::PROGRESSIONS[0].name, PARAM_PROGRESSION, 0),
+  MenuBuilder::choice(ChordLib::PROGRESSIONS[1].name, PARAM_PROGRESSION, 1)
+};
+static_assert(sizeof(MENU_PROGRESSION) / sizeof(MENU_PROGRESSION[0]) == ChordLib::NUM_PROGRESSIONS,
+              "PROGRESSION menu must list every progression");
+
+constexpr MenuItem MENU_WAVEFORM[] = {
+  MenuBuilder::choice("Sawtooth", PARAM_WAVEFORM, OSC_SAWTOOTH),
+  MenuBuilder::choice("Square", PARAM_WAVEFORM, OSC_SQUARE),
+  MenuBuilder::choice("Triangle", PARAM_WAVEFORM, OSC_TRIANGLE),
+  MenuBuilder::choice("Sine", PARAM_WAVEFORM, OSC_SINE),
+  MenuBuilder::choice("FM", PARAM_WAVEFORM, OSC_FM),
+  MenuBuilder::choice("Organ", PARAM_WAVEFORM, OSC_ORGAN),
+  MenuBuilder::choice("Noise", PARAM_WAVEFORM, OSC_NOISE),
+  MenuBuilder::choice("Sample", PARAM_WAVEFORM, OSC_SAMPLER)
+};
+
+constexpr MenuItem MENU_FM[] = {
+  MenuBuilder::choice(FmLib::ALL_PATCHES[0]->name, PARAM_FM_PATCH, 0),
+  MenuBuilder::choice(FmLib::ALL_PATCHES[1]->name, PARAM_FM_PATCH, 1),
+  MenuBuilder::choice(FmLib::ALL_PATCHES[2]->name, PARAM_FM_PATCH, 2),
+  MenuBuilder::choice(FmLib::ALL_PATCHES[3]->name, PARAM_FM_PATCH, 3),
+  MenuBuilder::value("Depth", PARAM_FM_DEPTH, 0, 200, "%d%%")
+};
+static_assert(sizeof(MENU_FM) / sizeof(MENU_FM[0]) == FmLib::NUM_PATCHES + 1,
+              "FM menu must list every patch");
+
+constexpr MenuItem MENU_ORGAN[] = {
+  MenuBuilder::choice(OrganLib::ALL_REGISTRATIONS[0]->name, PARAM_ORGAN_PRESET, 0),
+  MenuBuilder::choice(OrganLib::ALL_REGISTRATIONS[1]->name, PARAM_ORGAN_PRESET, 1),
+  MenuBuilder::choice(OrganLib::ALL_REGISTRATIONS[2]->name, PARAM_ORGAN_PRESET, 2),
+  MenuBuilder::choice(OrganLib::ALL_REGISTRATIONS[3]->name, PARAM_ORGAN_PRESET, 3)
+};
+static_assert(sizeof(MENU_ORGAN) / sizeof(MENU_ORGAN[0]) == OrganLib::NUM_REGISTRATIONS,
+              "ORGAN menu must list every registration");
+
+constexpr MenuItem MENU_NOISE[] = {
+  MenuBuilder::value("Color", PARAM_NOISE_COLOR, 0, NoiseColor::MAX_COLOR, "%d%%")
+};
+
+constexpr MenuItem MENU_SAMPLER[] = {
+  MenuBuilder::value("Sample", PARAM_SAMPLER_SLOT, 1, SampleBank::MAX_SAMPLES, "#%d")
+};
+
+constexpr MenuItem MENU_SAMPLE_HOLD[] = {
+  MenuBuilder::value("Rate", PARAM_SH_RATE, 1, SampleAndHold::MAX_RATE_HZ, "%d Hz"),
+  MenuBuilder::value("Pitch", PARAM_SH_DEPTH, 0, 12, "%d st")
+};
+
+constexpr MenuItem MENU_LOOPER[] = {
+  MenuBuilder::choice("Record", PARAM_LOOPER, LOOPER_RECORDING),
+  MenuBuilder::choice("Play", PARAM_LOOPER, LOOPER_PLAYING),
+  MenuBuilder::choice("Overdub", PARAM_LOOPER, LOOPER_OVERDUBBING),
+  MenuBuilder::choice("Stop", PARAM_LOOPER, LOOPER_STOPPED),
+  MenuBuilder::choice("Clear", PARAM_LOOPER, LOOPER_EMPTY)
+};
+
+constexpr MenuItem MENU_UNISON[] = {
+  MenuBuilder::value("Count", PARAM_UNISON_COUNT, 1, NUM_UNISON, "x%d"),
+  MenuBuilder::value("Detune", PARAM_UNISON_DETUNE, 0, 50, "%d c")
+};
+
+constexpr MenuItem MENU_SAMPLE_RATE[] = {
+  MenuBuilder::choice("22.05 kHz", PARAM_SAMPLE_RATE, sampleRateIndex(22050)),
+  MenuBuilder::choice("32 kHz", PARAM_SAMPLE_RATE, sampleRateIndex(32000)),
+  MenuBuilder::choice("44.1 kHz", PARAM_SAMPLE_RATE, sampleRateIndex(44100)),
+  MenuBuilder::choice("48 kHz", PARAM_SAMPLE_RATE, sampleRateIndex(48000))
+};
+static_assert(sizeof(MENU_SAMPLE_RATE) / sizeof(MENU_SAMPLE_RATE[0]) == NUM_SAMPLE_RATES,
+              "Rate menu must list every sample rate");
+
+constexpr MenuItem MENU_ENGINE[] = {
+  MenuBuilder::value("Oversample", PARAM_OVERSAMPLE, 1, 2, "x%d"),
+  MenuBuilder::submenu("Rate", MENU_SAMPLE_RATE)
+};
+
+constexpr MenuItem MENU_ROOT[] = {
+  MenuBuilder::submenu("PLAY MODE", MENU_PLAY_MODE),
+  MenuBuilder::submenuIf("CHORD", MENU_CHORD, PARAM_PLAY_MODE, MODE_CHORD),
+  MenuBuilder::submenuIf("PROGRESSION", MENU_PROGRESSION, PARAM_PLAY_MODE, MODE_PROGRESSION),
+  MenuBuilder::submenu("WAVEFORM", MENU_WAVEFORM),
+  MenuBuilder::submenuIf("FM", MENU_FM, PARAM_WAVEFORM, OSC_FM),
+  MenuBuilder::submenuIf("ORGAN", MENU_ORGAN, PARAM_WAVEFORM, OSC_ORGAN),
+  MenuBuilder::submenuIf("NOISE", MENU_NOISE, PARAM_WAVEFORM, OSC_NOISE),
+  MenuBuilder::submenuIf("SAMPLER", MENU_SAMPLER, PARAM_WAVEFORM, OSC_SAMPLER),
+  MenuBuilder::submenu("S&H", MENU_SAMPLE_HOLD),
+  MenuBuilder::submenu("LOOPER", MENU_LOOPER),
+  MenuBuilder::submenu("UNISON", MENU_UNISON),
+  MenuBuilder::submenu("ENGINE", MENU_ENGINE),
+  MenuBuilder::exit()
+};
+
+constexpr MenuItem MENU_ROOT_ITEM = MenuBuilder::submenu("MENU", MENU_ROOT);
+
+MenuSystem menuSystem;
+
+// ========== Scope / Spectrum Display ==========
+Scope scope;
+Spectrum spectrum;
+
+// ========== Boot Animation ==========
+BootAnimation bootAnimation;  // Stepped by the display task while audio already plays
+
+// ========== Startup Timing ==========
+unsigned long setupStartTime = 0;  // millis() when setup() began
 
 // ========== Angle Helper Functions ==========
 // Arc gauge: 180° (left) to 0° (right), spanning top half like a speedometer
 float getWaveformAngle(OscillatorType type) {
   switch (type) {
     case OSC_SAWTOOTH: return 180.0f;  // Left position (0%)
-    case OSC_SQUARE:   return 120.0f;  // 1/3 position (33%)
-    case OSC_TRIANGLE: return 60.0f;   // 2/3 position (66%)
-    case OSC_SINE:     return 0.0f;    // Right position (100%)
+    case OSC_SQUARE:   return 154.3f;  // 1/7 position
+    case OSC_TRIANGLE: return 128.6f;  // 2/7 position
+    case OSC_SINE:     return 102.9f;  // 3/7 position
+    case OSC_FM:       return 77.1f;   // 4/7 position
+    case OSC_ORGAN:    return 51.4f;   // 5/7 position
+    case OSC_NOISE:    return 25.7f;   // 6/7 position
+    case OSC_SAMPLER:  return 0.0f;    // Right position (100%)
     default:           return 180.0f;
   }
 }
@@ -180,128 +515,1020 @@ float getUnisonAngle(int unisonCount) {
   }
 }
 
-// ========== Waveform Cycling ==========
-void cycleWaveform() {
-  // Cycle through waveforms
-  switch (currentGlobalWaveform) {
-    case OSC_SAWTOOTH: currentGlobalWaveform = OSC_SQUARE; break;
-    case OSC_SQUARE:   currentGlobalWaveform = OSC_TRIANGLE; break;
-    case OSC_TRIANGLE: currentGlobalWaveform = OSC_SINE; break;
-    case OSC_SINE:     currentGlobalWaveform = OSC_SAWTOOTH; break;
+// ========== Parameter Channel ==========
+// Record a setting for the UI and queue it for the audio task (any task)
+bool sendParam(ParamId id, int value) {
+  switch (id) {
+    case PARAM_PLAY_MODE:     currentMode = (PlayMode)value; break;
+    case PARAM_WAVEFORM:      currentGlobalWaveform = (OscillatorType)value; break;
+    case PARAM_CHORD:         selectedChordIndex = value; break;
+    case PARAM_PROGRESSION:   selectedProgressionIndex = value; break;
+    case PARAM_UNISON_COUNT:  unisonCountSetting = value; break;
+    case PARAM_UNISON_DETUNE: unisonDetuneSetting = value; break;
+    case PARAM_TEMPO:         tempoSetting = value; break;
+    case PARAM_OVERSAMPLE:    oversampleSetting = value; break;
+    case PARAM_SAMPLE_RATE:   sampleRateSetting = value; break;
+    case PARAM_FM_PATCH:      fmPatchSetting = value; break;
+    case PARAM_FM_DEPTH:      fmDepthSetting = value; break;
+    case PARAM_ORGAN_PRESET:
+      value = constrain(value, 0, OrganLib::NUM_REGISTRATIONS - 1);  // Indexes the table here, not only in the audio task
+      organPresetSetting = value;
+      organDrawbarsSetting = OrganLib::pack(OrganLib::ALL_REGISTRATIONS[value]->drawbars);
+      break;
+    case PARAM_ORGAN_DRAWBARS:
+      organDrawbarsSetting = value;
+      organPresetSetting = -1;
+      for (int i = 0; i < OrganLib::NUM_REGISTRATIONS; i++) {
+        if (OrganLib::pack(OrganLib::ALL_REGISTRATIONS[i]->drawbars) == value) organPresetSetting = i;
+      }
+      break;
+    case PARAM_NOISE_COLOR:   noiseColorSetting = value; break;
+    case PARAM_SH_RATE:       shRateSetting = value; break;
+    case PARAM_SH_DEPTH:      shDepthSetting = value; break;
+    case PARAM_SAMPLER_SLOT:  samplerSlotSetting = value; break;
+    default: break;
   }
+  frameScheduler.requestRedraw();
   
-  // Update global oscillator type
-  oscillator.setType(currentGlobalWaveform);
+  ParamChange change = {id, value, (uint32_t)micros()};
+  if (!paramQueue.push(change)) {
+    Serial.println("WARNING: Parameter queue full, change dropped");
+    return false;
+  }
+  return true;
+}
+
+// Current UI-side value of a setting (menu indicators and editors)
+int getParamValue(ParamId id) {
+  switch (id) {
+    case PARAM_PLAY_MODE:     return currentMode;
+    case PARAM_WAVEFORM:      return currentGlobalWaveform;
+    case PARAM_CHORD:         return selectedChordIndex;
+    case PARAM_PROGRESSION:   return selectedProgressionIndex;
+    case PARAM_UNISON_COUNT:  return unisonCountSetting;
+    case PARAM_UNISON_DETUNE: return unisonDetuneSetting;
+    case PARAM_TEMPO:         return tempoSetting;
+    case PARAM_OVERSAMPLE:    return oversampleSetting;
+    case PARAM_SAMPLE_RATE:   return sampleRateSetting;
+    case PARAM_FM_PATCH:      return fmPatchSetting;
+    case PARAM_FM_DEPTH:      return fmDepthSetting;
+    case PARAM_ORGAN_PRESET:  return organPresetSetting;
+    case PARAM_ORGAN_DRAWBARS: return organDrawbarsSetting;
+    case PARAM_NOISE_COLOR:   return noiseColorSetting;
+    case PARAM_SH_RATE:       return shRateSetting;
+    case PARAM_SH_DEPTH:      return shDepthSetting;
+    case PARAM_SAMPLER_SLOT:  return samplerSlotSetting;
+    case PARAM_LOOPER:        return looper.getState();  // Engine state, the menu marks it
+    default:                  return 0;
+  }
+}
+
+// Menu edits take the same path as the buttons
+void setParamFromMenu(ParamId id, int value) {
+  sendParam(id, value);
+}
+
+// Apply one queued change to the engine (audio task only, between buffers)
+void applyParamChange(const ParamChange& change) {
+  if (loopExportHeld && (change.id == PARAM_LOOPER || change.id == PARAM_SAMPLE_RATE)) {
+    // The region is being exported: apply after it (a full list keeps the latest last)
+    int slot = min(loopExportDeferredCount, LOOP_EXPORT_DEFERRED - 1);
+    loopExportDeferred[slot] = change;
+    loopExportDeferredCount = slot + 1;
+    return;
+  }
   
-  // Start gauge animation to new waveform angle
-  float targetAngle = getWaveformAngle(currentGlobalWaveform);
-  gauge.startAnimation(targetAngle);
-  currentAnimation = ANIM_WAVEFORM;
+  switch (change.id) {
+    case PARAM_PLAY_MODE:
+      engineMode = (PlayMode)change.value;
+      midiKeysPlayed = false;  // Back to a free-running drone until a key is played
+      if (engineMode == MODE_CHORD) {
+        chordPlayer.reset();
+        chordPlayer.setChord(engineChord);
+      } else if (engineMode == MODE_PROGRESSION) {
+        currentChordIndex = 0;
+        chordPlayer.setChordFromProgression(0, currentProgression, currentProgressionLength);
+        chordPlayer.reset();
+        lastChordChangeTime = millis();
+      }
+      break;
+      
+    case PARAM_WAVEFORM:
+      oscillator.setType((OscillatorType)change.value);
+      if (change.value == OSC_FM) {
+        chordPlayer.setVoiceEngine(VOICES_FM);
+      } else if (change.value == OSC_ORGAN) {
+        chordPlayer.setVoiceEngine(VOICES_ORGAN);
+      } else if (change.value == OSC_NOISE) {
+        chordPlayer.setVoiceEngine(VOICES_NOISE);
+      } else if (change.value == OSC_SAMPLER) {
+        chordPlayer.setVoiceEngine(VOICES_SAMPLER);
+      } else {
+        chordPlayer.setVoiceEngine(VOICES_TABLE);
+      }
+      break;
+      
+    case PARAM_CHORD:
+      engineChord = ChordLib::ALL_CHORDS[constrain(change.value, 0, ChordLib::NUM_CHORDS - 1)];
+      if (engineMode == MODE_CHORD) {
+        chordPlayer.setChord(engineChord);
+      }
+      break;
+      
+    case PARAM_PROGRESSION: {
+      const Progression& progression =
+        ChordLib::PROGRESSIONS[constrain(change.value, 0, ChordLib::NUM_PROGRESSIONS - 1)];
+      currentProgression = progression.chords;
+      currentProgressionLength = progression.length;
+      currentChordIndex = 0;
+      if (engineMode == MODE_PROGRESSION) {
+        chordPlayer.setChordFromProgression(0, currentProgression, currentProgressionLength);
+        chordPlayer.reset();
+        lastChordChangeTime = millis();
+      }
+      break;
+    }
+      
+    case PARAM_UNISON_COUNT:
+      unisonConfig.setUnisonCount(change.value);
+      chordPlayer.recalculatePhaseIncrements();  // Recalculate with new detune
+      break;
+      
+    case PARAM_UNISON_DETUNE:
+      if (unisonConfig.setBaseDetuneCents(change.value)) {
+        chordPlayer.recalculatePhaseIncrements();
+      }
+      break;
+      
+    case PARAM_TEMPO:
+      engineTempoBpm = constrain((int)change.value, MIN_TEMPO_BPM, MAX_TEMPO_BPM);
+      chordDurationMs = 2 * 60000UL / engineTempoBpm;
+      break;
+      
+    case PARAM_OVERSAMPLE:
+      chordPlayer.setOversampling(change.value);
+      break;
+      
+    case PARAM_FM_PATCH:
+      chordPlayer.setFmPatch(FmLib::ALL_PATCHES[constrain((int)change.value, 0, FmLib::NUM_PATCHES - 1)]);
+      break;
+      
+    case PARAM_FM_DEPTH:
+      chordPlayer.setFmDepth(change.value);
+      break;
+      
+    case PARAM_ORGAN_PRESET:
+      chordPlayer.setOrganDrawbars(
+        OrganLib::ALL_REGISTRATIONS[constrain((int)change.value, 0, OrganLib::NUM_REGISTRATIONS - 1)]->drawbars);
+      break;
+      
+    case PARAM_ORGAN_DRAWBARS: {
+      uint8_t drawbars[OrganLib::NUM_DRAWBARS];
+      if (OrganLib::unpack(change.value, drawbars)) {
+        chordPlayer.setOrganDrawbars(drawbars);
+      }
+      break;
+    }
+      
+    case PARAM_NOISE_COLOR:
+      chordPlayer.setNoiseColor(change.value);
+      noteNoise.setColor(change.value);
+      break;
+      
+    case PARAM_SH_RATE:
+      sampleAndHold.setRate(change.value, audioSampleRate);
+      break;
+      
+    case PARAM_SH_DEPTH:
+      shDepthSemitones = constrain((int)change.value, 0, 12);
+      updateMidiPitch();  // Depth 0 drops the held offset at once
+      break;
+      
+    case PARAM_SAMPLER_SLOT:
+      chordPlayer.setSamplerSample(sampleBank.getSample(change.value - 1));  // Empty slot = silence
+      break;
+      
+    case PARAM_LOOPER:
+      looper.setState((LooperState)constrain((int)change.value, (int)LOOPER_EMPTY, (int)LOOPER_STOPPED), audioSampleRate);
+      Serial.printf("Looper: %s\n", Looper::getStateName(looper.getState()));
+      break;
+      
+    case PARAM_SAMPLE_RATE:
+      reconfigure(SAMPLE_RATES[constrain((int)change.value, 0, NUM_SAMPLE_RATES - 1)]);
+      break;
+      
+    default:
+      break;
+  }
+}
+
+// Switch the whole engine to another sample rate (audio task only, between
+// buffers, so nothing is rendering while the clock changes)
+void reconfigure(uint32_t sampleRate) {
+  if (sampleRate == audioSampleRate) {
+    return;
+  }
+  if (!i2sDriver.setSampleRate(sampleRate)) {
+    sampleRateSetting = sampleRateIndex(audioSampleRate);  // Show the rate still playing
+    frameScheduler.requestRedraw();
+    return;
+  }
+  
+  audioSampleRate = sampleRate;
+  audioBlockMicros = (uint32_t)((uint64_t)AUDIO_BUFFER_FRAMES * 1000000 / sampleRate);
+  
+  // Phase increments (chords with oversampling, NOTE mode with bend)
+  chordPlayer.init(sampleRate);
+  sampleAndHold.setRate(sampleAndHold.getRate(), sampleRate);
+  looper.setSampleRate(sampleRate);  // A loop at the old rate would play at the wrong speed
+  updateMidiPitch();
+  
+  // Clock periods were measured in samples at the old rate: re-acquire
+  midiClock.reset();
+  clockStepPending = false;
+  
+  // Render times have a new budget
+  renderHistogram.requestReset();
+  
+  Serial.printf("Sample rate: %u Hz (buffer %u us)\n", (unsigned)sampleRate, (unsigned)audioBlockMicros);
+}
+
+// ========== MIDI Engine (audio task only) ==========
+// Key and pitch bend retune the sound: NOTE mode plays the key itself,
+// chord modes transpose the chord relative to MIDI_ROOT_NOTE
+// (pitch offsets are integer cents Q8 in both engine builds); the
+// sample-and-hold offset rides on the bend
+void updateMidiPitch() {
+  int32_t bendCents = (int32_t)midiBend * MIDI_BEND_RANGE * FixedPitch::SEMITONE / 8192;
+  bendCents += (int32_t)sampleAndHold.getValue() * shDepthSemitones * FixedPitch::SEMITONE / 32768;
+  int note = (midiHeldCount > 0) ? midiHeldNotes[midiHeldCount - 1] : -1;
+  
+  int32_t toneCents = 0;   // NOTE mode, relative to TONE_FREQUENCY
+  int32_t chordCents = 0;  // Chord modes, relative to the chord as written
+  if (note >= 0 || midiKeysPlayed) {
+    // Keep the last key's pitch while released (gate is closed then anyway)
+    static int lastNote = MIDI_ROOT_NOTE;
+    if (note >= 0) lastNote = note;
+    toneCents = (lastNote - TONE_NOTE) * FixedPitch::SEMITONE;
+    chordCents = (lastNote - MIDI_ROOT_NOTE) * FixedPitch::SEMITONE;
+  }
+  
+#if SYNTH_FIXED_POINT
+  singleNoteIncrement = FixedPitch::phaseIncrement((uint32_t)(TONE_FREQUENCY * 256),
+                                                   FixedPitch::ratioQ20(toneCents + bendCents), audioSampleRate);
+#else
+  float noteFrequency = TONE_FREQUENCY * powf(2.0f, (toneCents + bendCents) / (float)FixedPitch::OCTAVE);
+  singleNoteIncrement = (Oscillator::getTableSize() * noteFrequency) / (float)audioSampleRate;
+#endif
+  chordPlayer.setPitchCents(chordCents + bendCents);
+}
+
+void releaseMidiNote(uint8_t note) {
+  for (int i = 0; i < midiHeldCount; i++) {
+    if (midiHeldNotes[i] == note) {
+      for (int k = i; k < midiHeldCount - 1; k++) {
+        midiHeldNotes[k] = midiHeldNotes[k + 1];
+      }
+      midiHeldCount--;
+      return;
+    }
+  }
+}
+
+// Move the progression to a step (internal timer and MIDI clock alike)
+void setProgressionStep(int index) {
+  currentChordIndex = index;
+  chordPlayer.setChordFromProgression(currentChordIndex, currentProgression, currentProgressionLength);
+  lastChordChangeTime = millis();
+  frameScheduler.requestRedraw();
+  
+  // Log chord changes
+  Serial.print("Progression: ");
+  Serial.println(chordPlayer.getChordName());
+}
+
+// Play the step that starts at clockStepTick (once per boundary)
+void fireClockStep() {
+  clockStepPending = false;
+  lastClockStepTick = clockStepTick;
+  if (engineMode == MODE_PROGRESSION) {
+    setProgressionStep((clockStepTick / MIDI_CLOCK_TICKS_PER_CHORD) % currentProgressionLength);
+  }
+}
+
+void onMidiClock(uint32_t sampleTime) {
+  midiClock.onClock(sampleTime);
+  if (!midiClock.isRunning()) {
+    return;  // Stopped: tempo keeps tracking, the song stays put
+  }
+  
+  // Boundary tick with no step played or scheduled (not locked): step now.
+  // A step scheduled on the grid waits for its predicted sample even when
+  // the tick arrives early, unless the loop lost lock on this tick
+  int32_t tick = midiClock.getTickCount();
+  bool scheduled = clockStepPending && clockStepTick == tick && midiClock.isLocked();
+  if (tick % MIDI_CLOCK_TICKS_PER_CHORD == 0 && tick != lastClockStepTick && !scheduled) {
+    clockStepTick = tick;
+    fireClockStep();
+  }
+  
+  // Last tick before a boundary: schedule the step on the predicted grid
+  if (midiClock.isLocked() && (tick + 1) % MIDI_CLOCK_TICKS_PER_CHORD == 0) {
+    clockStepTick = tick + 1;
+    clockStepSample = midiClock.predictTick(tick + 1);
+    clockStepPending = true;
+  }
+}
+
+void applyMidiMessage(const MidiMessage& message, uint32_t sampleTime) {
+  switch (message.type()) {
+    case MIDI_CLOCK:
+      onMidiClock(sampleTime);
+      break;
+      
+    case MIDI_START:
+      midiClock.onStart();
+      clockStepPending = false;
+      lastClockStepTick = -1;  // The first clock plays step 0
+      break;
+      
+    case MIDI_CONTINUE:
+      midiClock.onContinue();
+      break;
+      
+    case MIDI_STOP:
+      midiClock.onStop();
+      clockStepPending = false;
+      break;
+      
+    case MIDI_SONG_POSITION: {
+      int sixteenths = message.bend() + 8192;  // Same 14-bit layout as pitch bend
+      midiClock.onSongPosition((uint16_t)sixteenths);
+      clockStepPending = false;
+      lastClockStepTick = -1;
+      if (engineMode == MODE_PROGRESSION) {
+        setProgressionStep((sixteenths * 6 / MIDI_CLOCK_TICKS_PER_CHORD) % currentProgressionLength);
+      }
+      break;
+    }
+      
+    case MIDI_NOTE_ON:
+      releaseMidiNote(message.data1);  // Retrigger moves it to the top
+      if (midiHeldCount == MIDI_MAX_HELD) {
+        releaseMidiNote(midiHeldNotes[0]);  // Forget the oldest key
+      }
+      midiHeldNotes[midiHeldCount++] = message.data1;
+      midiKeysPlayed = true;
+      updateMidiPitch();
+      break;
+      
+    case MIDI_NOTE_OFF:
+      releaseMidiNote(message.data1);
+      updateMidiPitch();
+      break;
+      
+    case MIDI_PITCH_BEND:
+      midiBend = message.bend();
+      updateMidiPitch();
+      break;
+      
+    case MIDI_CONTROL_CHANGE:
+      if (message.data1 == 1) {
+        // Mod wheel: unison detune 0-50 cents (mirrored to the UI like a menu edit)
+        sendParam(PARAM_UNISON_DETUNE, (message.data2 * 50) / 127);
+      } else if (message.data1 == 7) {
+        midiVolume = message.data2;
+      } else if (message.data1 == 120 || message.data1 == 123) {
+        // All sound off / all notes off
+        midiHeldCount = 0;
+        updateMidiPitch();
+      }
+      break;
+      
+    default:
+      break;
+  }
+}
+
+/**
+ * MIDI gain on top of DIAL1: CC7, and the key gate once keys are in use
+ * @param gainQ15 DIAL1 gain (Q15)
+ */
+int32_t applyMidiGain(int32_t gainQ15) {
+  if (midiKeysPlayed && midiHeldCount == 0) {
+    return 0;
+  }
+  return gainQ15 * midiVolume / 127;
+}
+
+// ========== Audio Rendering (audio task only) ==========
+bool blockAudible = false;  // Some frame of the current buffer had non-zero gain
+
+// Render frames [start, end) of an interleaved stereo buffer in the engine mode
+// (gain is Q15; the per-sample path is integer except the float engine's phase)
+void renderFrames(int16_t* buffer, int start, int end, int32_t volumeGain) {
+  static SynthEngineConfig::Phase phaseIndex = 0;
+  int32_t gain = applyMidiGain(volumeGain);
+  
+  if (gain == 0) {
+    // Silent: skip the voices, but move their phases on so sound resumes
+    // exactly where an uninterrupted render would be
+    memset(&buffer[start * 2], 0, (end - start) * 2 * sizeof(int16_t));
+    uint32_t skipped = end - start;
+    if (engineMode == MODE_SINGLE_NOTE) {
+#if SYNTH_FIXED_POINT
+      phaseIndex += singleNoteIncrement * skipped;
+#else
+      phaseIndex = fmodf(phaseIndex + singleNoteIncrement * skipped, (float)Oscillator::getTableSize());
+#endif
+    } else {
+      chordPlayer.advance(skipped);
+    }
+    return;
+  }
+  blockAudible = true;
+  
+  if (engineMode == MODE_SINGLE_NOTE && oscillator.getType() != OSC_NOISE) {
+    // Single note mode - use global oscillator
+    for (int i = start; i < end; i++) {
+#if SYNTH_FIXED_POINT
+      int idx = (int)(phaseIndex >> SynthEngineConfig::PHASE_SHIFT);  // Accumulator wraps by itself
+#else
+      // Wrap phase index into table range
+      if (phaseIndex >= Oscillator::getTableSize()) {
+        phaseIndex -= Oscillator::getTableSize();
+      }
+      int idx = (int)phaseIndex;
+#endif
+      int16_t sample = (int16_t)((oscillator.getSample(idx) * gain) >> 15);
+      
+      // Stereo: copy same sample to L and R
+      buffer[i * 2 + 0] = sample;  // Left
+      buffer[i * 2 + 1] = sample;  // Right
+      
+      phaseIndex += singleNoteIncrement;
+    }
+  } else {
+    // Chord modes - ChordPlayer renders mono blocks (oversampled if selected);
+    // NOTE mode noise has no pitch to follow, so it takes the same block path
+    SynthEngineConfig::Sample mono[CHORD_RENDER_CHUNK];
+    for (int i = start; i < end; i += CHORD_RENDER_CHUNK) {
+      int count = min(CHORD_RENDER_CHUNK, end - i);
+      if (engineMode == MODE_SINGLE_NOTE) {
+        noteNoise.render(mono, count);
+      } else {
+        chordPlayer.render(mono, count);
+      }
+      for (int k = 0; k < count; k++) {
+        int16_t sample = (int16_t)((mono[k] * gain) >> 15);
+        
+        // Stereo: copy same sample to L and R
+        buffer[(i + k) * 2 + 0] = sample;  // Left
+        buffer[(i + k) * 2 + 1] = sample;  // Right
+      }
+    }
+  }
+}
+
+// Render frames [start, end), playing a scheduled clock step at its sample
+void renderSpan(int16_t* buffer, int start, int end, int32_t volumeGain) {
+  if (clockStepPending) {
+    int32_t due = (int32_t)(clockStepSample - audioSampleTime);
+    if (due < end) {
+      int at = constrain(due, start, end);  // Overdue steps play immediately
+      renderFrames(buffer, start, at, volumeGain);
+      fireClockStep();
+      start = at;
+    }
+  }
+  renderFrames(buffer, start, end, volumeGain);
+}
+
+// ========== Waveform Cycling ==========
+// Switch waveform with the gauge animation (buttons and console)
+void selectWaveform(OscillatorType waveform) {
+  // Audio task switches the global oscillator at its next buffer
+  sendParam(PARAM_WAVEFORM, waveform);
+  
+  // Display task starts the gauge animation to the new waveform angle
+  requestWaveformGauge(waveform);
   
   // Log change
   Serial.print("Waveform: ");
-  Serial.println(oscillator.getTypeName());
+  Serial.println(Oscillator::getTypeName(waveform));
+}
+
+void cycleWaveform() {
+  // Cycle through waveforms
+  OscillatorType nextWaveform;
+  switch (currentGlobalWaveform) {
+    case OSC_SAWTOOTH: nextWaveform = OSC_SQUARE; break;
+    case OSC_SQUARE:   nextWaveform = OSC_TRIANGLE; break;
+    case OSC_TRIANGLE: nextWaveform = OSC_SINE; break;
+    case OSC_SINE:     nextWaveform = OSC_FM; break;
+    case OSC_FM:       nextWaveform = OSC_ORGAN; break;
+    case OSC_ORGAN:    nextWaveform = OSC_NOISE; break;
+    case OSC_NOISE:    nextWaveform = OSC_SAMPLER; break;
+    default:           nextWaveform = OSC_SAWTOOTH; break;
+  }
+  selectWaveform(nextWaveform);
+}
+
+// ========== View Cycling ==========
+void cycleView() {
+  currentView = (currentView == VIEW_SCOPE) ? VIEW_SPECTRUM : VIEW_SCOPE;
+  frameScheduler.requestRedraw();
+  Serial.println(currentView == VIEW_SCOPE ? "View: SCOPE" : "View: SPECTRUM");
 }
 
 // ========== Mode Cycling ==========
 void cycleMode() {
   if (currentMode == MODE_PROGRESSION) {
-    currentMode = MODE_CHORD;
-    chordPlayer.reset();
-    chordPlayer.setChord(&ChordLib::CM7);
-    Serial.println("Mode: CHORD (Cm7)");
+    sendParam(PARAM_PLAY_MODE, MODE_CHORD);
+    Serial.print("Mode: CHORD (");
+    Serial.print(ChordLib::ALL_CHORDS[selectedChordIndex]->name);
+    Serial.println(")");
   } else if (currentMode == MODE_CHORD) {
-    currentMode = MODE_SINGLE_NOTE;
+    sendParam(PARAM_PLAY_MODE, MODE_SINGLE_NOTE);
     Serial.println("Mode: SINGLE_NOTE (880Hz)");
   } else {
-    currentMode = MODE_PROGRESSION;
-    currentChordIndex = 0;
-    chordPlayer.setChordFromProgression(0, currentProgression, currentProgressionLength);
-    chordPlayer.reset();
-    lastChordChangeTime = millis();
-    Serial.println("Mode: PROGRESSION (Ebmaj7 -> Cm7 -> Abmaj7 -> Abmaj7)");
+    sendParam(PARAM_PLAY_MODE, MODE_PROGRESSION);
+    Serial.print("Mode: PROGRESSION (");
+    Serial.print(ChordLib::PROGRESSIONS[selectedProgressionIndex].name);
+    Serial.println(")");
   }
   
   // Waveform is maintained in global oscillator automatically
 }
 
-// ========== Button Polling (called from loop) ==========
-void handleButtonPress() {
-  // BOOT button with long-press detection
-  static unsigned long lastDebounceTime = 0;
-  static bool lastButtonState = HIGH;
-  bool buttonState = digitalRead(BOOT_BUTTON);
-  
-  // Debouncing
-  if (buttonState != lastButtonState) {
-    lastDebounceTime = millis();
-  }
+// ========== Menu Input ==========
+void sendMenuInput(MenuInput input) {
+  menuSystem.postInput(input);
+  frameScheduler.requestRedraw();  // Menu input is processed by the display task
+}
+
+// ========== Button Input (dispatched from loop) ==========
+// Single consumer for every button gesture; events carry their edge timestamp
+void dispatchInput(const InputEvent& event) {
+  bool menuOpen = menuSystem.isOpen();
   
-  if ((millis() - lastDebounceTime) > DEBOUNCE_DELAY) {
-    // Button state is stable
-    if (buttonState == LOW && !buttonIsPressed) {
-      // Button just pressed
-      buttonIsPressed = true;
-      buttonPressStartTime = millis();
-      buttonReleased = false;
-    } else if (buttonState == HIGH && buttonIsPressed) {
-      // Button just released
-      buttonIsPressed = false;
-      buttonReleased = true;
-      
-      unsigned long pressDuration = millis() - buttonPressStartTime;
-      
-      if (pressDuration < LONG_PRESS_THRESHOLD) {
-        // Short press - cycle waveform
-        cycleWaveform();
+  if (event.button == bootButtonId) {
+    // BOOT: short = waveform, long = mode, very long = menu
+    if (event.gesture != GESTURE_SHORT && event.gesture != GESTURE_LONG) {
+      return;
+    }
+    bool veryLong = event.durationMs >= VERY_LONG_PRESS_THRESHOLD;
+    
+    if (menuOpen) {
+      // In the menu: short = select, long = back, very long = exit
+      if (event.gesture == GESTURE_SHORT) {
+        sendMenuInput(MENU_INPUT_SELECT);
+      } else {
+        sendMenuInput(veryLong ? MENU_INPUT_EXIT : MENU_INPUT_BACK);
+      }
+    } else if (event.gesture == GESTURE_SHORT) {
+      cycleWaveform();
+    } else if (!veryLong) {
+      cycleMode();
+    } else {
+      sendMenuInput(MENU_INPUT_OPEN);
+      Serial.println("Menu opened");
+    }
+  } else if (event.button == okButtonId) {
+    // OK: short = waveform, long = view; in the menu short = select, hold = scroll
+    if (menuOpen) {
+      if (event.gesture == GESTURE_SHORT) {
+        sendMenuInput(MENU_INPUT_SELECT);
+      } else if (event.gesture == GESTURE_HOLD_REPEAT) {
+        sendMenuInput(MENU_INPUT_NEXT);
+      }
+    } else if (event.gesture == GESTURE_SHORT) {
+      cycleWaveform();
+      Serial.println("OK button pressed");
+    } else if (event.gesture == GESTURE_LONG) {
+      cycleView();
+      Serial.println("OK button long press");
+    }
+  } else if (event.button == backButtonId) {
+    // BACK: click = mode (menu: back), double click = view (menu: exit)
+    if (event.gesture == GESTURE_SHORT) {
+      if (menuOpen) {
+        sendMenuInput(MENU_INPUT_BACK);
       } else {
-        // Long press - cycle mode
         cycleMode();
       }
+      Serial.println("BACK button pressed");
+    } else if (event.gesture == GESTURE_DOUBLE) {
+      if (menuOpen) {
+        sendMenuInput(MENU_INPUT_EXIT);
+      } else {
+        cycleView();
+      }
+      Serial.println("BACK button double click");
     }
   }
   
-  lastButtonState = buttonState;
-  
-  // OK button (GPIO 13) - same as short press on BOOT (cycle waveform)
-  static unsigned long lastDebounceTimeOk = 0;
-  static bool lastOkButtonState = HIGH;
-  bool okButtonState = digitalRead(OK_BUTTON);
-  
-  if (okButtonState != lastOkButtonState) {
-    lastDebounceTimeOk = millis();
+#if INPUT_LATENCY_LOG
+  Serial.printf("Input: button %d gesture %d, %lu ms after edge\n",
+                event.button, event.gesture, (unsigned long)(millis() - event.timeMs));
+#endif
+}
+
+// ========== Serial Console ==========
+// Line commands on the USB serial port (console task, Core 0). Settings go
+// through sendParam() exactly like buttons and menu edits.
+
+// Parse a whole-word integer within [minValue, maxValue]
+bool parseIntArg(const char* text, int minValue, int maxValue, int& out) {
+  char* end;
+  long value = strtol(text, &end, 10);
+  if (end == text || *end != '\0' || value < minValue || value > maxValue) {
+    return false;
+  }
+  out = (int)value;
+  return true;
+}
+
+bool consoleWave(int argc, char* argv[]) {
+  if (argc != 2) return false;
+  for (int type = 0; type < OSC_COUNT; type++) {
+    if (strcasecmp(argv[1], Oscillator::getTypeName((OscillatorType)type)) == 0) {
+      selectWaveform((OscillatorType)type);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool consoleMode(int argc, char* argv[]) {
+  if (argc != 2) return false;
+  if (strcmp(argv[1], "prog") == 0) {
+    sendParam(PARAM_PLAY_MODE, MODE_PROGRESSION);
+  } else if (strcmp(argv[1], "chord") == 0) {
+    sendParam(PARAM_PLAY_MODE, MODE_CHORD);
+  } else if (strcmp(argv[1], "note") == 0) {
+    sendParam(PARAM_PLAY_MODE, MODE_SINGLE_NOTE);
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool consoleChord(int argc, char* argv[]) {
+  int number;
+  if (argc != 2 || !parseIntArg(argv[1], 1, ChordLib::NUM_CHORDS, number)) return false;
+  sendParam(PARAM_CHORD, number - 1);
+  Serial.println(ChordLib::ALL_CHORDS[number - 1]->name);
+  return true;
+}
+
+bool consoleProgression(int argc, char* argv[]) {
+  int number;
+  if (argc != 2 || !parseIntArg(argv[1], 1, ChordLib::NUM_PROGRESSIONS, number)) return false;
+  sendParam(PARAM_PROGRESSION, number - 1);
+  Serial.println(ChordLib::PROGRESSIONS[number - 1].name);
+  return true;
+}
+
+bool consoleUnison(int argc, char* argv[]) {
+  int count;
+  if (argc != 2 || !parseIntArg(argv[1], 1, NUM_UNISON, count)) return false;
+  sendParam(PARAM_UNISON_COUNT, count);
+  return true;
+}
+
+bool consoleDetune(int argc, char* argv[]) {
+  int cents;
+  if (argc != 2 || !parseIntArg(argv[1], 0, 50, cents)) return false;
+  sendParam(PARAM_UNISON_DETUNE, cents);
+  return true;
+}
+
+bool consoleBpm(int argc, char* argv[]) {
+  int bpm;
+  if (argc != 2 || !parseIntArg(argv[1], MIN_TEMPO_BPM, MAX_TEMPO_BPM, bpm)) return false;
+  sendParam(PARAM_TEMPO, bpm);
+  return true;
+}
+
+bool consoleFm(int argc, char* argv[]) {
+  int patch;
+  int depth = fmDepthSetting;
+  if (argc < 2 || argc > 3 || !parseIntArg(argv[1], 1, FmLib::NUM_PATCHES, patch)) return false;
+  if (argc == 3 && !parseIntArg(argv[2], 0, 200, depth)) return false;
+  sendParam(PARAM_FM_PATCH, patch - 1);
+  sendParam(PARAM_FM_DEPTH, depth);
+  return true;
+}
+
+// A registration number, or nine drawbar digits as written on the organ
+bool consoleOrgan(int argc, char* argv[]) {
+  if (argc != 2) return false;
+  int number;
+  if (strlen(argv[1]) == OrganLib::NUM_DRAWBARS) {
+    uint8_t drawbars[OrganLib::NUM_DRAWBARS];
+    if (!parseIntArg(argv[1], 0, 888888888, number) || !OrganLib::unpack(number, drawbars)) return false;
+    sendParam(PARAM_ORGAN_DRAWBARS, number);
+  } else {
+    if (!parseIntArg(argv[1], 1, OrganLib::NUM_REGISTRATIONS, number)) return false;
+    sendParam(PARAM_ORGAN_PRESET, number - 1);
+  }
+  return true;
+}
+
+bool consoleNoise(int argc, char* argv[]) {
+  int color;
+  if (argc != 2 || !parseIntArg(argv[1], 0, NoiseColor::MAX_COLOR, color)) return false;
+  sendParam(PARAM_NOISE_COLOR, color);
+  return true;
+}
+
+bool consoleSampleHold(int argc, char* argv[]) {
+  int rate;
+  int depth = shDepthSetting;
+  if (argc < 2 || argc > 3 || !parseIntArg(argv[1], 1, SampleAndHold::MAX_RATE_HZ, rate)) return false;
+  if (argc == 3 && !parseIntArg(argv[2], 0, 12, depth)) return false;
+  sendParam(PARAM_SH_RATE, rate);
+  sendParam(PARAM_SH_DEPTH, depth);
+  return true;
+}
+
+// No argument lists the bank; a number selects that sample
+bool consoleSample(int argc, char* argv[]) {
+  if (argc == 1) {
+    if (sampleBank.getCount() == 0) {
+      Serial.println("sample: bank is empty (flash a bank to the '" SAMPLE_BANK_SOURCE "' partition)");
+    }
+    for (int i = 0; i < sampleBank.getCount(); i++) {
+      const PcmSample* sample = sampleBank.getSample(i);
+      Serial.printf("  %c%2d %-16s %6u frames at %u Hz, root %u Hz, %s\n",
+                    (i + 1 == samplerSlotSetting) ? '>' : ' ', i + 1, sample->name,
+                    (unsigned)sample->frames, (unsigned)sample->sampleRate, (unsigned)(sample->rootHzQ8 >> 8),
+                    sample->isLooped() ? "looped" : "one-shot");
+    }
+    return true;
   }
+  int number;
+  if (argc != 2 || !parseIntArg(argv[1], 1, max(sampleBank.getCount(), 1), number)) return false;
+  sendParam(PARAM_SAMPLER_SLOT, number);
+  return true;
+}
+
+// Looper control; "export" streams the loop as a WAV (tools/receive_wav.py)
+bool consoleLoop(int argc, char* argv[]) {
+  if (argc != 2) return false;
+  static const struct { const char* name; LooperState state; } COMMANDS[] = {
+    {"rec", LOOPER_RECORDING}, {"play", LOOPER_PLAYING}, {"dub", LOOPER_OVERDUBBING},
+    {"stop", LOOPER_STOPPED}, {"clear", LOOPER_EMPTY}
+  };
+  for (const auto& command : COMMANDS) {
+    if (strcmp(argv[1], command.name) == 0) {
+      sendParam(PARAM_LOOPER, command.state);
+      return true;
+    }
+  }
+  if (strcmp(argv[1], "export") != 0) return false;
   
-  if ((millis() - lastDebounceTimeOk) > DEBOUNCE_DELAY) {
-    if (okButtonState == LOW && lastOkButtonState == HIGH) {
-      // OK button just pressed - cycle waveform
-      cycleWaveform();
-      Serial.println("OK button pressed");
+  // The audio task freezes the loop first: no record, overdub, clear or rate change until done
+  loopExportRequested = true;
+  for (int waited = 0; !loopExportHeld && waited < LOOP_EXPORT_HOLD_MS; waited++) {
+    vTaskDelay(pdMS_TO_TICKS(1));
+  }
+  uint32_t bytes = looper.getWavBytes();
+  LooperState state = looper.getState();
+  bool ok = loopExportHeld;
+  if (!ok) {
+    Serial.println("loop: audio task did not hold the loop, try again");
+  } else if (bytes == 0 || state == LOOPER_RECORDING || state == LOOPER_OVERDUBBING) {
+    Serial.println("loop: nothing to export (record a loop, then play or stop it)");
+    ok = false;
+  } else {
+    // Framed chunks follow the size line; log lines from other tasks fall between frames
+    Serial.printf("wav: %u bytes in %u chunks\n", (unsigned)bytes, (unsigned)looper.getExportChunks());
+    looper.exportWav(Serial);
+    Serial.println();
+  }
+  loopExportRequested = false;
+  return ok;
+}
+
+bool consoleRate(int argc, char* argv[]) {
+  int rate;
+  if (argc != 2 || !parseIntArg(argv[1], 1, 96000, rate)) return false;
+  int index = sampleRateIndex(rate);
+  if (index < 0) return false;
+  sendParam(PARAM_SAMPLE_RATE, index);
+  return true;
+}
+
+bool consoleOversample(int argc, char* argv[]) {
+  int factor;
+  if (argc != 2 || !parseIntArg(argv[1], 1, 2, factor)) return false;
+  sendParam(PARAM_OVERSAMPLE, factor);
+  return true;
+}
+
+// Time the chord render paths on a private player (console task, Core 0).
+// It shares only the read-only waveform tables, never the engine's state;
+// the fastest of BENCH_BLOCKS buffers is reported, so preemption by other
+// Core 0 tasks does not inflate the figure
+uint32_t benchBuffer(ChordPlayer& player) {
+  static SynthEngineConfig::Sample block[AUDIO_BUFFER_FRAMES];
+  uint32_t best = UINT32_MAX;
+  for (int run = 0; run < BENCH_BLOCKS; run++) {
+    uint32_t start = micros();
+    for (int i = 0; i < AUDIO_BUFFER_FRAMES; i += CHORD_RENDER_CHUNK) {
+      player.render(block + i, CHORD_RENDER_CHUNK);  // Same blocks as renderFrames()
     }
+    uint32_t elapsed = micros() - start;
+    if (elapsed < best) best = elapsed;
   }
+  vTaskDelay(1);  // Let the other Core 0 tasks run between configurations
+  return best;
+}
+
+bool consoleBench(int argc, char* argv[]) {
+  if (argc != 1) return false;
+  static ChordPlayer benchPlayer;
+  static UnisonConfig benchUnison;
+  const uint32_t budgetUs = audioBlockMicros;
   
-  lastOkButtonState = okButtonState;
+  benchPlayer.setOscillator(&oscillator);
+  benchPlayer.setUnisonConfig(&benchUnison);
+  benchPlayer.init(audioSampleRate);
+  benchPlayer.setChord(ChordLib::ALL_CHORDS[0]);
+  benchPlayer.setVoiceEngine(VOICES_TABLE);
   
-  // BACK button (GPIO 16) - same as long press on BOOT (cycle mode)
-  static unsigned long lastDebounceTimeBack = 0;
-  static bool lastBackButtonState = HIGH;
-  bool backButtonState = digitalRead(BACK_BUTTON);
+  Serial.printf("bench: %s, %d frames per buffer at %u Hz, budget %u us\n",
+                Oscillator::getTypeName(currentGlobalWaveform), AUDIO_BUFFER_FRAMES,
+                (unsigned)audioSampleRate, (unsigned)budgetUs);
+  for (int factor = 1; factor <= 2; factor++) {
+    benchPlayer.setOversampling(factor);
+    for (int count = 1; count <= NUM_UNISON; count++) {
+      benchUnison.setUnisonCount(count);
+      benchPlayer.recalculatePhaseIncrements();
+      uint32_t best = benchBuffer(benchPlayer);
+      Serial.printf("  %s x%d unison: %5u us/buffer, %3u%% of budget\n",
+                    (factor == 1) ? "table     " : "2x + FIR  ", count,
+                    (unsigned)best, (unsigned)(best * 100 / budgetUs));
+    }
+  }
+  benchPlayer.setOversampling(1);
   
-  if (backButtonState != lastBackButtonState) {
-    lastDebounceTimeBack = millis();
+  // FM stacks replace unison: one row per operator count
+  benchPlayer.setVoiceEngine(VOICES_FM);
+  const FmPatch* fmPatches[] = {&FmLib::BELL, &FmLib::EPIANO};
+  for (const FmPatch* patch : fmPatches) {
+    benchPlayer.setFmPatch(patch);
+    uint32_t best = benchBuffer(benchPlayer);
+    Serial.printf("  FM %d-op %-8s  : %5u us/buffer, %3u%% of budget\n", patch->stacks * 2, patch->name,
+                  (unsigned)best, (unsigned)(best * 100 / budgetUs));
   }
   
-  if ((millis() - lastDebounceTimeBack) > DEBOUNCE_DELAY) {
-    if (backButtonState == LOW && lastBackButtonState == HIGH) {
-      // BACK button just pressed - cycle mode
-      cycleMode();
-      Serial.println("BACK button pressed");
+  // Organ: cost grows with the partials left after culling, so show them per note
+  benchPlayer.setVoiceEngine(VOICES_ORGAN);
+  for (int r = 0; r < OrganLib::NUM_REGISTRATIONS; r++) {
+    benchPlayer.setOrganDrawbars(OrganLib::ALL_REGISTRATIONS[r]->drawbars);
+    int partials = 0;
+    for (int note = 0; note < benchPlayer.getNoteCount(); note++) {
+      partials += benchPlayer.getOrganPartialCount(note);
     }
+    uint32_t best = benchBuffer(benchPlayer);
+    Serial.printf("  organ %-8s  : %5u us/buffer, %3u%% of budget (%d partials, %u us per note)\n",
+                  OrganLib::ALL_REGISTRATIONS[r]->name, (unsigned)best, (unsigned)(best * 100 / budgetUs),
+                  partials, (unsigned)(best / benchPlayer.getNoteCount()));
   }
   
-  lastBackButtonState = backButtonState;
+  // Noise: one generator per note, white and through the color filter
+  benchPlayer.setVoiceEngine(VOICES_NOISE);
+  for (int color = 0; color <= NoiseColor::MAX_COLOR; color += NoiseColor::MAX_COLOR / 2) {
+    benchPlayer.setNoiseColor(color);
+    uint32_t best = benchBuffer(benchPlayer);
+    Serial.printf("  noise color %3d%% : %5u us/buffer, %3u%% of budget\n", color,
+                  (unsigned)best, (unsigned)(best * 100 / budgetUs));
+  }
+  
+  // Sampler: reads the mapped bank through the flash cache
+  const PcmSample* sample = sampleBank.getSample(samplerSlotSetting - 1);
+  if (sample != nullptr) {
+    benchPlayer.setVoiceEngine(VOICES_SAMPLER);
+    benchPlayer.setSamplerSample(sample);
+    uint32_t best = benchBuffer(benchPlayer);
+    Serial.printf("  sample %-10s : %5u us/buffer, %3u%% of budget\n", sample->name,
+                  (unsigned)best, (unsigned)(best * 100 / budgetUs));
+  }
+  return true;
+}
+
+bool consoleStats(int argc, char* argv[]) {
+  if (argc != 1) return false;
+  const uint32_t budgetUs = audioBlockMicros;
+  
+  Serial.printf("audio: %u buffers at %u Hz, render mean %u us (%u%% load), p99 %u us, peak %u us (budget %u us)\n",
+                (unsigned)audioBuffersRendered, (unsigned)audioSampleRate, (unsigned)renderHistogram.getMean(),
+                (unsigned)(renderHistogram.getMean() * 100 / budgetUs),
+                (unsigned)renderHistogram.getPercentile(99), (unsigned)renderHistogram.getMax(),
+                (unsigned)budgetUs);
+  Serial.printf("params: %u applied, latency mean %u us, peak %u us, %u dropped\n",
+                (unsigned)paramLatencyHistogram.getCount(), (unsigned)paramLatencyHistogram.getMean(),
+                (unsigned)paramLatencyHistogram.getMax(), (unsigned)paramQueue.getDroppedCount());
+  Serial.printf("display: %.1f FPS, frame %u us (peak %u us), %u frames\n",
+                frameScheduler.getFps(), (unsigned)frameScheduler.getLastFrameMicros(),
+                (unsigned)frameScheduler.getMaxFrameMicros(), (unsigned)frameScheduler.getFramesRendered());
+  Serial.printf("tempo: %d.%d BPM (%s)\n", progressionBpmTenths / 10, progressionBpmTenths % 10,
+                progressionClockSynced ? "MIDI clock" : "internal");
+#if MIDI_ENABLED && MIDI_UART_AVAILABLE
+  Serial.printf("midi: %u bytes, %u stray, %u dropped\n",
+                (unsigned)midiInput.getBytesReceived(), (unsigned)midiInput.getStrayBytes(),
+                (unsigned)midiQueue.getDroppedCount());
+#endif
+  Serial.printf("input: %u dropped edges, DIAL1 %s, DIAL2 %s\n", (unsigned)buttonInput.getDroppedEdges(),
+                potSampler.isDma(volumePotId) ? "DMA" : "oneshot",
+                potSampler.isDma(dial2PotId) ? "DMA" : "oneshot");
+  Serial.printf("power: %s at %d MHz%s, idle %d%% of uptime, %u switches, %u silent buffers\n",
+                powerManager.isIdle() ? "IDLE" : "ACTIVE", powerManager.getTargetMhz(),
+                powerManager.isDfsEnabled() ? "" : " (no DFS)", powerManager.getIdlePercent(),
+                (unsigned)powerManager.getTransitions(), (unsigned)audioBuffersSilent);
+  Serial.printf("looper: %s, %u of %u frames at %u Hz%s\n", Looper::getStateName(looper.getState()),
+                (unsigned)looper.getLengthFrames(), (unsigned)looper.getCapacityFrames(),
+                (unsigned)looper.getSampleRate(), looper.isInPsram() ? " (PSRAM)" : "");
+  Serial.printf("heap: %u free, %u minimum\n",
+                (unsigned)ESP.getFreeHeap(), (unsigned)ESP.getMinFreeHeap());
+  Serial.printf("stack: audio %u of %u bytes never used, display %u of %u\n",
+                (unsigned)uxTaskGetStackHighWaterMark(audioTaskHandle), (unsigned)AUDIO_TASK_STACK,
+                (unsigned)uxTaskGetStackHighWaterMark(displayTaskHandle), (unsigned)DISPLAY_TASK_STACK);
+  return true;
+}
+
+void printHistogram(const char* title, const LatencyHistogram& histogram) {
+  uint32_t count = histogram.getCount();
+  Serial.printf("%s: %u samples, p50 %u us, p99 %u us, max %u us\n", title, (unsigned)count,
+                (unsigned)histogram.getPercentile(50), (unsigned)histogram.getPercentile(99),
+                (unsigned)histogram.getMax());
+  
+  for (int i = 0; i < LatencyHistogram::NUM_BUCKETS; i++) {
+    uint32_t bucketCount = histogram.getBucketCount(i);
+    if (bucketCount == 0) {
+      continue;
+    }
+    char bar[41];
+    int length = (int)((uint64_t)bucketCount * 40 / count);
+    memset(bar, '#', length);
+    bar[length] = '\0';
+    Serial.printf("  >=%6u us %8u %s\n", (unsigned)LatencyHistogram::getBucketFloor(i),
+                  (unsigned)bucketCount, bar);
+  }
+}
+
+bool consoleHist(int argc, char* argv[]) {
+  if (argc == 2 && strcmp(argv[1], "reset") == 0) {
+    renderHistogram.requestReset();  // Cleared by the audio task on its next buffer
+    paramLatencyHistogram.requestReset();
+    frameScheduler.resetMaxFrameMicros();
+    return true;
+  }
+  if (argc != 1) return false;
+  printHistogram("render", renderHistogram);
+  printHistogram("param latency", paramLatencyHistogram);
+  return true;
 }
 
+bool consoleTrace(int argc, char* argv[]) {
+  if (argc != 2) return false;
+  if (strcmp(argv[1], "on") == 0) {
+    paramTraceEnabled = true;
+  } else if (strcmp(argv[1], "off") == 0) {
+    paramTraceEnabled = false;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+const ConsoleCommand CONSOLE_COMMANDS[] = {
+  {"wave",   "saw|sqr|tri|sine|fm|organ|noise|sample", "Select the waveform", consoleWave},
+  {"fm",     "<1-4> [depth 0-200]", "FM patch and modulation depth (%)",  consoleFm},
+  {"organ",  "<1-4>|<drawbars>",    "Organ registration, or 9 digits 0-8", consoleOrgan},
+  {"noise",  "<0-100>",          "Noise color (0 = white)",               consoleNoise},
+  {"loop",   "rec|play|dub|stop|clear|export", "Looper control, export = WAV", consoleLoop},
+  {"sample", "[number]",         "List the sample bank, or select a sample", consoleSample},
+  {"sh",     "<1-40> [0-12]",    "Sample-and-hold rate (Hz) and pitch depth (st)", consoleSampleHold},
+  {"mode",   "prog|chord|note",  "Select the play mode",                  consoleMode},
+  {"chord",  "<1-6>",            "Chord for CHORD mode",                  consoleChord},
+  {"prog",   "<1-2>",            "Progression for PROGRESSION mode",      consoleProgression},
+  {"unison", "<1-4>",            "Unison voices",                         consoleUnison},
+  {"detune", "<0-50>",           "Unison detune (cents)",                 consoleDetune},
+  {"bpm",    "<30-240>",         "Internal progression tempo",            consoleBpm},
+  {"oversample", "<1-2>",          "Chord render oversampling",             consoleOversample},
+  {"rate",   "22050|32000|44100|48000", "Engine sample rate (Hz)",        consoleRate},
+  {"bench",  "",                 "Time the chord render paths",           consoleBench},
+  {"stats",  "",                 "Audio, parameter, display, MIDI stats", consoleStats},
+  {"hist",   "[reset]",          "Render and parameter latency histograms", consoleHist},
+  {"trace",  "on|off",           "Log each applied parameter change",     consoleTrace}
+};
+
+SerialConsole serialConsole;
+
 // ========== Display Setup ==========
 void setupDisplay() {
   // Initialize I2C with custom pins (to avoid conflict with I2S GPIO22)
@@ -321,12 +1548,24 @@ void setupDisplay() {
 
   Serial.println("OLED display initialized successfully!");
   
-  // Show dazzling boot animation
-  BootAnimation::play(&display, SCREEN_WIDTH, SCREEN_HEIGHT);
+  // Start the dazzling boot animation - frames are drawn by the display task
+  bootAnimation.begin(&display, SCREEN_WIDTH, SCREEN_HEIGHT);
+  
+#if OLED_ASYNC_I2C && ASYNC_I2C_BUS_AVAILABLE
+  // From here on frames are queued and drawn-over while still transferring
+  if (oledAsyncBus.begin(&Wire, OLED_SDA, OLED_SCL, OLED_ADDRESS, OLED_I2C_CLOCK)) {
+    display.setBus(&oledAsyncBus);
+    Serial.println("OLED: asynchronous I2C transfers enabled");
+  } else {
+    Wire.begin(OLED_SDA, OLED_SCL);
+    Serial.println("OLED: async I2C unavailable, using blocking Wire transfers");
+  }
+#endif
 }
 
 // ========== Setup ==========
 void setup() {
+  setupStartTime = millis();
   Serial.begin(115200);
   delay(1000);
   
@@ -335,29 +1574,30 @@ void setup() {
   Serial.println("========================================");
   Serial.println();
 
-  // Initialize potentiometer pins
-  pinMode(DIAL1, INPUT);
-  pinMode(DIAL2, INPUT);
-  // Note: Not using analogSetAttenuation() to avoid conflict with I2S driver
+  // Start pot sampling before I2S: on the classic ESP32 the ADC DMA borrows I2S0,
+  // and the audio channel (I2S_NUM_AUTO) then takes I2S1
+  // DIAL1 (GPIO 4) is an ADC2 pin, which the DMA driver cannot stream - it is read
+  // by oversampled oneshot conversions in the same task; DIAL2 (GPIO 33) uses DMA
+  volumePotId = potSampler.addPot(DIAL1);
+  dial2PotId = potSampler.addPot(DIAL2, NUM_UNISON, UNISON_DIAL_HYSTERESIS);
+  potSampler.begin(0, 2);  // Core 0, above the display task
   Serial.println("DIAL1 (volume) initialized on GPIO 4");
   Serial.println("DIAL2 initialized on GPIO 33");
 
-  // Initialize buttons for polling
-  pinMode(BOOT_BUTTON, INPUT_PULLUP);
-  pinMode(OK_BUTTON, INPUT_PULLUP);
-  pinMode(BACK_BUTTON, INPUT_PULLUP);
+  // Initialize buttons (edge interrupts feed the gesture detectors; loop() consumes)
+  const GestureConfig bootGestures = {DEBOUNCE_DELAY, LONG_PRESS_THRESHOLD, 0, 0, 0};
+  const GestureConfig okGestures = {DEBOUNCE_DELAY, LONG_PRESS_THRESHOLD, 0,
+                                    HOLD_REPEAT_DELAY, HOLD_REPEAT_INTERVAL};
+  const GestureConfig backGestures = {DEBOUNCE_DELAY, LONG_PRESS_THRESHOLD, DOUBLE_CLICK_WINDOW, 0, 0};
+  bootButtonId = buttonInput.addButton(BOOT_BUTTON, bootGestures);
+  okButtonId = buttonInput.addButton(OK_BUTTON, okGestures);
+  backButtonId = buttonInput.addButton(BACK_BUTTON, backGestures);
+  buttonInput.begin();  // setup() and loop() share the Arduino loop task
   Serial.println("BOOT button initialized on GPIO 0 (short=waveform, long=mode)");
-  Serial.println("OK button initialized on GPIO 13 (cycle waveform)");
-  Serial.println("BACK button initialized on GPIO 16 (cycle mode)");
+  Serial.println("OK button initialized on GPIO 13 (short=waveform, long=scope/spectrum)");
+  Serial.println("BACK button initialized on GPIO 16 (click=mode, double=scope/spectrum)");
 
-  // Initialize display first
-  setupDisplay();
-  
-  // Initialize gauge with display reference and configuration
-  gauge.init(&display, SCREEN_WIDTH / 2, 45, 45, 28, 
-             WAVEFORM_LABELS, NUM_WAVEFORMS, WAVEFORM_ANGLES);
-  Serial.println("Gauge initialized");
-  
+  // Audio comes up first; the boot animation runs later in the display task
   // Build waveform tables once in global oscillator
   oscillator.buildTables();
   oscillator.setType(OSC_SAWTOOTH);  // Default waveform
@@ -368,13 +1608,52 @@ void setup() {
   chordPlayer.setUnisonConfig(&unisonConfig);
   chordPlayer.init(SAMPLE_RATE);
   Serial.println("Chord player initialized (using shared oscillator)");
+  
+  // PCM bank stays in flash; the sampler reads it through the cache
+  sampleBank.begin(SAMPLE_BANK_SOURCE);
+  chordPlayer.setSamplerSample(sampleBank.getSample(samplerSlotSetting - 1));
+  
+  // Loop region sized for the highest rate, so a rate change never reallocates
+  looper.begin(LOOPER_SECONDS, SAMPLE_RATES[NUM_SAMPLE_RATES - 1]);
   Serial.println("Unison config initialized (default: x1)");
   
+  // Set default mode to PROGRESSION with SAWTOOTH waveform (before audio starts)
+  currentMode = MODE_PROGRESSION;
+  engineMode = MODE_PROGRESSION;
+  currentGlobalWaveform = OSC_SAWTOOTH;
+  oscillator.setType(OSC_SAWTOOTH);  // Oscillator handles waveform
+  currentChordIndex = 0;
+  chordPlayer.setChordFromProgression(0, currentProgression, currentProgressionLength);
+  chordPlayer.reset();
+  lastChordChangeTime = millis();
+  
+  // Initialize gauge geometry and precompute both layouts (only the display task draws or animates it)
+  gauge.init(&display, SCREEN_WIDTH / 2, 45, 45, 28);
+  gaugeWaveformLayout = gauge.addLayout(WAVEFORM_LABELS, NUM_WAVEFORMS, WAVEFORM_ANGLES);
+  gaugeUnisonLayout = gauge.addLayout(UNISON_LABELS, NUM_UNISON, UNISON_ANGLES);
+  Serial.println("Gauge initialized");
+  
+  // MIDI IN: receive task on Core 0, messages reach the audio task by queue
+#if MIDI_ENABLED && MIDI_UART_AVAILABLE
+  if (midiInput.begin((uart_port_t)MIDI_UART, MIDI_RX_PIN, &midiQueue, MIDI_CHANNEL, 0, 3)) {
+    Serial.print("MIDI input on GPIO ");
+    Serial.print(MIDI_RX_PIN);
+    Serial.println(MIDI_CHANNEL == 0 ? " (omni)" : "");
+  }
+#endif
+  
   // Initialize I2S audio driver
   if (!i2sDriver.init(SAMPLE_RATE, I2S_BCLK, I2S_LRCLK, I2S_DOUT)) {
     Serial.println("ERROR: Failed to initialize I2S driver!");
     while (1) delay(1000);
   }
+  
+#if IDLE_POWER_SAVING
+  // Frequency scaling: full clock while rendering, minimum while idle
+  if (powerManager.begin(CPU_ACTIVE_MHZ, CPU_IDLE_MHZ)) {
+    Serial.printf("Power: DFS %d/%d MHz\n", CPU_ACTIVE_MHZ, CPU_IDLE_MHZ);
+  }
+#endif
 
   // Create mutex for volume synchronization
   volumeMutex = xSemaphoreCreateMutex();
@@ -388,34 +1667,43 @@ void setup() {
   xTaskCreatePinnedToCore(
     audioTask,           // Task function
     "AudioTask",         // Task name
-    4096,                // Stack size (bytes)
+    AUDIO_TASK_STACK,    // Stack size (bytes)
     NULL,                // Parameters
     2,                   // Priority (higher = more priority)
     &audioTaskHandle,    // Task handle
     1                    // Core 1
   );
   
+  // Initialize display (starts the boot animation without blocking)
+  setupDisplay();
+  
+  // Menu walks the constant tree; edits go through the parameter queue
+  menuSystem.init(&display, &MENU_ROOT_ITEM, getParamValue, setParamFromMenu);
+  Serial.println("Menu initialized");
+  
+  // Scope trace in the lower half: zero line at y=42, max 18 pixels each way
+  scope.init(&display, &scopeRing, 0, 42, SCREEN_WIDTH, 18, SCOPE_FULL_SCALE);
+  Serial.println("Scope initialized");
+  
+  // Spectrum bars between the volume bar and the bottom label
+  spectrum.init(&display, &scopeRing, 0, SCREEN_HEIGHT - 10, SCREEN_WIDTH, 36);
+  Serial.println("Spectrum initialized");
+  
   // Create display task on Core 0 (normal priority)
   xTaskCreatePinnedToCore(
     displayTask,         // Task function
     "DisplayTask",       // Task name
-    4096,                // Stack size (bytes)
+    DISPLAY_TASK_STACK,  // Stack size (bytes)
     NULL,                // Parameters
     1,                   // Priority (lower than audio)
     &displayTaskHandle,  // Task handle
     0                    // Core 0
   );
-
-  // Set default mode to PROGRESSION with SAWTOOTH waveform
-  currentMode = MODE_PROGRESSION;
-  currentGlobalWaveform = OSC_SAWTOOTH;
-  oscillator.setType(OSC_SAWTOOTH);  // Oscillator handles waveform
-  currentChordIndex = 0;
-  chordPlayer.setChordFromProgression(0, currentProgression, currentProgressionLength);
-  chordPlayer.reset();
-  lastChordChangeTime = millis();
   
   Serial.println("Setup complete!");
+  Serial.print("Setup took ");
+  Serial.print(millis() - setupStartTime);
+  Serial.println(" ms (boot animation continues in display task)");
   Serial.println("Default: PROGRESSION mode with SAWTOOTH waveform");
   Serial.println("Progression: Ebmaj7 -> Cm7 -> Abmaj7 -> Abmaj7 @ 75 BPM");
   Serial.print("Initial volume: ");
@@ -425,9 +1713,20 @@ void setup() {
   Serial.println();
   Serial.println("Button Controls:");
   Serial.println("  BOOT: Short press (<1s) = Cycle waveform, Long press (>=1s) = Cycle mode");
-  Serial.println("  OK (GPIO 13): Cycle waveform (SAW -> SQR -> TRI -> SIN)");
+  Serial.println("        Very long press (>=2s) = Menu (DIAL2 scrolls, OK selects, BACK goes back)");
+  Serial.println("  OK (GPIO 13): Short press = Cycle waveform, Long press = Scope/Spectrum view");
   Serial.println("  BACK (GPIO 16): Cycle mode (PROG -> CHORD -> NOTE)");
   Serial.println();
+  
+  // Serial console: idle-priority task on Core 0 (runs while the display task
+  // waits for its next frame), started last so its replies do not interleave
+  // with the startup log
+#if SERIAL_CONSOLE_ENABLED
+  if (serialConsole.begin(Serial, CONSOLE_COMMANDS, sizeof(CONSOLE_COMMANDS) / sizeof(CONSOLE_COMMANDS[0]),
+                          0, tskIDLE_PRIORITY)) {
+    Serial.println("Serial console ready (type help)");
+  }
+#endif
 }
 
 // ========== Audio Task (Core 1) ==========
@@ -435,26 +1734,52 @@ void audioTask(void *parameter) {
   Serial.println("Audio task started on Core 1");
   
   // Audio generation variables
-  const int frames = 512;  // Increased buffer size for smoother audio
-  int16_t buffer[frames * 2];  // 2 samples per frame (L,R)
-  static float phaseIndex = 0.0f;
-  const int tableSize = Oscillator::getTableSize();
-  const float phaseIncrement = (tableSize * TONE_FREQUENCY) / (float)SAMPLE_RATE;
+  const int frames = AUDIO_BUFFER_FRAMES;
+  SynthEngineConfig::Sample buffer[SynthEngineConfig::BLOCK_SAMPLES];  // Interleaved L,R
+  updateMidiPitch();  // Initial NOTE-mode increment (no key played yet)
+  
+  // MIDI that arrived during the previous buffer is rendered at the same
+  // offset within this one: one buffer of latency, no timing jitter
+  uint32_t lastBufferStartUs = micros();
+  MidiEvent pendingMidi;
+  bool hasPendingMidi = false;
   
   while (true) {
-    // Update volume from potentiometer (DIAL1)
-    int adcValue = analogRead(DIAL1);
-    static int smoothedADC = 2048;
-    smoothedADC = (smoothedADC * 7 + adcValue) / 8;
+    // Freeze the loop for an export, or release it and catch up (see Loop Export)
+    if (loopExportRequested && !loopExportHeld) {
+      loopExportHeld = true;
+    } else if (!loopExportRequested && loopExportHeld) {
+      loopExportHeld = false;
+      for (int i = 0; i < loopExportDeferredCount; i++) {
+        applyParamChange(loopExportDeferred[i]);
+      }
+      loopExportDeferredCount = 0;
+    }
+    
+    // Apply settings queued by buttons and the menu (never blocks)
+    ParamChange change;
+    while (paramQueue.pop(change)) {
+      applyParamChange(change);
+      uint32_t latencyUs = micros() - change.timeUs;
+      paramLatencyHistogram.record(latencyUs);
+      if (paramTraceEnabled) {
+        Serial.printf("trace: param %d = %d after %u us\n",
+                      (int)change.id, (int)change.value, (unsigned)latencyUs);
+      }
+    }
+    
+    // Update volume from potentiometer (DIAL1, already filtered by the sampler)
+    int volumeADC = potSampler.getValue(volumePotId);
     
     // Update shared variables with mutex protection
     if (xSemaphoreTake(volumeMutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-      float newAmplitude = smoothedADC / 4095.0f;
+      float newAmplitude = volumeADC / (float)PotSampler::ADC_MAX;
       if (newAmplitude < 0.05f) {
         newAmplitude = 0.0f;
       }
       
       // Log significant changes
+      int previousPercent = volumePercent;
       if (abs(newAmplitude - currentAmplitude) > 0.05f) {
         currentAmplitude = newAmplitude;
         volumePercent = (int)(currentAmplitude * 100);
@@ -465,44 +1790,34 @@ void audioTask(void *parameter) {
         currentAmplitude = newAmplitude;
         volumePercent = (int)(currentAmplitude * 100);
       }
+      bool volumeChanged = (volumePercent != previousPercent);
       
       xSemaphoreGive(volumeMutex);
+      
+      // Volume text and bar changed (matters when the screen is otherwise static)
+      if (volumeChanged) {
+        frameScheduler.requestRedraw();
+      }
     }
     
-    // Update unison from potentiometer (DIAL2) - only in chord modes
-    if (currentMode == MODE_CHORD || currentMode == MODE_PROGRESSION) {
-      int dial2Value = analogRead(DIAL2);
-      static int smoothedDial2 = 0;
-      smoothedDial2 = (smoothedDial2 * 7 + dial2Value) / 8;
-      
-      // Map ADC value (0-4095) to unison count (1-4) with hysteresis zones
-      // Divide into 4 zones with 20% hysteresis to prevent jitter
-      int newUnisonCount;
-      if (smoothedDial2 < 850) {
-        newUnisonCount = 1;
-      } else if (smoothedDial2 < 1900) {
-        newUnisonCount = 2;
-      } else if (smoothedDial2 < 2950) {
-        newUnisonCount = 3;
-      } else {
-        newUnisonCount = 4;
-      }
-      
-      // Detect changes and update
-      int currentUnisonCount = unisonConfig.getUnisonCount();
-      if (newUnisonCount != currentUnisonCount) {
-        // Update unison count
-        unisonConfig.setUnisonCount(newUnisonCount);
-        chordPlayer.recalculatePhaseIncrements();  // Recalculate with new detune
-        
-        // Reconfigure gauge for unison display
-        gauge.init(&display, SCREEN_WIDTH / 2, 45, 45, 28, 
-                   UNISON_LABELS, NUM_UNISON, UNISON_ANGLES);
+    // DIAL2 - unison in chord modes (menu navigation is read by loop())
+    // The sampler maps it to 4 zones with hysteresis, so it cannot jitter
+    int newUnisonCount = potSampler.getZone(dial2PotId) + 1;
+    
+    // Act only when the dial enters a new zone, so a count set from the menu
+    // is kept until the dial is actually turned
+    static int lastDialUnisonCount = 1;
+    bool dialZoneChanged = (newUnisonCount != lastDialUnisonCount);
+    lastDialUnisonCount = newUnisonCount;
+    
+    if (dialZoneChanged && !menuSystem.isOpen() &&
+        (currentMode == MODE_CHORD || currentMode == MODE_PROGRESSION)) {
+      if (newUnisonCount != unisonCountSetting) {
+        // Update unison count (applied at the start of the next buffer)
+        sendParam(PARAM_UNISON_COUNT, newUnisonCount);
         
-        // Start gauge animation to new unison angle
-        float targetAngle = getUnisonAngle(newUnisonCount);
-        gauge.startAnimation(targetAngle);
-        currentAnimation = ANIM_UNISON;
+        // Display task switches the gauge to the unison layout and animates it
+        requestUnisonGauge(newUnisonCount);
         
         // Log change
         Serial.print("Unison: x");
@@ -510,66 +1825,114 @@ void audioTask(void *parameter) {
       }
     }
     
+    // Tempo source: external MIDI clock while it arrives, else the internal timer
+    bool clockSynced = midiClock.hasClock(audioSampleTime,
+                                          audioSampleRate * MIDI_CLOCK_TIMEOUT_MS / 1000);
+    int bpmTenths = clockSynced ? midiClock.getBpmTenths(audioSampleRate) : 0;
+    if (bpmTenths == 0) {
+      bpmTenths = engineTempoBpm * 10;  // Not measured yet
+    }
+    if ((bpmTenths + 5) / 10 != (progressionBpmTenths + 5) / 10 ||
+        clockSynced != progressionClockSynced) {
+      frameScheduler.requestRedraw();
+    }
+    progressionBpmTenths = bpmTenths;
+    progressionClockSynced = clockSynced;
+    
     // Handle chord progression timing (only in PROGRESSION mode)
-    if (currentMode == MODE_PROGRESSION) {
-      unsigned long currentTime = millis();
-      if (currentTime - lastChordChangeTime >= CHORD_DURATION_MS) {
+    if (engineMode == MODE_PROGRESSION && !clockSynced) {
+      if (millis() - lastChordChangeTime >= chordDurationMs) {
         // Time to switch to next chord
-        currentChordIndex = (currentChordIndex + 1) % currentProgressionLength;
-        chordPlayer.setChordFromProgression(currentChordIndex, currentProgression, currentProgressionLength);
-        lastChordChangeTime = currentTime;
-        
-        // Log chord changes
-        Serial.print("Progression: ");
-        Serial.println(chordPlayer.getChordName());
+        setProgressionStep((currentChordIndex + 1) % currentProgressionLength);
       }
     }
     
-    // Generate audio buffer
-    float localAmplitude;
-    PlayMode localMode;
-    if (xSemaphoreTake(volumeMutex, pdMS_TO_TICKS(1)) == pdTRUE) {
-      localAmplitude = currentAmplitude;
-      localMode = currentMode;
-      xSemaphoreGive(volumeMutex);
+    // Sample-and-hold: a new random pitch offset at its rate (block granularity)
+    if (shDepthSemitones > 0 && sampleAndHold.tick(frames)) {
+      updateMidiPitch();
+    }
+    
+    // Generate audio buffer: DIAL1 as a Q15 gain (below 5% = mute, as shown)
+    int32_t volumeGain = (volumeADC * 20 < PotSampler::ADC_MAX) ? 0
+                         : (int32_t)(((int64_t)volumeADC << 15) / PotSampler::ADC_MAX);
+    
+    // Render up to each MIDI event's sample offset, apply it, continue
+    uint32_t bufferStartUs = micros();
+    int rendered = 0;
+    blockAudible = false;
+    while (hasPendingMidi || midiQueue.pop(pendingMidi)) {
+      hasPendingMidi = true;
+      if ((int32_t)(pendingMidi.timeUs - bufferStartUs) >= 0) {
+        break;  // Arrived during this buffer - it belongs to the next one
+      }
+      
+      int32_t ageUs = (int32_t)(pendingMidi.timeUs - lastBufferStartUs);
+      int offset = (ageUs <= 0) ? 0 : (int)(((int64_t)ageUs * audioSampleRate) / 1000000);
+      offset = constrain(offset, rendered, frames);
+      renderSpan(buffer, rendered, offset, volumeGain);
+      rendered = offset;
+      
+      applyMidiMessage(pendingMidi.message, audioSampleTime + offset);
+      hasPendingMidi = false;
+    }
+    renderSpan(buffer, rendered, frames, volumeGain);
+    
+    // Looper records, plays back or overdubs the finished bus
+    LooperState looperState = looper.getState();
+    if (looper.process(buffer, frames)) {
+      blockAudible = true;  // Loop playback keeps the synth active
+    }
+    if (looper.getState() != looperState) {
+      frameScheduler.requestRedraw();  // Full take turned into a loop
+    }
+    renderHistogram.record(micros() - bufferStartUs);
+    audioBuffersRendered++;
+    lastBufferStartUs = bufferStartUs;
+    audioSampleTime += frames;
+    
+    // Idle after a stretch of silent buffers, active again on the first sound
+    // (zeros are still written, so DMA depth and MIDI latency stay constant)
+    static uint32_t silentBuffers = 0;
+    if (blockAudible) {
+      silentBuffers = 0;
     } else {
-      localAmplitude = 1.0f;  // Fallback
-      localMode = MODE_SINGLE_NOTE;
+      silentBuffers++;
+      audioBuffersSilent++;
+    }
+    bool idle = silentBuffers * audioBlockMicros >= IDLE_ENTER_MS * 1000UL;
+    if (idle != powerManager.isIdle()) {
+      powerManager.setIdle(idle);
+      frameScheduler.requestRedraw();  // Live frames stop or restart
     }
     
-    // Generate samples based on current mode
-    if (localMode == MODE_SINGLE_NOTE) {
-      // Single note mode - use global oscillator
-      for (int i = 0; i < frames; i++) {
-        // Wrap phase index into table range
-        if (phaseIndex >= tableSize) {
-          phaseIndex -= tableSize;
+    // Publish a decimated mono copy for the scope (lock-free, never blocks)
+    if (!idle) {
+      for (int i = 0; i < SCOPE_BLOCK_SAMPLES; i++) {
+        int32_t sum = 0;
+        for (int k = 0; k < SCOPE_DECIMATION; k++) {
+          sum += buffer[(i * SCOPE_DECIMATION + k) * 2];
         }
-        
-        int idx = (int)phaseIndex;
-        int16_t sample = (int16_t)(oscillator.getSample(idx) * localAmplitude);
-        
-        // Stereo: copy same sample to L and R
-        buffer[i * 2 + 0] = sample;  // Left
-        buffer[i * 2 + 1] = sample;  // Right
-        
-        phaseIndex += phaseIncrement;
-      }
-    } else if (localMode == MODE_CHORD || localMode == MODE_PROGRESSION) {
-      // Chord modes - use ChordPlayer (handles both static and progression)
-      for (int i = 0; i < frames; i++) {
-        int16_t sample = (int16_t)(chordPlayer.getNextSample() * localAmplitude);
-        
-        // Stereo: copy same sample to L and R
-        buffer[i * 2 + 0] = sample;  // Left
-        buffer[i * 2 + 1] = sample;  // Right
+        scopeBlock[i] = (int16_t)(sum / SCOPE_DECIMATION);
       }
+      scopeRing.write(scopeBlock, SCOPE_BLOCK_SAMPLES);
     }
     
     // Output audio through I2S driver
     size_t bytesWritten = 0;
     i2sDriver.write(buffer, sizeof(buffer), &bytesWritten);
     
+    // Report startup-to-sound time once the first buffer is in the DMA queue
+    static bool firstBufferSent = false;
+    if (!firstBufferSent) {
+      firstBufferSent = true;
+      unsigned long now = millis();
+      Serial.print("Startup-to-sound: ");
+      Serial.print(now - setupStartTime);
+      Serial.print(" ms after setup() start (");
+      Serial.print(now);
+      Serial.println(" ms after reset)");
+    }
+    
     // Small yield to prevent watchdog issues
     taskYIELD();
   }
@@ -579,24 +1942,115 @@ void audioTask(void *parameter) {
 void displayTask(void *parameter) {
   Serial.println("Display task started on Core 0");
   
+  frameScheduler.begin();
+  int nextFps = DISPLAY_LIVE_FPS;  // First frame right away
+#if DISPLAY_STATS_LOG_MS > 0
+  unsigned long lastStatsTime = millis();
+#endif
+  
   while (true) {
-    updateDisplay();
-    vTaskDelay(pdMS_TO_TICKS(100));  // Update at 10 FPS
+    // Sleeps for the frame period, or until a redraw request when static
+    frameScheduler.waitForNextFrame(nextFps);
+    
+    frameScheduler.beginFrame();
+    nextFps = updateDisplay();
+    frameScheduler.endFrame();
+    
+#if DISPLAY_STATS_LOG_MS > 0
+    if (millis() - lastStatsTime >= DISPLAY_STATS_LOG_MS) {
+      lastStatsTime = millis();
+      Serial.printf("Display: %.1f FPS, frame %u us (peak %u us), %u frames\n",
+                    frameScheduler.getFps(),
+                    (unsigned)frameScheduler.getLastFrameMicros(),
+                    (unsigned)frameScheduler.getMaxFrameMicros(),
+                    (unsigned)frameScheduler.getFramesRendered());
+      frameScheduler.resetMaxFrameMicros();
+    }
+#endif
   }
 }
 
 // ========== Main Loop ==========
 void loop() {
-  // Handle button presses (short/long press detection)
-  handleButtonPress();
+  // Sleep until a button edge or gesture deadline; while the menu is open,
+  // also wake regularly so DIAL2 keeps scrolling
+  // (pending input is checked first: once the display task consumes it, isOpen() is set)
+  bool menuActive = menuSystem.hasPendingInput() || menuSystem.isOpen();
+  buttonInput.wait(menuActive ? MENU_DIAL_POLL_MS : ButtonInput::WAIT_FOREVER);
   
-  // Keep loop minimal to avoid interfering with tasks
-  delay(10);
+  InputEvent events[8];
+  int count = buttonInput.read(events, 8);
+  for (int i = 0; i < count; i++) {
+    dispatchInput(events[i]);
+  }
+  
+  // DIAL2 navigates while the menu is open
+  menuSystem.onDial(potSampler.getValue(dial2PotId));
 }
 
 
+// ========== Gauge Animation Requests ==========
+// Post a gauge animation for the display task and wake it (any task)
+void requestWaveformGauge(OscillatorType waveform) {
+  gaugeRequest.store((uint16_t)((ANIM_WAVEFORM << 8) | waveform), std::memory_order_release);
+  frameScheduler.requestRedraw();
+}
+
+void requestUnisonGauge(int unisonCount) {
+  gaugeRequest.store((uint16_t)((ANIM_UNISON << 8) | unisonCount), std::memory_order_release);
+  frameScheduler.requestRedraw();
+}
+
+/**
+ * Start the latest posted gauge animation (display task)
+ */
+void applyGaugeRequest() {
+  uint16_t request = gaugeRequest.exchange(0, std::memory_order_acquire);
+  if (request == 0) {
+    return;
+  }
+  AnimationMode mode = (AnimationMode)(request >> 8);
+  int value = request & 0xFF;
+  
+  if (mode == ANIM_UNISON) {
+    // Precomputed unison layout (no allocation)
+    gauge.selectLayout(gaugeUnisonLayout);
+    gauge.startAnimation(getUnisonAngle(value));
+  } else {
+    // Back from an unfinished unison animation first
+    if (gauge.getLayout() != gaugeWaveformLayout) {
+      gauge.selectLayout(gaugeWaveformLayout);
+    }
+    gauge.startAnimation(getWaveformAngle((OscillatorType)value));
+  }
+  currentAnimation = mode;
+}
+
 // ========== Update Display with Waveform ==========
-void updateDisplay() {
+// Returns the frame rate wanted for the next frame (0 = static until notified)
+int updateDisplay() {
+  applyGaugeRequest();
+  
+  // Boot animation owns the screen until it finishes (audio is already running)
+  if (bootAnimation.isRunning()) {
+    if (bootAnimation.render(millis())) {
+      display.update();
+      scopeRing.clear();
+      return DISPLAY_ANIMATION_FPS;
+    }
+    // Animation just finished - fall through to the first regular frame
+  }
+  
+  // Menu owns the screen while open; it is static until the next input
+  if (menuSystem.isOpen() || menuSystem.hasPendingInput()) {
+    if (menuSystem.update()) {
+      display.update();
+      scopeRing.clear();
+      return 0;
+    }
+    // Menu just closed - fall through to the regular screen
+  }
+  
   // Handle animations with gauge's built-in animation system
   if (gauge.isAnimating()) {
     const char* label = nullptr;
@@ -608,43 +2062,48 @@ void updateDisplay() {
         case OSC_SQUARE:   label = "SQR"; break;
         case OSC_TRIANGLE: label = "TRI"; break;
         case OSC_SINE:     label = "SIN"; break;
+        case OSC_FM:       label = "FM"; break;
+        case OSC_ORGAN:    label = "ORG"; break;
+        case OSC_NOISE:    label = "NSE"; break;
+        case OSC_SAMPLER:  label = "SMP"; break;
+        default:           break;
       }
     } else if (currentAnimation == ANIM_UNISON) {
       // Get unison label for display
-      int currentUnisonCount = unisonConfig.getUnisonCount();
-      label = UNISON_LABELS[currentUnisonCount - 1];  // x1, x2, x3, x4
+      label = UNISON_LABELS[unisonCountSetting - 1];  // x1, x2, x3, x4
     }
     
     // Draw gauge with animation and label
     gauge.drawWithLabel(label);
+    display.update();
+    
+    // Scope is hidden - drop stale audio so it resumes with fresh samples
+    scopeRing.clear();
     
     // Restore gauge to waveform configuration after unison animation completes
     if (currentAnimation == ANIM_UNISON && !gauge.isAnimating()) {
-      gauge.init(&display, SCREEN_WIDTH / 2, 45, 45, 28, 
-                 WAVEFORM_LABELS, NUM_WAVEFORMS, WAVEFORM_ANGLES);
+      gauge.selectLayout(gaugeWaveformLayout);
       currentAnimation = ANIM_NONE;
     } else if (currentAnimation == ANIM_WAVEFORM && !gauge.isAnimating()) {
       currentAnimation = ANIM_NONE;
     }
     
-    return;
+    // Keep animating; the frame after the hold switches back to the main view
+    return DISPLAY_ANIMATION_FPS;
   }
   
   // Read shared variables with mutex protection
-  float localAmplitude;
   int localVolumePercent;
   PlayMode localMode;
   int localChordIndex;
   
   if (xSemaphoreTake(volumeMutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-    localAmplitude = currentAmplitude;
     localVolumePercent = volumePercent;
     localMode = currentMode;
     localChordIndex = currentChordIndex;
     xSemaphoreGive(volumeMutex);
   } else {
     // Fallback if mutex unavailable
-    localAmplitude = 1.0f;
     localVolumePercent = 100;
     localMode = MODE_SINGLE_NOTE;
     localChordIndex = 0;
@@ -696,48 +2155,16 @@ void updateDisplay() {
     display.fillRect(2, 12, barWidth, 2, SSD1306_WHITE);
   }
   
-  // Draw center reference line for waveform
-  int centerY = 42;  // Lower half of screen for waveform
-  display.drawFastHLine(0, centerY, SCREEN_WIDTH, SSD1306_WHITE);
-  
-  // Draw waveform across the screen
-  // Show 2 complete cycles for clear visualization
-  static float animPhase = 0.0f;
-  animPhase += 0.1f;  // Animate the wave
-  if (animPhase >= TWO_PI) animPhase -= TWO_PI;
-  
-  // Scale waveform amplitude based on volume
-  float waveAmplitude = 18.0f * localAmplitude;  // Max 18 pixels height
-  
-  for (int x = 0; x < SCREEN_WIDTH; x++) {
-    float waveValue;
-    
-    if (localMode == MODE_SINGLE_NOTE) {
-      // Single sine wave for note mode
-      float angle = (TWO_PI * 2 * x / SCREEN_WIDTH) + animPhase;
-      waveValue = sin(angle);
-    } else {
-      // Combined waveform for chord modes
-      float time = (x / (float)SCREEN_WIDTH) * 0.1f + animPhase * 0.01f;
-      waveValue = chordPlayer.getDisplayValue(time);
-    }
-    
-    int y = centerY - (int)(waveAmplitude * waveValue);
+  if (currentView == VIEW_SPECTRUM) {
+    // Log-frequency spectrum of the real audio output (FFT runs here on Core 0)
+    spectrum.draw();
+  } else {
+    // Draw center reference line for waveform
+    int centerY = 42;  // Lower half of screen for waveform
+    display.drawFastHLine(0, centerY, SCREEN_WIDTH, SSD1306_WHITE);
     
-    // Draw the waveform
-    if (x > 0) {
-      float prevWaveValue;
-      if (localMode == MODE_SINGLE_NOTE) {
-        float prevAngle = (TWO_PI * 2 * (x - 1) / SCREEN_WIDTH) + animPhase;
-        prevWaveValue = sin(prevAngle);
-      } else {
-        float prevTime = ((x - 1) / (float)SCREEN_WIDTH) * 0.1f + animPhase * 0.01f;
-        prevWaveValue = chordPlayer.getDisplayValue(prevTime);
-      }
-      
-      int prevY = centerY - (int)(waveAmplitude * prevWaveValue);
-      display.drawLine(x - 1, prevY, x, y, SSD1306_WHITE);
-    }
+    // Draw the real audio output, trigger-aligned (volume and unison beating included)
+    scope.draw();
   }
   
   // Draw mode label at bottom left
@@ -746,17 +2173,26 @@ void updateDisplay() {
   if (localMode == MODE_SINGLE_NOTE) {
     display.print("A5 Note");
   } else if (localMode == MODE_PROGRESSION) {
-    display.print("75 BPM");
+    display.print((progressionBpmTenths + 5) / 10);
+    display.print(progressionClockSynced ? " BPM MIDI" : " BPM");
   } else {
     display.print("3 Notes");
   }
   
-  // Show mute indicator if volume is zero
+  // Show mute indicator if volume is zero, idle if silent for another reason
+  bool idle = powerManager.isIdle();
   if (localVolumePercent == 0) {
     display.setCursor(SCREEN_WIDTH - 24, SCREEN_HEIGHT - 8);
     display.print("MUTE");
+  } else if (idle) {
+    display.setCursor(SCREEN_WIDTH - 24, SCREEN_HEIGHT - 8);
+    display.print("IDLE");
   }
   
-  display.display();
+  // Push only the pages/columns that changed since the last frame
+  display.update();
+  
+  // A live trace moves only while there is sound; a muted or idle view is static
+  return (localVolumePercent > 0 && !idle) ? DISPLAY_LIVE_FPS : 0;
 }
 
@@ -0,0 +1,106 @@
+/**
+ * fft_accuracy_test.cpp
+ *
+ * FixedFFT against a double-precision DFT of the same Hann-windowed input,
+ * scaled the way powerSpectrum() documents: |X[k] / N|^2, so a sine of
+ * amplitude A peaks near (A/4)^2. Checks every bin of tones on and between
+ * bins, at full scale and low level, for both sizes the spectrum could use.
+ *
+ * Tolerances are in magnitude (sqrt of power), where Q15 rounding noise is
+ * additive: a fixed floor of MAGNITUDE_FLOOR LSBs plus PEAK_TOLERANCE of
+ * the reference magnitude.
+ */
+
+#include <Arduino.h>
+#include "../FixedFFT.h"
+#include <complex>
+#include <vector>
+
+HardwareSerial Serial;
+
+static const double MAGNITUDE_FLOOR = 4.0;   // LSBs of X/N
+static const double PEAK_TOLERANCE = 0.01;   // 1% of the reference magnitude
+
+struct Tone {
+  double bin;        // Frequency in bins (may be fractional)
+  double amplitude;  // Peak sample value
+};
+
+static int failures = 0;
+
+template <int N>
+static void reference(const int16_t* input, double* power) {
+  for (int k = 0; k < N / 2; k++) {
+    std::complex<double> sum = 0;
+    for (int n = 0; n < N; n++) {
+      double window = 0.5 - 0.5 * cos(2 * M_PI * n / N);
+      sum += input[n] * window * std::polar(1.0, -2 * M_PI * k * n / N);
+    }
+    power[k] = std::norm(sum / (double)N);
+  }
+}
+
+template <int N>
+static void check(const char* name, const std::vector<Tone>& tones) {
+  int16_t input[N];
+  for (int n = 0; n < N; n++) {
+    double v = 0;
+    for (const Tone& t : tones) v += t.amplitude * sin(2 * M_PI * t.bin * n / N);
+    input[n] = (int16_t)lround(constrain(v, -32767.0, 32767.0));
+  }
+
+  static FixedFFT<N> fft;
+  uint32_t fixed[N / 2];
+  double expected[N / 2];
+  fft.powerSpectrum(input, fixed);
+  reference<N>(input, expected);
+
+  int peakFixed = 0, peakExpected = 0, worstBin = 0;
+  double worstExcess = -1e30, worstError = 0;
+  for (int k = 0; k < N / 2; k++) {
+    if (fixed[k] > fixed[peakFixed]) peakFixed = k;
+    if (expected[k] > expected[peakExpected]) peakExpected = k;
+    double error = fabs(sqrt((double)fixed[k]) - sqrt(expected[k]));
+    double excess = error - (MAGNITUDE_FLOOR + PEAK_TOLERANCE * sqrt(expected[k]));
+    if (excess > worstExcess) {
+      worstExcess = excess;
+      worstBin = k;
+      worstError = error;
+    }
+  }
+
+  bool ok = (peakFixed == peakExpected) && (worstExcess <= 0);
+  printf("%-4s N=%3d %-24s peak bin %3d: %10u vs %12.0f (%+.3f dB), worst |mag err| %.2f at bin %d\n",
+         ok ? "ok" : "FAIL", N, name, peakFixed, (unsigned)fixed[peakFixed], expected[peakExpected],
+         10 * log10((fixed[peakFixed] + 1e-9) / (expected[peakExpected] + 1e-9)), worstError, worstBin);
+  if (!ok) failures++;
+}
+
+template <int N>
+static void checkSize() {
+  check<N>("full scale, bin 20", {{20, 32767}});
+  check<N>("engine peak, bin 3", {{3, 14000}});
+  check<N>("engine peak, bin 20.5", {{20.5, 14000}});
+  check<N>("engine peak, bin N/2-8", {{N / 2 - 8.0, 14000}});
+  check<N>("-40 dB, bin 37", {{37, 140}});
+  check<N>("chord, three tones", {{12, 4600}, {15.1, 4600}, {18, 4600}});
+}
+
+int main() {
+  checkSize<256>();
+  checkSize<512>();
+
+  // The documented scale: a sine of amplitude A peaks near (A/4)^2
+  int16_t input[512];
+  uint32_t power[256];
+  for (int n = 0; n < 512; n++) input[n] = (int16_t)lround(14000 * sin(2 * M_PI * 40 * n / 512));
+  static FixedFFT<512> fft;
+  fft.powerSpectrum(input, power);
+  double scale = power[40] / (3500.0 * 3500.0);
+  printf("%-4s A=14000 peak %u, (A/4)^2 = 12250000 (ratio %.3f)\n",
+         fabs(scale - 1) < 0.01 ? "ok" : "FAIL", (unsigned)power[40], scale);
+  if (fabs(scale - 1) >= 0.01) failures++;
+
+  printf(failures ? "FAIL: %d checks\n" : "PASS\n", failures);
+  return failures ? 1 : 0;
+}
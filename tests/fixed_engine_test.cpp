@@ -0,0 +1,176 @@
+/**
+ * fixed_engine_test.cpp
+ *
+ * The fixed-point engine (SYNTH_FIXED_POINT) against the float engine it
+ * replaces. Guards the integer pitch path end to end:
+ *   - FixedPitch::ratioQ20 against 2^(cents/1200) over the bend range,
+ *     including the clamp at +-MAX_OCTAVES
+ *   - FixedPitch::phaseIncrement against the exact 32-bit phase step, and
+ *     that no audible pitch overflows the accumulator's half cycle
+ *   - Rendered sine chords from both engines for unison 1-4, with and
+ *     without bend, compared right after init (same waveform and level) and
+ *     again one second later, where a step error in the increments has
+ *     turned into phase drift. The engine rounds chord notes to 1/256 Hz, so
+ *     some drift is by design; the later window allows what MAX_DRIFT_HZ of
+ *     frequency error accumulates in that second.
+ */
+
+#include <Arduino.h>
+#include "../ChordPlayer.h"
+#include <stdarg.h>
+
+HardwareSerial Serial;
+
+typedef SynthConfig<44100, 8, 4, 512, int16_t, false> FloatConfig;
+typedef SynthConfig<44100, 8, 4, 512, int16_t, true> FixedConfig;
+
+static const double MAX_RATIO_CENTS = 0.05;      // Q20 ratio error
+static const double MAX_INCREMENT_CENTS = 0.05;  // 32-bit phase step error
+static const double MAX_RMS_ERROR = 0.01;        // Fixed vs float output, share of signal RMS
+static const double MAX_DRIFT_HZ = 2.0 / 256;    // Two LSBs of a Q8 note frequency
+static const int WINDOW = 2048;
+
+static int failures = 0;
+
+static void report(bool ok, const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  printf("%-4s ", ok ? "ok" : "FAIL");
+  vprintf(format, args);
+  printf("\n");
+  va_end(args);
+  if (!ok) failures++;
+}
+
+static double centsBetween(double a, double b) {
+  return 1200.0 * log2(a / b);
+}
+
+static void checkRatio() {
+  const int32_t limit = FixedPitch::MAX_OCTAVES * FixedPitch::OCTAVE;
+  double worst = 0;
+  int32_t worstAt = 0;
+  uint32_t previous = 0;
+  bool monotonic = true;
+  for (int32_t c = -limit; c <= limit; c += 13) {
+    uint32_t ratio = FixedPitch::ratioQ20(c);
+    monotonic &= (ratio >= previous);
+    previous = ratio;
+    // Six octaves down leaves 14 bits of ratio; judge cents where Q20 still resolves them
+    if (abs(c) > 5 * FixedPitch::OCTAVE) continue;
+    double error = fabs(centsBetween(ratio / (double)FixedPitch::ONE, exp2(c / (double)FixedPitch::OCTAVE)));
+    if (error > worst) {
+      worst = error;
+      worstAt = c;
+    }
+  }
+  report(worst <= MAX_RATIO_CENTS, "ratioQ20 +-5 octaves: worst %.4f cents at %+.2f cents (limit %.2f)",
+         worst, worstAt / (double)FixedPitch::CENT, MAX_RATIO_CENTS);
+  report(monotonic, "ratioQ20 is monotonic over +-%d octaves", FixedPitch::MAX_OCTAVES);
+
+  bool clamped = FixedPitch::ratioQ20(limit + FixedPitch::OCTAVE) == FixedPitch::ratioQ20(limit) &&
+                 FixedPitch::ratioQ20(-limit - FixedPitch::OCTAVE) == FixedPitch::ratioQ20(-limit) &&
+                 FixedPitch::ratioQ20(0) == FixedPitch::ONE;
+  report(clamped, "ratioQ20(0) == ONE, offsets clamp at +-%d octaves", FixedPitch::MAX_OCTAVES);
+}
+
+static void checkIncrement() {
+  const uint32_t rates[] = {22050, 44100, 88200};  // Plain and 2x oversampled render rates
+  const int32_t bends[] = {-2 * FixedPitch::OCTAVE, -FixedPitch::SEMITONE, 0, 3333, 2 * FixedPitch::OCTAVE};
+  double worst = 0, worstFrequency = 0;
+  bool fits = true;
+  for (uint32_t rate : rates) {
+    for (int32_t bend : bends) {
+      uint32_t ratio = FixedPitch::ratioQ20(bend);
+      for (double frequency = 27.5; frequency < 8000; frequency *= 1.0137) {
+        uint32_t frequencyQ8 = (uint32_t)(frequency * 256 + 0.5);
+        double pitch = frequencyQ8 / 256.0 * ratio / FixedPitch::ONE;
+        if (pitch >= rate / 2.0) continue;
+        uint32_t increment = FixedPitch::phaseIncrement(frequencyQ8, ratio, rate);
+        fits &= (increment < 0x80000000u);
+        double exact = pitch * 4294967296.0 / rate;
+        double error = fabs(centsBetween(increment, exact));
+        if (error > worst) {
+          worst = error;
+          worstFrequency = pitch;
+        }
+      }
+    }
+  }
+  report(worst <= MAX_INCREMENT_CENTS, "phaseIncrement: worst %.4f cents at %.2f Hz (limit %.2f)",
+         worst, worstFrequency, MAX_INCREMENT_CENTS);
+  report(fits, "phaseIncrement below Nyquist stays under half a 32-bit cycle");
+
+  // Top of the range: Nyquist at the oversampled rate must not wrap the step
+  uint32_t nyquist = FixedPitch::phaseIncrement(44100u << 8, FixedPitch::ONE, 88200);
+  report(nyquist == 0x80000000u, "phaseIncrement(rate / 2) = 0x%08x (half cycle)", (unsigned)nyquist);
+}
+
+template <class Player>
+static void skip(Player& player, int samples) {
+  for (int i = 0; i < samples; i++) player.getNextSample();
+}
+
+static void checkRender() {
+  static BasicOscillator<FloatConfig> floatOsc;
+  static BasicOscillator<FixedConfig> fixedOsc;
+  floatOsc.buildTables();
+  fixedOsc.buildTables();
+  floatOsc.setType(OSC_SINE);
+  fixedOsc.setType(OSC_SINE);
+
+  // A sine off by a small phase d differs by about d (relative RMS)
+  double driftLimit = 2 * M_PI * MAX_DRIFT_HZ;
+
+  const int32_t bends[] = {0, 3333, -5 * FixedPitch::SEMITONE};
+  for (int unison = 1; unison <= 4; unison++) {
+    for (int32_t bend : bends) {
+      BasicUnisonConfig<FloatConfig> floatUnison;
+      BasicUnisonConfig<FixedConfig> fixedUnison;
+      floatUnison.setUnisonCount(unison);
+      fixedUnison.setUnisonCount(unison);
+      floatUnison.setBaseDetuneCents(13);
+      fixedUnison.setBaseDetuneCents(13);
+
+      BasicChordPlayer<FloatConfig> floatPlayer;
+      BasicChordPlayer<FixedConfig> fixedPlayer;
+      floatPlayer.setOscillator(&floatOsc);
+      fixedPlayer.setOscillator(&fixedOsc);
+      floatPlayer.setUnisonConfig(&floatUnison);
+      fixedPlayer.setUnisonConfig(&fixedUnison);
+      floatPlayer.init(44100);
+      fixedPlayer.init(44100);
+      floatPlayer.setPitchCents(bend);
+      fixedPlayer.setPitchCents(bend);
+
+      double relative[2];
+      int maxDiff = 0;
+      for (int window = 0; window < 2; window++) {
+        if (window == 1) {
+          skip(floatPlayer, 44100);
+          skip(fixedPlayer, 44100);
+        }
+        double error = 0, signal = 0;
+        for (int i = 0; i < WINDOW; i++) {
+          int a = floatPlayer.getNextSample(), b = fixedPlayer.getNextSample();
+          error += (double)(a - b) * (a - b);
+          signal += (double)a * a;
+          maxDiff = max(maxDiff, abs(a - b));
+        }
+        relative[window] = signal > 0 ? sqrt(error / signal) : 1;
+      }
+      report(relative[0] <= MAX_RMS_ERROR && relative[1] <= driftLimit,
+             "unison %d bend %+6.2f cents: rms error %.2f%% at start, %.2f%% after 1 s (limit %.2f%%), max diff %d",
+             unison, bend / (double)FixedPitch::CENT, relative[0] * 100, relative[1] * 100, driftLimit * 100,
+             maxDiff);
+    }
+  }
+}
+
+int main() {
+  checkRatio();
+  checkIncrement();
+  checkRender();
+  printf(failures ? "FAIL: %d checks\n" : "PASS\n", failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,117 @@
+/**
+ * gauge_bench.cpp
+ *
+ * Per-frame cost of Gauge::draw() (cached static layer + table needle)
+ * against a full redraw of the same gauge the way it was drawn before the
+ * cache: arc, ticks and labels re-rasterized with libm trig every frame.
+ * Both render into the same host framebuffer through the same rasterizer.
+ * Each run times both paths back to back, so a busy host slows both; the
+ * verdict uses the median speedup of RUNS runs. Fails if the cached frame
+ * is not at least MIN_SPEEDUP times cheaper.
+ */
+
+#include <Arduino.h>
+#include <Adafruit_SSD1306.h>
+#include "../Gauge.h"
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+HardwareSerial Serial;
+
+static const int FRAMES = 5000;
+static const int RUNS = 15;
+static const double MIN_SPEEDUP = 10.0;  // The order of magnitude the cache was for
+
+static const char* LABELS[] = {"SAW", "SQR", "TRI", "SIN", "FM", "ORG", "NSE", "SMP"};
+static const float ANGLES[] = {180.0f, 154.3f, 128.6f, 102.9f, 77.1f, 51.4f, 25.7f, 0.0f};
+static const int STOPS = 8;
+static const int CX = 64, CY = 45, RX = 45, RY = 28;
+
+/**
+ * The uncached gauge frame: everything drawn from float trig each time
+ */
+static void fullRedraw(Adafruit_SSD1306& d, float needle) {
+  for (float angle = 180.0f; angle >= 0.0f; angle -= 1.5f) {
+    float r = angle * PI / 180.0f;
+    d.drawPixel(CX + RX * cos(r), CY - RY * sin(r), SSD1306_WHITE);
+    d.drawPixel(CX + (RX - 2) * cos(r), CY - (RY - 2) * sin(r), SSD1306_WHITE);
+  }
+  for (int i = 0; i < STOPS; i++) {
+    float r = ANGLES[i] * PI / 180.0f;
+    d.drawLine(CX + (RX - 3) * cos(r), CY - (RY - 3) * sin(r),
+               CX + (RX + 3) * cos(r), CY - (RY + 3) * sin(r), SSD1306_WHITE);
+  }
+  d.setTextSize(1);
+  d.setTextColor(SSD1306_WHITE);
+  for (int i = 0; i < STOPS; i++) {
+    float r = ANGLES[i] * PI / 180.0f;
+    d.setCursor(CX + (RX + 9) * cos(r) - strlen(LABELS[i]) * 3, CY - (RY + 9) * sin(r) - 4);
+    d.print(LABELS[i]);
+  }
+  float r = needle * PI / 180.0f;
+  int nx = CX + (RX - 8) * cos(r), ny = CY - (RY - 8) * sin(r);
+  d.drawLine(CX, CY, nx, ny, SSD1306_WHITE);
+  d.drawLine(CX + 1, CY, nx + 1, ny, SSD1306_WHITE);
+  d.drawLine(CX, CY + 1, nx, ny + 1, SSD1306_WHITE);
+  d.fillTriangle(nx, ny, nx - 4 * cos(r + 2.5f), ny + 4 * sin(r + 2.5f),
+                 nx - 4 * cos(r - 2.5f), ny + 4 * sin(r - 2.5f), SSD1306_WHITE);
+  d.fillCircle(CX, CY, 3, SSD1306_WHITE);
+}
+
+static int litPixels(Adafruit_SSD1306& d) {
+  int count = 0;
+  for (int i = 0; i < 128 * 64 / 8; i++) count += __builtin_popcount(d.getBuffer()[i]);
+  return count;
+}
+
+template <class Frame>
+static double nanosPerFrame(Adafruit_SSD1306& d, Frame frame) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < FRAMES; i++) {
+    d.clearDisplay();
+    frame(i);
+  }
+  std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / FRAMES;
+}
+
+static double median(std::vector<double> values) {
+  std::sort(values.begin(), values.end());
+  return values[values.size() / 2];
+}
+
+int main() {
+  static Adafruit_SSD1306 display(128, 64, nullptr);
+  static Gauge gauge;
+  gauge.init(&display, CX, CY, RX, RY);
+  gauge.addLayout(LABELS, STOPS, ANGLES);
+
+  std::vector<double> fulls, cacheds, speedups;
+  int fullPixels = 0, cachedPixels = 0;
+  for (int run = 0; run < RUNS; run++) {
+    fulls.push_back(nanosPerFrame(display, [&](int i) { fullRedraw(display, (float)(i % 181)); }));
+    fullPixels = litPixels(display);
+    cacheds.push_back(nanosPerFrame(display, [&](int i) { gauge.setAngle((float)(i % 181)); gauge.draw(); }));
+    cachedPixels = litPixels(display);
+    speedups.push_back(fulls.back() / cacheds.back());
+  }
+
+  double speedup = median(speedups);
+  printf("full redraw   %8.0f ns/frame median (%d px lit)\n", median(fulls), fullPixels);
+  printf("cached layer  %8.0f ns/frame median (%d px lit)\n", median(cacheds), cachedPixels);
+  printf("speedup       %8.1fx median of %d runs, %.1fx-%.1fx (need %.0fx)\n", speedup, RUNS,
+         *std::min_element(speedups.begin(), speedups.end()),
+         *std::max_element(speedups.begin(), speedups.end()), MIN_SPEEDUP);
+
+  if (abs(fullPixels - cachedPixels) > fullPixels / 10) {
+    printf("FAIL: the two frames differ by more than 10%% of lit pixels\n");
+    return 1;
+  }
+  if (speedup < MIN_SPEEDUP) {
+    printf("FAIL: cached frame is not %.0fx cheaper\n", MIN_SPEEDUP);
+    return 1;
+  }
+  printf("PASS\n");
+  return 0;
+}
@@ -0,0 +1,112 @@
+/**
+ * Adafruit_GFX.h (host tests)
+ *
+ * Software rasterizer with the primitives the UI headers call, built on
+ * drawPixel() like the real library so drawing costs compare fairly on the
+ * host. Text uses a stand-in 5x8 glyph per character (same pixel work as
+ * the built-in font, not the same shapes).
+ */
+
+#ifndef HOST_ADAFRUIT_GFX_H
+#define HOST_ADAFRUIT_GFX_H
+
+#include <Arduino.h>
+
+class Adafruit_GFX : public Print {
+public:
+  Adafruit_GFX(int16_t w, int16_t h) : _width(w), _height(h), _cursorX(0), _cursorY(0),
+                                       _textSize(1), _textColor(1) {}
+
+  virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+
+  void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    int dx = abs(x1 - x0), sx = (x0 < x1) ? 1 : -1;
+    int dy = -abs(y1 - y0), sy = (y0 < y1) ? 1 : -1;
+    int err = dx + dy;
+    for (;;) {
+      drawPixel(x0, y0, color);
+      if (x0 == x1 && y0 == y1) break;
+      int e2 = 2 * err;
+      if (e2 >= dy) { err += dy; x0 += sx; }
+      if (e2 <= dx) { err += dx; y0 += sy; }
+    }
+  }
+
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    for (int i = 0; i < w; i++) drawPixel(x + i, y, color);
+  }
+
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    for (int j = 0; j < h; j++) drawFastHLine(x, y + j, w, color);
+  }
+
+  void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    for (int dy = -r; dy <= r; dy++) {
+      int dx = (int)sqrt((double)(r * r - dy * dy));
+      drawFastHLine(x0 - dx, y0 + dy, 2 * dx + 1, color);
+    }
+  }
+
+  void fillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                    int16_t x2, int16_t y2, uint16_t color) {
+    int top = min(y0, min(y1, y2)), bottom = max(y0, max(y1, y2));
+    for (int y = top; y <= bottom; y++) {
+      int left = 32767, right = -32768;
+      edge(x0, y0, x1, y1, y, left, right);
+      edge(x1, y1, x2, y2, y, left, right);
+      edge(x2, y2, x0, y0, y, left, right);
+      if (left <= right) drawFastHLine(left, y, right - left + 1, color);
+    }
+  }
+
+  void setTextSize(uint8_t size) { _textSize = size; }
+  void setTextColor(uint16_t color) { _textColor = color; }
+  void setTextColor(uint16_t color, uint16_t) { _textColor = color; }
+  void setCursor(int16_t x, int16_t y) { _cursorX = x; _cursorY = y; }
+
+  size_t write(uint8_t c) override {
+    if (c == '\n') {
+      _cursorX = 0;
+      _cursorY += 8 * _textSize;
+      return 1;
+    }
+    uint32_t bits = (uint32_t)c * 2654435761u;  // Stand-in glyph
+    for (int col = 0; col < 5; col++) {
+      uint8_t line = (uint8_t)(bits >> (col * 5)) | 0x41;
+      for (int row = 0; row < 8; row++) {
+        if (line & (1 << row)) {
+          fillRect(_cursorX + col * _textSize, _cursorY + row * _textSize, _textSize, _textSize, _textColor);
+        }
+      }
+    }
+    _cursorX += 6 * _textSize;
+    return 1;
+  }
+
+  size_t write(const uint8_t* buffer, size_t size) override {
+    for (size_t i = 0; i < size; i++) write(buffer[i]);
+    return size;
+  }
+
+  int16_t width() const { return _width; }
+  int16_t height() const { return _height; }
+
+protected:
+  int16_t _width;
+  int16_t _height;
+  int16_t _cursorX;
+  int16_t _cursorY;
+  uint8_t _textSize;
+  uint16_t _textColor;
+
+private:
+  static void edge(int x0, int y0, int x1, int y1, int y, int& left, int& right) {
+    if ((y < y0 && y < y1) || (y > y0 && y > y1)) return;
+    int x = (y0 == y1) ? x0 : x0 + (x1 - x0) * (y - y0) / (y1 - y0);
+    if (y0 == y1) { left = min(left, min(x0, x1)); right = max(right, max(x0, x1)); return; }
+    left = min(left, x);
+    right = max(right, x);
+  }
+};
+
+#endif // HOST_ADAFRUIT_GFX_H
@@ -0,0 +1,42 @@
+/**
+ * Adafruit_SSD1306.h (host tests)
+ *
+ * 1-bpp framebuffer in SSD1306 page layout; display() does nothing.
+ */
+
+#ifndef HOST_ADAFRUIT_SSD1306_H
+#define HOST_ADAFRUIT_SSD1306_H
+
+#include <Adafruit_GFX.h>
+#include <Wire.h>
+
+#define SSD1306_BLACK 0
+#define SSD1306_WHITE 1
+#define SSD1306_INVERSE 2
+
+class Adafruit_SSD1306 : public Adafruit_GFX {
+public:
+  Adafruit_SSD1306(uint8_t w, uint8_t h, TwoWire*, int8_t = -1) : Adafruit_GFX(w, h) {
+    _buffer = (uint8_t*)calloc(w * h / 8, 1);
+  }
+
+  ~Adafruit_SSD1306() { free(_buffer); }
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+    if (x < 0 || y < 0 || x >= _width || y >= _height) return;
+    uint8_t& b = _buffer[(y / 8) * _width + x];
+    uint8_t bit = (uint8_t)(1 << (y & 7));
+    if (color == SSD1306_WHITE) b |= bit;
+    else if (color == SSD1306_BLACK) b &= (uint8_t)~bit;
+    else b ^= bit;
+  }
+
+  void clearDisplay() { memset(_buffer, 0, _width * _height / 8); }
+  void display() {}
+  uint8_t* getBuffer() { return _buffer; }
+
+private:
+  uint8_t* _buffer;
+};
+
+#endif // HOST_ADAFRUIT_SSD1306_H
@@ -0,0 +1,77 @@
+/**
+ * Arduino.h (host tests)
+ *
+ * The slice of the Arduino core the engine and UI headers use, so they
+ * compile with a desktop g++. Serial writes to stdout.
+ */
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <math.h>
+#include <algorithm>
+#include <chrono>
+
+using std::min;
+using std::max;
+
+#define PI 3.1415926535897932384626433832795
+#define TWO_PI 6.283185307179586476925286766559
+#define IRAM_ATTR
+
+typedef uint8_t byte;
+
+template <class T, class L, class H>
+inline T constrain(T value, L low, H high) {
+  return (value < (T)low) ? (T)low : ((value > (T)high) ? (T)high : value);
+}
+
+// Wall clock since the first call, like the time since boot
+inline unsigned long micros() {
+  static const auto boot = std::chrono::steady_clock::now();
+  return (unsigned long)std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - boot).count();
+}
+inline unsigned long millis() { return micros() / 1000; }
+inline void delay(unsigned long) {}
+
+// ========== Print / Serial ==========
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) { return write(&c, 1); }
+  virtual size_t write(const uint8_t* buffer, size_t size) { return fwrite(buffer, 1, size, stdout); }
+
+  size_t print(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(int v) { return printf("%d", v); }
+  size_t println(const char* s = "") { return print(s) + print('\n'); }
+  size_t println(int v) { return printf("%d\n", v); }
+
+  size_t printf(const char* format, ...) {
+    char text[256];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    return write((const uint8_t*)text, min(length, (int)sizeof(text) - 1));
+  }
+};
+
+class Stream : public Print {
+public:
+  virtual int available() { return 0; }
+  virtual int read() { return -1; }
+};
+
+class HardwareSerial : public Stream {};
+
+extern HardwareSerial Serial;
+
+#endif // HOST_ARDUINO_H
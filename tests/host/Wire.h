@@ -0,0 +1,10 @@
+/**
+ * Wire.h (host tests) - no I2C on the host
+ */
+
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+class TwoWire {};
+
+#endif // HOST_WIRE_H
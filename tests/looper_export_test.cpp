@@ -0,0 +1,141 @@
+/**
+ * looper_export_test.cpp
+ *
+ * Looper::exportWav() into a port that other tasks also log to: a log line
+ * lands between every few writes, as "Progression:" and trace output would
+ * on the device. Reassembles the frames the way tools/receive_wav.py does
+ * (magic, index in sequence, length, CRC-32), and checks that the file is
+ * exactly the WAV header plus the loop and that every log line was left
+ * outside it.
+ *
+ *   looper_export_test [stream.bin]    (also writes the captured stream)
+ */
+
+#include <Arduino.h>
+#include "../Looper.h"
+#include <string>
+#include <vector>
+
+HardwareSerial Serial;
+
+static const uint32_t LOOP_RATE = 8000;
+static const uint32_t LOOP_FRAMES = 6001;  // Not a multiple of the chunk size
+static const int LOG_EVERY_WRITES = 7;
+static const char* LOG_LINE = "Progression: Cmaj7\n";
+
+/**
+ * The shared serial port: export frames plus another task's log lines
+ */
+class SharedPort : public Print {
+public:
+  std::vector<uint8_t> bytes;
+  int writes = 0;
+  int logLines = 0;
+
+  size_t write(const uint8_t* buffer, size_t size) override {
+    bytes.insert(bytes.end(), buffer, buffer + size);
+    if (++writes % LOG_EVERY_WRITES == 0) {
+      bytes.insert(bytes.end(), LOG_LINE, LOG_LINE + strlen(LOG_LINE));
+      logLines++;
+    }
+    return size;
+  }
+};
+
+static uint16_t le16(const uint8_t* p) {
+  return p[0] | (p[1] << 8);
+}
+
+static uint32_t le32(const uint8_t* p) {
+  return le16(p) | ((uint32_t)le16(p + 2) << 16);
+}
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+  printf("%-4s %s\n", ok ? "ok" : "FAIL", what);
+  if (!ok) failures++;
+}
+
+int main(int argc, char* argv[]) {
+  static const uint8_t CHECK_INPUT[] = "123456789";
+  check(Looper::crc32(CHECK_INPUT, 9) == 0xCBF43926u, "crc32(\"123456789\") == 0xCBF43926 (zlib.crc32)");
+
+  // Record a ramp the length of LOOP_FRAMES, then stop: the loop is the ramp
+  static Looper looper;
+  if (!looper.begin(1, LOOP_RATE)) return 1;
+  looper.setState(LOOPER_RECORDING, LOOP_RATE);
+  std::vector<int16_t> expected;
+  int16_t block[64 * Looper::CHANNELS];
+  for (uint32_t frame = 0; frame < LOOP_FRAMES; frame += 64) {
+    uint32_t count = min((uint32_t)64, LOOP_FRAMES - frame);
+    for (uint32_t i = 0; i < count * Looper::CHANNELS; i++) {
+      block[i] = (int16_t)((frame * Looper::CHANNELS + i) * 7);
+      expected.push_back(block[i]);
+    }
+    looper.process(block, count);
+  }
+  looper.setState(LOOPER_STOPPED, LOOP_RATE);
+
+  SharedPort port;
+  size_t written = looper.exportWav(port);
+  check(written == looper.getWavBytes(), "exportWav() reports every WAV byte");
+  check(port.writes == (int)looper.getExportChunks(), "one write per chunk");
+
+  // Receiver: skip text to the magic, then take a whole frame
+  std::vector<uint8_t> file;
+  std::string text;
+  uint32_t chunks = 0;
+  bool framesOk = true;
+  size_t at = 0;
+  while (at < port.bytes.size()) {
+    if (at + 4 > port.bytes.size() || memcmp(&port.bytes[at], Looper::EXPORT_MAGIC, 4) != 0) {
+      text += (char)port.bytes[at++];
+      continue;
+    }
+    uint16_t index = le16(&port.bytes[at + 4]);
+    uint16_t length = le16(&port.bytes[at + 6]);
+    size_t end = at + Looper::EXPORT_FRAME_OVERHEAD + length;
+    if (index != (uint16_t)chunks || length > Looper::EXPORT_CHUNK_BYTES || end > port.bytes.size() ||
+        Looper::crc32(&port.bytes[at + 4], 4 + length) != le32(&port.bytes[end - 4])) {
+      framesOk = false;
+      break;
+    }
+    file.insert(file.end(), &port.bytes[at + 8], &port.bytes[at + 8 + length]);
+    chunks++;
+    at = end;
+  }
+  check(framesOk && chunks == looper.getExportChunks(), "frames in sequence, lengths and CRCs valid");
+
+  bool header = file.size() == looper.getWavBytes() && memcmp(&file[0], "RIFF", 4) == 0 &&
+                memcmp(&file[8], "WAVE", 4) == 0 && le32(&file[24]) == LOOP_RATE &&
+                le16(&file[22]) == Looper::CHANNELS && le32(&file[40]) == LOOP_FRAMES * Looper::CHANNELS * 2;
+  check(header, "WAV header: size, rate, channels, data length");
+  check(file.size() == 44 + expected.size() * 2 && memcmp(&file[44], expected.data(), expected.size() * 2) == 0,
+        "WAV data is the loop, sample for sample");
+
+  std::string logs;
+  for (int i = 0; i < port.logLines; i++) logs += LOG_LINE;
+  check(port.logLines > 0 && text == logs, "every log line outside the file, none lost");
+
+  // Corrupt one payload byte: the receiver must notice
+  std::vector<uint8_t> damaged = port.bytes;
+  damaged[Looper::EXPORT_FRAME_OVERHEAD + 100] ^= 0x10;
+  uint16_t length = le16(&damaged[6]);
+  check(Looper::crc32(&damaged[4], 4 + length) != le32(&damaged[8 + length]), "a flipped bit fails the CRC");
+
+  printf("%u frames, %u WAV bytes, %d log lines interleaved\n", (unsigned)chunks, (unsigned)file.size(),
+         port.logLines);
+
+  if (argc > 1) {
+    FILE* out = fopen(argv[1], "wb");
+    if (out == nullptr || fwrite(port.bytes.data(), 1, port.bytes.size(), out) != port.bytes.size()) {
+      printf("FAIL: cannot write %s\n", argv[1]);
+      failures++;
+    }
+    if (out != nullptr) fclose(out);
+  }
+
+  printf(failures ? "FAIL: %d checks\n" : "PASS\n", failures);
+  return failures ? 1 : 0;
+}
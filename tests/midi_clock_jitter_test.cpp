@@ -0,0 +1,241 @@
+/**
+ * midi_clock_jitter_test.cpp
+ *
+ * Replays jittered 24 PPQN clock streams through MidiClockSync and the
+ * sketch's boundary policy (onMidiClock / renderSpan): on the tick before a
+ * chord boundary a locked loop schedules the step at the predicted tick;
+ * otherwise the step plays on the raw boundary tick. Checks time to lock,
+ * that lock holds, how many boundaries land on the predicted grid, their
+ * error against the ideal grid, tempo, and long-run drift.
+ *
+ * The first stream comes from data/midi_clock_120bpm_1ms.txt (arrival
+ * times in samples, one per line); the rest are generated with fixed seeds,
+ * one of them read in multi-byte bursts as MidiInput delivers ticks after
+ * its task has been held off.
+ *
+ *   midi_clock_jitter_test [stream.txt]
+ *   midi_clock_jitter_test --write out.txt <bpm> <jitter_ms> <ticks> <seed>
+ */
+
+#include "../MidiClockSync.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <random>
+#include <vector>
+
+static const uint32_t SAMPLE_RATE = 44100;
+static const int TICKS_PER_CHORD = 48;  // MIDI_CLOCK_TICKS_PER_CHORD
+
+struct Stream {
+  double bpm;                   // Tempo of the ideal grid
+  uint32_t origin;              // Sample time of ideal time 0
+  std::vector<double> ideal;    // Ideal tick times (samples from origin)
+  std::vector<uint32_t> times;  // Arrival times as the sketch sees them
+};
+
+struct Limits {
+  int lockTicks;        // Lock within this many ticks of the start (or of a tempo jump)
+  double lockedShare;   // Share of ticks locked once first locked
+  double gridShare;     // Share of boundaries after lock placed on the predicted grid
+  double maxErrorMs;    // Boundary error against the ideal grid
+  double maxDriftMs;    // Mean boundary error over the run
+};
+
+static double periodOf(double bpm) {
+  return SAMPLE_RATE * 60.0 / (bpm * MidiClockSync::PPQN);
+}
+
+/**
+ * Ideal grid at one or two tempos, plus uniform jitter of +/- jitterMs
+ */
+static Stream generate(double bpm, double jitterMs, int ticks, unsigned seed,
+                       uint32_t start = 1000, double jumpBpm = 0, int jumpTick = -1) {
+  std::mt19937 random(seed);
+  std::uniform_real_distribution<double> jitter(-jitterMs * SAMPLE_RATE / 1000, jitterMs * SAMPLE_RATE / 1000);
+  Stream stream;
+  stream.bpm = (jumpTick >= 0) ? jumpBpm : bpm;
+  stream.origin = start;
+  double t = 0;
+  for (int i = 0; i < ticks; i++) {
+    stream.ideal.push_back(t);
+    stream.times.push_back(start + (uint32_t)llround(t + jitter(random)));
+    t += periodOf((jumpTick >= 0 && i >= jumpTick) ? jumpBpm : bpm);
+  }
+  return stream;
+}
+
+/**
+ * Deliver a stream the way MidiInput reads it: the receive task wakes on each
+ * byte, but now and then it is held off (a higher priority task, flash
+ * writes) for up to stallMs. Every tick that arrives meanwhile comes in the
+ * same multi-byte read and all of them carry the read time.
+ */
+static Stream readInBursts(Stream stream, double stallMs, int ticksPerStall, unsigned seed) {
+  std::mt19937 random(seed);
+  std::uniform_real_distribution<double> stall(0, stallMs * SAMPLE_RATE / 1000);
+  std::uniform_int_distribution<int> stalls(0, ticksPerStall - 1);
+  uint32_t busyUntil = stream.times[0];
+  for (uint32_t& t : stream.times) {
+    if ((int32_t)(busyUntil - t) > 0) {
+      t = busyUntil;  // Read together with the tick that started the stall
+    } else if (stalls(random) == 0) {
+      busyUntil = t + (uint32_t)llround(stall(random));
+      t = busyUntil;
+    }
+  }
+  return stream;
+}
+
+static bool writeStream(const char* path, const Stream& stream, double jitterMs, unsigned seed) {
+  FILE* file = fopen(path, "w");
+  if (file == nullptr) return false;
+  fprintf(file, "# MIDI clock at %.1f BPM, 24 PPQN, %u Hz, uniform jitter +/-%.2f ms (seed %u)\n",
+          stream.bpm, (unsigned)SAMPLE_RATE, jitterMs, seed);
+  fprintf(file, "bpm %.3f\n", stream.bpm);
+  for (uint32_t t : stream.times) fprintf(file, "%u\n", (unsigned)t);
+  fclose(file);
+  return true;
+}
+
+/**
+ * Read "bpm <value>" and one arrival time per line; the ideal grid is a
+ * straight-line fit through the arrivals (the file carries no ideal times)
+ */
+static bool readStream(const char* path, Stream& stream) {
+  FILE* file = fopen(path, "r");
+  if (file == nullptr) {
+    printf("FAIL: cannot open %s\n", path);
+    return false;
+  }
+  char line[128];
+  stream.bpm = 0;
+  while (fgets(line, sizeof(line), file)) {
+    if (line[0] == '#') continue;
+    if (sscanf(line, "bpm %lf", &stream.bpm) == 1) continue;
+    stream.times.push_back((uint32_t)strtoul(line, nullptr, 10));
+  }
+  fclose(file);
+
+  double n = stream.times.size(), sx = 0, sy = 0, sxx = 0, sxy = 0;
+  for (size_t i = 0; i < stream.times.size(); i++) {
+    double y = (double)(uint32_t)(stream.times[i] - stream.times[0]);
+    sx += i; sy += y; sxx += (double)i * i; sxy += i * y;
+  }
+  double slope = (n * sxy - sx * sy) / (n * sxx - sx * sx);
+  double offset = (sy - slope * sx) / n;
+  stream.origin = stream.times[0];
+  for (size_t i = 0; i < stream.times.size(); i++) stream.ideal.push_back(offset + slope * i);
+  return stream.bpm > 0 && stream.times.size() > 2 * TICKS_PER_CHORD;
+}
+
+/**
+ * Run a stream through the clock and the boundary policy and check the limits
+ * @param settleTick Tick from which lock is measured (start, or a tempo jump)
+ */
+static bool run(const char* name, const Stream& stream, const Limits& limits, int settleTick = 0) {
+  MidiClockSync clock;
+  clock.onStart();
+
+  bool pending = false;
+  uint32_t pendingSample = 0;
+  int32_t pendingTick = 0, lastStepTick = -1;
+  int lockAt = -1, lockedTicks = 0, countedTicks = 0;
+  bool unlockedSinceSettle = false;  // A tempo jump has to drop the lock and re-earn it
+  int boundaries = 0, onGrid = 0;
+  double maxError = 0, sumError = 0;
+
+  auto step = [&](int32_t tick, uint32_t at, bool grid) {
+    lastStepTick = tick;
+    pending = false;
+    if (lockAt < 0 || tick < settleTick + 2 * TICKS_PER_CHORD) return;  // Still acquiring
+    double error = (double)(int32_t)(at - stream.origin) - stream.ideal[tick];
+    boundaries++;
+    onGrid += grid;
+    maxError = fmax(maxError, fabs(error));
+    sumError += error;
+  };
+
+  for (size_t i = 0; i < stream.times.size(); i++) {
+    uint32_t now = stream.times[i];
+
+    // renderSpan(): a scheduled step due before this tick plays first
+    if (pending && (int32_t)(pendingSample - now) <= 0) {
+      step(pendingTick, pendingSample, true);
+    }
+
+    // onMidiClock()
+    clock.onClock(now);
+    int32_t tick = clock.getTickCount();
+    bool scheduled = pending && pendingTick == tick && clock.isLocked();
+    if (tick % TICKS_PER_CHORD == 0 && tick != lastStepTick && !scheduled) {
+      step(tick, now, false);
+    }
+    if (clock.isLocked() && (tick + 1) % TICKS_PER_CHORD == 0) {
+      pending = true;
+      pendingTick = tick + 1;
+      pendingSample = clock.predictTick(tick + 1);
+    }
+
+    if ((int)i >= settleTick) {
+      unlockedSinceSettle |= !clock.isLocked();
+      if (lockAt < 0 && unlockedSinceSettle && clock.isLocked()) lockAt = (int)i - settleTick;
+      if (lockAt >= 0) {
+        countedTicks++;
+        lockedTicks += clock.isLocked();
+      }
+    }
+  }
+
+  double lockedShare = countedTicks ? (double)lockedTicks / countedTicks : 0;
+  double gridShare = boundaries ? (double)onGrid / boundaries : 0;
+  double maxErrorMs = maxError * 1000 / SAMPLE_RATE;
+  double driftMs = boundaries ? sumError / boundaries * 1000 / SAMPLE_RATE : 0;
+  double bpm = clock.getBpmTenths(SAMPLE_RATE) / 10.0;
+
+  bool ok = lockAt >= 0 && lockAt <= limits.lockTicks && lockedShare >= limits.lockedShare &&
+            gridShare >= limits.gridShare && boundaries > 0 && maxErrorMs <= limits.maxErrorMs &&
+            fabs(driftMs) <= limits.maxDriftMs && fabs(bpm - stream.bpm) <= 0.5;
+  printf("%-4s %-26s lock after %3d ticks, locked %5.1f%%, %3d/%3d boundaries on grid, "
+         "max err %.2f ms, drift %+.3f ms, %.1f BPM\n",
+         ok ? "ok" : "FAIL", name, lockAt, lockedShare * 100, onGrid, boundaries, maxErrorMs, driftMs, bpm);
+  return ok;
+}
+
+int main(int argc, char* argv[]) {
+  if (argc == 7 && strcmp(argv[1], "--write") == 0) {
+    double jitterMs = atof(argv[4]);
+    unsigned seed = (unsigned)atoi(argv[6]);
+    Stream stream = generate(atof(argv[3]), jitterMs, atoi(argv[5]), seed);
+    return writeStream(argv[2], stream, jitterMs, seed) ? 0 : 1;
+  }
+
+  // Sub-millisecond grid from a +/-1 ms clock, locked within two beats
+  const Limits tight = {48, 0.99, 0.99, 1.0, 0.1};
+  // +/-2 ms: lock within three beats, boundary error below the raw jitter
+  const Limits loose = {72, 0.99, 0.99, 2.0, 0.2};
+
+  int failures = 0;
+  Stream file;
+  const char* path = (argc > 1) ? argv[1] : "data/midi_clock_120bpm_1ms.txt";
+  if (!readStream(path, file)) {
+    printf("FAIL: %s is not a clock stream\n", path);
+    failures++;
+  } else {
+    failures += !run("file, 120 BPM +/-1 ms", file, tight);
+  }
+
+  failures += !run("120 BPM +/-0.25 ms", generate(120, 0.25, 24000, 1), tight);
+  failures += !run("120 BPM +/-0.5 ms", generate(120, 0.5, 24000, 2), tight);
+  failures += !run("120 BPM +/-1 ms", generate(120, 1.0, 24000, 3), tight);
+  failures += !run("120 BPM +/-2 ms", generate(120, 2.0, 24000, 4), loose);
+  failures += !run("60 BPM +/-1 ms", generate(60, 1.0, 12000, 5), tight);
+  failures += !run("180 BPM +/-1 ms", generate(180, 1.0, 24000, 6), tight);
+  failures += !run("sample counter wraps", generate(120, 1.0, 4800, 7, 0xFFF00000u), tight);
+  failures += !run("120 BPM multi-byte reads", readInBursts(generate(120, 0.25, 24000, 9), 30, 48, 10), tight);
+  failures += !run("jump 120 -> 90 BPM", generate(120, 1.0, 9600, 8, 1000, 90, 4800), tight, 4800);
+
+  printf(failures ? "FAIL: %d streams\n" : "PASS\n", failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,45 @@
+/**
+ * midi_parser_test.cpp
+ *
+ * Replays a MIDI byte stream from a file through MidiParser and checks the
+ * messages and the stray-byte count against the file's expectations.
+ *
+ *   midi_parser_test [stream.txt]    (default data/midi_stream.txt)
+ */
+
+#include "../MidiParser.h"
+#include "midi_stream_file.h"
+
+static const uint32_t EXPECTED_STRAY_BYTES = 3;  // For the default stream
+
+int main(int argc, char* argv[]) {
+  const char* path = (argc > 1) ? argv[1] : "data/midi_stream.txt";
+  MidiStreamFile stream;
+  if (!stream.load(path)) {
+    return 1;
+  }
+
+  MidiParser parser;
+  std::vector<MidiMessage> received;
+  size_t bytes = 0;
+  for (const std::vector<uint8_t>& chunk : stream.chunks) {
+    for (uint8_t byte : chunk) {
+      MidiMessage message;
+      if (parser.parse(byte, message)) {
+        received.push_back(message);
+      }
+      bytes++;
+    }
+  }
+
+  int failures = stream.compare(received);
+  printf("%zu bytes, %zu messages (%zu expected), %u stray bytes\n", bytes, received.size(),
+         stream.expected.size(), (unsigned)parser.getStrayBytes());
+  if (argc == 1 && parser.getStrayBytes() != EXPECTED_STRAY_BYTES) {
+    printf("  stray bytes: want %u\n", (unsigned)EXPECTED_STRAY_BYTES);
+    failures++;
+  }
+
+  printf(failures ? "FAIL\n" : "PASS\n");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,105 @@
+/**
+ * midi_pty_test.cpp
+ *
+ * Integration test of the MIDI receive path through a pseudo-terminal
+ * instead of the UART: MidiInput's host port opens the slave side, the
+ * test writes the stream file's bytes to the master side chunk by chunk,
+ * and the timestamped events are read back from the MidiQueue. Runs once
+ * in omni mode and once filtered to channel 2.
+ *
+ * Not covered: the ESP32 read itself (block for one byte, then take what
+ * the UART driver has buffered). Only the host port's read() runs here.
+ *
+ *   midi_pty_test [stream.txt]    (default data/midi_stream.txt)
+ */
+
+#include <Arduino.h>
+#include "../MidiInput.h"
+#include "midi_stream_file.h"
+
+HardwareSerial Serial;
+
+static const int CHUNK_GAP_US = 2000;     // Between chunks, so arrival times differ
+static const int RECEIVE_TIMEOUT_MS = 2000;
+
+static int runThroughPty(const MidiStreamFile& stream, int channel) {
+  int master = posix_openpt(O_RDWR | O_NOCTTY);
+  if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) {
+    printf("FAIL: no pty available\n");
+    return 1;
+  }
+  termios raw;
+  tcgetattr(master, &raw);
+  cfmakeraw(&raw);
+  tcsetattr(master, TCSANOW, &raw);
+
+  MidiQueue queue;
+  MidiInput input;
+  if (!input.begin(ptsname(master), &queue, channel)) {
+    close(master);
+    return 1;
+  }
+
+  std::vector<MidiMessage> expected;
+  for (const MidiMessage& message : stream.expected) {
+    if (message.status >= 0xF0 || channel == 0 || message.channel() == channel - 1) {
+      expected.push_back(message);
+    }
+  }
+
+  for (const std::vector<uint8_t>& chunk : stream.chunks) {
+    if (write(master, chunk.data(), chunk.size()) != (ssize_t)chunk.size()) {
+      printf("FAIL: pty write\n");
+    }
+    usleep(CHUNK_GAP_US);
+  }
+
+  std::vector<MidiMessage> received;
+  int failures = 0;
+  uint32_t firstUs = 0, lastUs = 0;
+  for (uint32_t start = millis(); received.size() < expected.size() &&
+       millis() - start < RECEIVE_TIMEOUT_MS; ) {
+    MidiEvent event;
+    if (!queue.pop(event)) {
+      usleep(1000);
+      continue;
+    }
+    bool ordered = received.empty() || (int32_t)(event.timeUs - lastUs) >= 0;
+    if (!ordered || (int32_t)(event.timeUs - micros()) > 0) {
+      printf("  event %zu: timestamp %u out of order\n", received.size(), (unsigned)event.timeUs);
+      failures++;
+    }
+    if (received.empty()) firstUs = event.timeUs;
+    lastUs = event.timeUs;
+    received.push_back(event.message);
+  }
+  usleep(20000);  // Anything extra would have arrived by now
+  MidiEvent extra;
+  while (queue.pop(extra)) {
+    received.push_back(extra.message);
+  }
+
+  input.end();
+  close(master);
+
+  MidiStreamFile filtered = stream;
+  filtered.expected = expected;
+  failures += filtered.compare(received);
+  printf("%-4s channel %-4s %zu events of %zu expected, %u bytes read, %u stray, %u us first to last\n",
+         failures ? "FAIL" : "ok", channel ? "2" : "omni", received.size(), expected.size(),
+         (unsigned)input.getBytesReceived(), (unsigned)input.getStrayBytes(),
+         (unsigned)(lastUs - firstUs));
+  return failures;
+}
+
+int main(int argc, char* argv[]) {
+  const char* path = (argc > 1) ? argv[1] : "data/midi_stream.txt";
+  MidiStreamFile stream;
+  if (!stream.load(path)) {
+    return 1;
+  }
+
+  int failures = runThroughPty(stream, 0) + runThroughPty(stream, 2);
+  printf(failures ? "FAIL\n" : "PASS\n");
+  return failures ? 1 : 0;
+}
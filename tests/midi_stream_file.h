@@ -0,0 +1,70 @@
+/**
+ * midi_stream_file.h
+ *
+ * Loads a MIDI test stream (see data/midi_stream.txt): chunks of bytes to
+ * send and the messages the parser must produce from them.
+ */
+
+#ifndef MIDI_STREAM_FILE_H
+#define MIDI_STREAM_FILE_H
+
+#include "../MidiParser.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+struct MidiStreamFile {
+  std::vector<std::vector<uint8_t>> chunks;  // One per "<" line
+  std::vector<MidiMessage> expected;         // One per ">" line
+
+  bool load(const char* path) {
+    FILE* file = fopen(path, "r");
+    if (file == nullptr) {
+      printf("FAIL: cannot open %s\n", path);
+      return false;
+    }
+    char line[256];
+    while (fgets(line, sizeof(line), file)) {
+      std::vector<uint8_t> bytes;
+      char* p = line + 1;
+      char* end;
+      for (long v = strtol(p, &end, 16); end != p; v = strtol(p, &end, 16)) {
+        bytes.push_back((uint8_t)v);
+        p = end;
+      }
+      if (line[0] == '<') {
+        chunks.push_back(bytes);
+      } else if (line[0] == '>' && bytes.size() == 3) {
+        expected.push_back({bytes[0], bytes[1], bytes[2]});
+      }
+    }
+    fclose(file);
+    return true;
+  }
+
+  /**
+   * Compare received messages with the expected ones, printing each mismatch
+   * @return Number of mismatches (missing and extra messages count)
+   */
+  int compare(const std::vector<MidiMessage>& received) const {
+    int mismatches = 0;
+    size_t count = received.size() > expected.size() ? received.size() : expected.size();
+    for (size_t i = 0; i < count; i++) {
+      bool haveGot = i < received.size(), haveWant = i < expected.size();
+      if (haveGot && haveWant && received[i].status == expected[i].status &&
+          received[i].data1 == expected[i].data1 && received[i].data2 == expected[i].data2) {
+        continue;
+      }
+      mismatches++;
+      printf("  message %zu: got ", i);
+      if (haveGot) printf("%02X %02X %02X", received[i].status, received[i].data1, received[i].data2);
+      else printf("nothing");
+      printf(", want ");
+      if (haveWant) printf("%02X %02X %02X\n", expected[i].status, expected[i].data1, expected[i].data2);
+      else printf("nothing\n");
+    }
+    return mismatches;
+  }
+};
+
+#endif // MIDI_STREAM_FILE_H
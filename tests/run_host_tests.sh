@@ -0,0 +1,36 @@
+#!/bin/bash
+#
+# Build and run the host tests with the desktop compiler.
+# Each tests/*.cpp is one program; a non-zero exit fails the run.
+#
+#   tests/run_host_tests.sh            # all tests
+#   tests/run_host_tests.sh gauge      # tests whose name contains "gauge"
+#
+
+set -u
+
+cd "$(dirname "$0")"
+CXX=${CXX:-g++}
+BUILD_DIR=${BUILD_DIR:-/tmp/chord-synth-host-tests}
+mkdir -p "$BUILD_DIR"
+
+failed=0
+for source in *.cpp; do
+    name="${source%.cpp}"
+    if [ $# -gt 0 ] && [[ "$name" != *"$1"* ]]; then
+        continue
+    fi
+
+    echo "=== $name"
+    if ! $CXX -std=gnu++17 -O2 -Wall -Wextra -Ihost -I.. "$source" -o "$BUILD_DIR/$name"; then
+        echo "--- $name: BUILD FAILED"
+        failed=1
+        continue
+    fi
+    if ! "$BUILD_DIR/$name"; then
+        echo "--- $name: FAILED"
+        failed=1
+    fi
+done
+
+exit $failed
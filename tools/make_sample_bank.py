@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+"""
+Build a SampleBank image (see SampleBank.h) from 16-bit WAV files.
+
+Each argument is  file.wav[:root_hz[:loop_start]]  where root_hz is the
+pitch recorded in the file (default 261.63, middle C) and loop_start the
+first frame of the sustain loop, which runs to the end of the file
+(default: no loop, the sample plays once). Stereo files are mixed to mono.
+
+    tools/make_sample_bank.py -o bank.bin piano.wav:261.63 pad.wav:220:4410
+
+Flash the image to the "samples" partition (partitions.csv):
+
+    parttool.py --port /dev/ttyUSB0 write_partition --partition-name samples --input bank.bin
+"""
+
+import argparse
+import os
+import struct
+import sys
+import wave
+
+MAGIC = b"CSB1"
+MAX_SAMPLES = 16
+ENTRY = struct.Struct("<16s5I")  # name, offset, frames, loopStart, rootHzQ8, sampleRate
+PARTITION_SIZE = 0x160000
+
+
+def read_wav(path):
+    with wave.open(path, "rb") as wav:
+        if wav.getsampwidth() != 2:
+            sys.exit(f"{path}: only 16-bit PCM is supported")
+        channels = wav.getnchannels()
+        rate = wav.getframerate()
+        raw = wav.readframes(wav.getnframes())
+    samples = struct.unpack(f"<{len(raw) // 2}h", raw)
+    if channels > 1:
+        samples = [sum(samples[i:i + channels]) // channels for i in range(0, len(samples), channels)]
+    return list(samples), rate
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("samples", nargs="+", help="file.wav[:root_hz[:loop_start]]")
+    parser.add_argument("-o", "--output", required=True, help="bank image to write")
+    args = parser.parse_args()
+    if len(args.samples) > MAX_SAMPLES:
+        sys.exit(f"at most {MAX_SAMPLES} samples per bank")
+
+    entries = []
+    data = b""
+    data_start = 8 + ENTRY.size * len(args.samples)
+    for spec in args.samples:
+        path, *options = spec.split(":")
+        root_hz = float(options[0]) if len(options) > 0 else 261.63
+        frames, rate = read_wav(path)
+        loop_start = int(options[1]) if len(options) > 1 else len(frames)
+        if not 0 <= loop_start <= len(frames):
+            sys.exit(f"{path}: loop start {loop_start} is outside 0..{len(frames)}")
+
+        # Guard frame: what interpolation reads after the last frame
+        guard = frames[loop_start] if loop_start < len(frames) else 0
+        name = os.path.splitext(os.path.basename(path))[0][:15].encode()
+        entries.append(ENTRY.pack(name, data_start + len(data), len(frames), loop_start,
+                                  round(root_hz * 256), rate))
+        data += struct.pack(f"<{len(frames) + 1}h", *frames, guard)
+        data += b"\0" * (len(data) % 4)  # Keep every sample 4-byte aligned
+
+    image = MAGIC + struct.pack("<I", len(entries)) + b"".join(entries) + data
+    if len(image) > PARTITION_SIZE:
+        sys.exit(f"bank is {len(image)} bytes, the partition holds {PARTITION_SIZE}")
+    with open(args.output, "wb") as out:
+        out.write(image)
+    print(f"{args.output}: {len(entries)} samples, {len(image)} bytes")
+
+
+if __name__ == "__main__":
+    main()
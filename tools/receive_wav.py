@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+"""
+Fetch the looper's loop as a WAV file over the serial console.
+
+Sends "loop export", waits for the "wav: <bytes> bytes in <n> chunks" line
+and reassembles the framed chunks that follow (see Looper::exportWav). Each
+frame is checked: magic, chunk index in sequence, length and CRC-32. Log
+lines other tasks print during the transfer arrive between frames; they are
+shown on stderr and kept out of the file.
+
+    tools/receive_wav.py /dev/ttyUSB0 loop.wav
+
+Needs pyserial (pip install pyserial).
+"""
+
+import argparse
+import re
+import struct
+import sys
+import time
+import zlib
+
+import serial
+
+MAGIC = b"\xa5\x5aWV"
+HEADER = struct.Struct("<HH")  # Chunk index, payload length
+CHUNK_BYTES = 512              # Looper::EXPORT_CHUNK_BYTES
+
+
+class Frames:
+    """Split a byte stream into export frames and the text between them."""
+
+    def __init__(self):
+        self.pending = bytearray()
+        self.text = bytearray()
+
+    def feed(self, data):
+        """Add received bytes; yield (index, payload) for each complete frame."""
+        self.pending += data
+        while True:
+            start = self.pending.find(MAGIC)
+            if start < 0:
+                # Keep a possible partial magic at the end for the next read
+                cut = max(0, len(self.pending) - (len(MAGIC) - 1))
+                self.text += self.pending[:cut]
+                del self.pending[:cut]
+                return
+            self.text += self.pending[:start]
+            del self.pending[:start]
+
+            if len(self.pending) < len(MAGIC) + HEADER.size:
+                return
+            index, length = HEADER.unpack_from(self.pending, len(MAGIC))
+            if length > CHUNK_BYTES:
+                raise ValueError(f"chunk {index}: bad length {length}")
+            end = len(MAGIC) + HEADER.size + length + 4
+            if len(self.pending) < end:
+                return
+            body = bytes(self.pending[len(MAGIC):end - 4])
+            (crc,) = struct.unpack_from("<I", self.pending, end - 4)
+            if zlib.crc32(body) != crc:
+                raise ValueError(f"chunk {index}: checksum mismatch")
+            del self.pending[:end]
+            yield index, body[HEADER.size:]
+
+    def take_lines(self):
+        """Complete text lines received so far (log output from the synth)."""
+        *lines, rest = self.text.split(b"\n")
+        self.text = bytearray(rest)
+        return [line.decode(errors="replace").strip() for line in lines]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("port", help="serial port of the synth")
+    parser.add_argument("output", help="WAV file to write")
+    parser.add_argument("--baud", type=int, default=115200)
+    args = parser.parse_args()
+
+    with serial.Serial(args.port, args.baud, timeout=5) as port:
+        port.reset_input_buffer()
+        port.write(b"loop export\n")
+
+        size = chunks = None
+        deadline = time.time() + 5
+        while size is None and time.time() < deadline:
+            line = port.readline().decode(errors="replace").strip()
+            if line.startswith("error:") or line.startswith("loop:"):
+                sys.exit(line)
+            match = re.fullmatch(r"wav: (\d+) bytes in (\d+) chunks", line)
+            if match:
+                size, chunks = int(match.group(1)), int(match.group(2))
+        if size is None:
+            sys.exit("no reply to 'loop export'")
+
+        frames = Frames()
+        data = bytearray()
+        received = 0
+        started = time.time()
+        while received < chunks:
+            chunk = port.read(port.in_waiting or 1)  # Whatever has arrived, without waiting for more
+            if not chunk:
+                sys.exit(f"transfer stalled after {len(data)} of {size} bytes")
+            try:
+                for index, payload in frames.feed(chunk):
+                    if index != received % 65536:
+                        sys.exit(f"chunk {received} missing (got {index})")
+                    data += payload
+                    received += 1
+            except ValueError as error:
+                sys.exit(f"transfer corrupted: {error}")
+            for line in frames.take_lines():
+                if line:
+                    print(f"\rsynth: {line}", file=sys.stderr)
+            print(f"\r{len(data) * 100 // size}%", end="", file=sys.stderr)
+        print(f"\r{size} bytes in {time.time() - started:.1f} s", file=sys.stderr)
+
+    if len(data) != size:
+        sys.exit(f"received {len(data)} of {size} bytes")
+    if data[:4] != b"RIFF" or data[8:12] != b"WAVE":
+        sys.exit("reply is not a WAV file")
+    with open(args.output, "wb") as out:
+        out.write(data)
+
+
+if __name__ == "__main__":
+    main()